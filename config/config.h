@@ -66,12 +66,14 @@
 
 #define ENABLE_DISPLAY true          // true: pantalla activa, false: apagada para máximo ahorro
 #define SHOW_ACTIVITY_INDICATORS true // true: mostrar indicadores permanentes, false: solo mensajes
+#define DISPLAY_ON_TIMER_WAKE false   // false: no tocar la pantalla al despertar por temporizador (solo errores)
 
 // Duraciones de mensajes (ms)
 #define MESSAGE_DURATION_SUCCESS 5000
 #define MESSAGE_DURATION_ERROR 3000
 #define MESSAGE_DURATION_WARNING 4000
 #define MESSAGE_DURATION_INFO 3000
+#define MESSAGE_DURATION_SPLASH 2000  // Pantalla de inicio antes del primer mensaje
 #define MESSAGE_DURATION_SLEEP 3000
 
 // =============================================================================
@@ -91,16 +93,106 @@
 // Las claves LoRaWAN se definen en lorawan_config.h para mantenerlas separadas
 // de la configuración general (por seguridad y organización)
 
+// =============================================================================
+// SESIÓN LoRaWAN PERSISTENTE (VER lorawan_session.h)
+// =============================================================================
+// La sesión OTAA se reutiliza entre despertares y arranques en frío en lugar
+// de hacer un join en cada despertar. Los contadores se guardan en NVS solo
+// cada SESSION_FCNT_COMMIT_INTERVAL tramas; tras un corte saltan ese margen.
+
+#define ENABLE_SESSION_PERSISTENCE true      // true: reutilizar la sesión; false: join en cada despertar
+#define SESSION_NVS_NAMESPACE "lorawan"      // Espacio de nombres en NVS
+#define SESSION_FCNT_COMMIT_INTERVAL 100     // Tramas por escritura en NVS (muy por debajo del salto máximo de 16384)
+#define SESSION_NONCE_COMMIT_INTERVAL 8      // Intentos de join por escritura en NVS
+#define NVS_ERASE_CYCLES 100000UL            // Ciclos de borrado por sector que garantiza la flash
+
 // =============================================================================
 // CONFIGURACIÓN DE TIMING Y ENERGÍA
 // =============================================================================
 
 #define SEND_INTERVAL_SECONDS 300    // Intervalo entre envíos (mínimo 60s para evitar sobrecarga)
 #define WATCHDOG_TIMEOUT_MINUTES 5   // Timeout del watchdog en minutos
+#define ENABLE_WARM_BOOT true        // true: al despertar por temporizador tras un ciclo sano, omitir diagnósticos y esperas de estabilización
+#define BOOT_PHASE_REPORT true       // true: imprimir los tiempos por fase del arranque al poner en cola el primer envío
+#define ENABLE_PARALLEL_INIT true    // true: inicializar radio, pantalla y sensores en paralelo (ver init_graph.h)
+#define ENABLE_DUAL_CORE false       // true: LMIC en su propia tarea en LMIC_CORE; sensores, pantalla y log en loop() (núcleo 1)
+#define LMIC_CORE 0                  // Núcleo de LMIC (tarea con ENABLE_DUAL_CORE y nodo de radio del arranque)
+#define LMIC_TASK_PRIORITY 3         // Prioridad de la tarea de LMIC (loop() tiene 1)
+#define LMIC_TASK_STACK_SIZE 4096    // Pila de la tarea de LMIC (bytes)
 
 // Energía y batería
 #define ENABLE_SOLAR_CHARGING true   // Habilitar carga solar
 #define BATTERY_LOW_THRESHOLD 20     // Umbral de batería baja (%)
+#define BATTERY_ADC_SAMPLES 16       // Muestras ADC por medida (se descarta 1/4 por cada extremo)
+#define BATTERY_CACHE_MS 60000       // Validez de la medida cacheada dentro de un despertar (ms)
+#define BATTERY_CAPACITY_MAH 3000    // Capacidad nominal de la batería (mAh)
+#define BATTERY_INTERNAL_RESISTANCE_MOHM 150 // Resistencia interna de la celda (mΩ) para compensar la carga
+#define BATTERY_AWAKE_CURRENT_MA 45  // Consumo típico con el ESP32 despierto si el PMU no mide corriente
+#define ENABLE_COULOMB_COUNTING true // Contador de culombios del AXP192 (su ADC de corriente sigue activo al dormir)
+
+// Intervalo adaptativo según presupuesto energético (ver send_scheduler.cpp)
+#define ENABLE_ADAPTIVE_INTERVAL true      // false: usar siempre SEND_INTERVAL_SECONDS
+#define SEND_INTERVAL_MIN_SECONDS 120      // Intervalo mínimo (con cosecha solar)
+#define SEND_INTERVAL_MAX_SECONDS 3600     // Intervalo máximo (batería casi agotada)
+#define BATTERY_TARGET_AUTONOMY_DAYS 30    // Autonomía que debe garantizar la carga restante
+#define BATTERY_RESERVE_PERCENT 5          // Reserva que no se cuenta como energía útil (%)
+#define SLEEP_CURRENT_UA 150               // Consumo de la placa en sueño profundo (µA)
+
+// =============================================================================
+// GNSS (SOLO PLACAS CON HAS_GPS Y HAS_PMU, VER gnss_power.h)
+// =============================================================================
+// Con el seguimiento activo el receptor se enciende en cada despertar hasta
+// obtener una posición o agotar el presupuesto, y se apaga manteniendo su
+// alimentación de respaldo (VBACKUP) para que el siguiente arranque sea en
+// caliente (~1-5 s en lugar de 30 s o más).
+
+#define ENABLE_GNSS_TRACKING false        // true: buscar posición en cada despertar
+#define GNSS_KEEP_BACKUP_POWER true       // true: VBACKUP encendido en sueño profundo (~100 µA, evita arranques en frío)
+#define GNSS_HOT_START_MAX_AGE_S 14400    // Antigüedad máxima de la última posición para esperar arranque en caliente (efemérides ~4 h)
+#define GNSS_HOT_FIX_BUDGET_MS 10000      // Tiempo máximo de búsqueda en caliente (ms)
+#define GNSS_WARM_FIX_BUDGET_MS 45000     // Tiempo máximo de búsqueda en templado (ms)
+#define GNSS_COLD_FIX_BUDGET_MS 120000    // Tiempo máximo de búsqueda en frío (ms)
+#define GNSS_FINISH_SLICE_MS 2000        // Espera máxima antes de dormir; el resto del presupuesto sigue en el siguiente despertar (ms)
+#define GNSS_MAX_HDOP_X10 50              // HDOP máximo (x10) para aceptar una posición GGA
+
+// =============================================================================
+// REGISTRO EN TARJETA SD (SOLO PLACAS CON HAS_SDCARD, VER sd_logger.h)
+// =============================================================================
+// Cada lectura se anexa como registro binario de 32 bytes a un buffer en
+// memoria RTC; solo se escriben bloques completos de 512 bytes al dormir.
+
+#define ENABLE_SD_LOGGER false               // true: guardar cada lectura en la SD
+#define SD_LOG_DIR "/log"                    // Directorio de los archivos de registro y del índice
+#define SD_LOG_MAX_FILE_BYTES (1024UL * 1024UL) // Tamaño de rotación (múltiplo de 512)
+#define SD_LOG_BUFFER_BYTES 1024             // Buffer en memoria RTC (al menos un bloque y un registro)
+#define SD_LOG_FLUSH_THRESHOLD_BYTES 512     // Bytes pendientes a partir de los que se escribe
+
+// =============================================================================
+// COLA DE ENVÍOS EN FLASH (VER store_forward.h)
+// =============================================================================
+// Si el join falla o el enlace se pierde, las lecturas se guardan en la
+// partición STORE_FORWARD_PARTITION (partitions.csv) y se reenvían en lotes
+// por STORE_FORWARD_FPORT tras el siguiente envío normal.
+
+#define ENABLE_STORE_FORWARD true            // true: guardar y reenviar lecturas no enviadas
+#define STORE_FORWARD_PARTITION "upqueue"    // Nombre de la partición de la cola
+#define STORE_FORWARD_PARTITION_SUBTYPE 0x40 // Subtipo de datos de la partición
+#define STORE_FORWARD_FPORT 2                // Puerto de los lotes (el envío normal usa el 1)
+#define STORE_FORWARD_BATCH_BYTES 51         // Tamaño máximo del lote (cabe a SF12 en EU868)
+#define STORE_FORWARD_MAX_BATCHES 3          // Lotes como máximo por despertar
+#define STORE_FORWARD_MAX_WAIT_S 20          // Espera máxima por ciclo de trabajo; si es mayor, el resto queda para el siguiente despertar
+#define STORE_FORWARD_CONFIRMED false        // true: lotes confirmados, solo salen de la cola con ACK (LMIC reintenta hasta 8 veces)
+
+// =============================================================================
+// ESTADÍSTICAS POR VENTANA (SUBMUESTREO ENTRE ENVÍOS)
+// =============================================================================
+// Con esta opción el nodo despierta cada STATS_SAMPLE_INTERVAL_SECONDS para
+// tomar una muestra (sin usar la radio) y acumula min/max/media/desviación
+// en memoria RTC. Cada SEND_INTERVAL_SECONDS se envía el resumen de la ventana.
+// ¡OJO! Cambia el formato del payload: regenera el decoder TTN al activarlo.
+
+#define ENABLE_WINDOWED_STATS false       // true: enviar resumen estadístico por ventana
+#define STATS_SAMPLE_INTERVAL_SECONDS 30  // Intervalo entre muestras dentro de la ventana
 
 // =============================================================================
 // CONFIGURACIÓN DE DEPURACIÓN Y LOGGING
@@ -109,6 +201,7 @@
 #define ENABLE_SERIAL_LOGS true      // Habilitar logs por Serial
 #define LOG_LEVEL 1                  // 0: ninguno, 1: básico, 2: detallado
 #define SHOW_TTN_DECODER true  // true: mostrar decoder TTN por Serial al iniciar
+#define DISPLAY_CAPTURE false  // true: medir µs y bytes I2C de cada fotograma y volcarlo como PBM por Serial (~0,7 s por volcado)
 
 // =============================================================================
 // CONFIGURACIÓN DE PAYLOAD Y DATOS
@@ -176,6 +269,10 @@
     2 /* batería */ \
 )
 
+// Payload de resumen estadístico: nº de muestras (1 byte), min/max/media/desviación
+// (4 x 2 bytes) por cada campo de sensor y batería mínima de la ventana (2 bytes)
+#define STATS_PAYLOAD_SIZE_BYTES (1 + 4 * (PAYLOAD_SIZE_BYTES - 2) + 2)
+
 // Valores de error para lecturas fallidas
 #define SENSOR_ERROR_TEMPERATURE -999.0f
 #define SENSOR_ERROR_HUMIDITY -1.0f
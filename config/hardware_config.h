@@ -195,6 +195,30 @@
 
 #define UNUSED_PIN (0)
 
+// Reloj I2C de la pantalla OLED (Hz). El SSD1306 suele admitir de 400 kHz a
+// 1 MHz; el bus vuelve a la velocidad del PMU y los sensores tras cada envío.
+// Si aparecen fallos de imagen, bajar a 400000.
+#ifndef DISPLAY_I2C_CLOCK_HZ
+#define DISPLAY_I2C_CLOCK_HZ 800000
+#endif
+
+// Buffer de la pantalla: 0 = completo (1 KB en RAM permanente, envío solo de
+// los tiles modificados), 1 o 2 = páginas de 128 o 256 bytes (cada fotograma
+// se dibuja por franjas y se envía entero). Todas las placas usan la misma
+// SSD1306 128x64, así que basta con cambiar la variante _F por _1 o _2.
+#ifndef DISPLAY_PAGE_BUFFER
+#define DISPLAY_PAGE_BUFFER 0
+#endif
+
+#if defined(DISPLAY_MODEL) && DISPLAY_PAGE_BUFFER
+#undef DISPLAY_MODEL
+#if DISPLAY_PAGE_BUFFER == 1
+#define DISPLAY_MODEL U8G2_SSD1306_128X64_NONAME_1_HW_I2C
+#else
+#define DISPLAY_MODEL U8G2_SSD1306_128X64_NONAME_2_HW_I2C
+#endif
+#endif
+
 // Tipos de radio soportados
 #if defined(USING_SX1262)
 #define RADIO_TYPE_STR "SX1262"
@@ -98,8 +98,19 @@ void scanDevices(TwoWire *w);
 
 bool beginGPS();
 
+bool beginCachedGPS();
+
 bool recoveryGPS();
 
+#ifdef HAS_GPS
+#include "gnss_parser.h"
+bool detectGPS();
+bool gpsDetected();
+void loopGPS();
+void setGPSFixCallback(gnss_fix_cb cb, void *ctx);
+void standbyGPS();
+#endif
+
 void scanWiFi();
 
 #ifdef HAS_PMU
@@ -154,7 +165,8 @@ float readBatteryVoltage();
 
 /**
  * @brief Obtiene el porcentaje de batería estimado a partir del voltaje.
- *        3.0V = 0%, 4.2V = 100% (batería 18650 Li-Ion).
+ *        Interpola la curva OCV de una celda 18650 Li-Ion con compensación de carga.
+ *        Para la estimación con conteo de culombios usar battery_soc_estimate().
  *
  * @param voltage Voltaje de batería en voltios.
  * @return Porcentaje estimado (0-100).
@@ -0,0 +1,59 @@
+/**
+ * @file      battery_adc.h
+ * @brief     Medición de batería con ADC calibrado y valor cacheado por despertar
+ *
+ * La fuente de medida (PMU AXP192/AXP2101 o ADC con divisor resistivo) se
+ * elige una sola vez por arranque. En el ADC se usa la calibración de fábrica
+ * guardada en eFuse, sobremuestreo y descarte de valores atípicos.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef BATTERY_ADC_H
+#define BATTERY_ADC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Fuente usada para medir la batería
+ */
+typedef enum {
+    BATTERY_SOURCE_UNKNOWN = 0,  /**< Aún no seleccionada */
+    BATTERY_SOURCE_PMU,          /**< Medida interna del PMU */
+    BATTERY_SOURCE_ADC,          /**< ADC del ESP32 con divisor resistivo */
+    BATTERY_SOURCE_NONE          /**< Sin medida disponible */
+} battery_source_t;
+
+/**
+ * @brief Selecciona la fuente de medida y caracteriza el ADC
+ *
+ * Se llama automáticamente en la primera lectura; llamarla explícitamente
+ * tras beginPower() evita ese coste en el camino de envío.
+ */
+void battery_adc_begin(void);
+
+/**
+ * @brief Devuelve el voltaje de batería en voltios
+ *
+ * Dentro de un mismo despertar devuelve el valor cacheado mientras no
+ * supere BATTERY_CACHE_MS de antigüedad. Una lectura fuera de rango no
+ * se cachea.
+ *
+ * @return Voltaje en V, 0.0 si no hay medida válida
+ */
+float battery_read_voltage(void);
+
+/**
+ * @brief Fuerza una nueva medida en la próxima lectura
+ */
+void battery_invalidate_cache(void);
+
+/**
+ * @brief Fuente seleccionada para este arranque
+ */
+battery_source_t battery_get_source(void);
+
+#endif // BATTERY_ADC_H
@@ -0,0 +1,71 @@
+/**
+ * @file      battery_soc.h
+ * @brief     Estimación del estado de carga (SoC) de la batería Li-Ion
+ *
+ * Sustituye el mapeo lineal 3.0-4.2 V por:
+ * - Tabla de tensión en circuito abierto (OCV) de una celda 18650 típica.
+ * - Compensación de la caída en la resistencia interna según la corriente.
+ * - Conteo de culombios del AXP192 (si está disponible), con el estado
+ *   guardado en memoria RTC y corregido lentamente hacia la OCV.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef BATTERY_SOC_H
+#define BATTERY_SOC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Valor de battery_soc_estimate() cuando no hay ninguna medida de batería
+ */
+#define BATTERY_SOC_UNKNOWN 0xFF
+
+/**
+ * @brief Porcentaje de carga a partir de la tensión en circuito abierto
+ *
+ * @param ocv_voltage Tensión de la celda en reposo (V)
+ * @return Porcentaje estimado (0-100)
+ */
+uint8_t battery_soc_from_ocv(float ocv_voltage);
+
+/**
+ * @brief Corrige la tensión medida en bornes a tensión en circuito abierto
+ *
+ * @param terminal_voltage Tensión medida (V)
+ * @param current_ma Corriente de la batería en mA (positiva descargando, negativa cargando)
+ * @return Tensión OCV estimada (V)
+ */
+float battery_soc_compensate(float terminal_voltage, float current_ma);
+
+/**
+ * @brief Porcentaje de carga a partir de una tensión medida con el equipo despierto
+ *
+ * Compensa la caída con BATTERY_AWAKE_CURRENT_MA antes de consultar la tabla OCV.
+ *
+ * @param voltage Tensión medida en bornes (V)
+ * @return Porcentaje estimado (0-100)
+ */
+uint8_t battery_soc_from_voltage(float voltage);
+
+/**
+ * @brief Estima el estado de carga actual de la batería
+ *
+ * Usa el conteo de culombios del PMU si existe y la tabla OCV con
+ * compensación de carga en caso contrario. El resultado se guarda en
+ * memoria RTC para el siguiente despertar.
+ *
+ * @return Porcentaje estimado (0-100), o BATTERY_SOC_UNKNOWN si la tensión
+ *         no se puede leer y no hay una estimación anterior
+ */
+uint8_t battery_soc_estimate(void);
+
+/**
+ * @brief Indica si la estimación actual se apoya en el conteo de culombios
+ */
+bool battery_soc_uses_coulomb_counter(void);
+
+#endif // BATTERY_SOC_H
@@ -0,0 +1,118 @@
+/**
+ * @file      boot_mode.h
+ * @brief     Política de arranque según la causa del despertar
+ *
+ * Tras un despertar por temporizador nadie está mirando la pantalla, así que
+ * el arranque es "sin pantalla": no se inicializa el OLED, no hay pantalla de
+ * bienvenida ni esperas asociadas. Solo un error enciende el panel bajo
+ * demanda (ver screen.cpp). El encendido, el reset y el botón mantienen el
+ * arranque interactivo de siempre.
+ *
+ * Independientemente de la pantalla, un despertar por temporizador cuyo
+ * ciclo anterior terminó bien (llegó al sueño profundo) es un arranque "en
+ * caliente": la alimentación ya es estable y el hardware es el mismo, así que
+ * se omiten los diagnósticos (getChipInfo, decoder TTN), el reset del OLED,
+ * el parpadeo del LED y la espera de estabilización de setup().
+ *
+ * También mide el tiempo desde el arranque hasta la puesta en cola del
+ * primer envío y lo guarda por modo en memoria RTC para comparar ambos,
+ * junto con la marca de tiempo de cada fase del arranque.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef BOOT_MODE_H
+#define BOOT_MODE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Modos de arranque
+ */
+typedef enum {
+    BOOT_MODE_INTERACTIVE = 0,  /**< Encendido, reset o botón: pantalla disponible */
+    BOOT_MODE_HEADLESS,         /**< Despertar por temporizador: pantalla intacta */
+    BOOT_MODE_COUNT
+} boot_mode_t;
+
+/**
+ * @brief Fases del arranque con marca de tiempo
+ */
+typedef enum {
+    BOOT_PHASE_SETUP = 0,   /**< Entrada en setup() */
+    BOOT_PHASE_BOARDS,      /**< setupBoards() terminado */
+    BOOT_PHASE_LMIC,        /**< Radio, pantalla y sensores inicializados (init_graph) */
+    BOOT_PHASE_READY,       /**< Fin de setup() */
+    BOOT_PHASE_TX,          /**< Primer envío en cola */
+    BOOT_PHASE_COUNT
+} boot_phase_t;
+
+/**
+ * @brief Modo de este arranque
+ *
+ * Se decide una sola vez con esp_sleep_get_wakeup_cause(). Con
+ * DISPLAY_ON_TIMER_WAKE activado siempre es BOOT_MODE_INTERACTIVE.
+ */
+boot_mode_t boot_mode_get(void);
+
+/**
+ * @brief true si este arranque no debe tocar la pantalla salvo por errores
+ */
+bool boot_mode_headless(void);
+
+/**
+ * @brief true si este arranque es en frío (encendido o reset)
+ *
+ * La memoria RTC no contiene datos válidos: los módulos que guardan estado
+ * en ella deben descartarlo (además de comprobar su propia firma).
+ */
+bool boot_mode_cold(void);
+
+/**
+ * @brief true si este arranque es en caliente (ver ENABLE_WARM_BOOT)
+ *
+ * Despertar por temporizador y ciclo anterior marcado como sano con
+ * boot_mode_mark_healthy().
+ */
+bool boot_mode_warm(void);
+
+/**
+ * @brief Marca el ciclo actual como sano; llamar justo antes del sueño profundo
+ */
+void boot_mode_mark_healthy(void);
+
+/**
+ * @brief Guarda en memoria RTC el instante (µs desde el arranque) de una fase
+ *
+ * BOOT_PHASE_SETUP borra las fases del arranque anterior.
+ */
+void boot_mode_phase(boot_phase_t phase);
+
+/**
+ * @brief Imprime por Serial las fases registradas en este arranque
+ */
+void boot_mode_dump_phases(void);
+
+/**
+ * @brief Registra que el primer envío de este arranque se ha puesto en cola
+ *
+ * Solo mide: se puede llamar desde la tarea de LMIC. Solo cuenta la
+ * primera llamada de cada arranque.
+ *
+ * @return true en la primera llamada (hay que llamar a boot_mode_report_tx())
+ */
+bool boot_mode_mark_tx(void);
+
+/**
+ * @brief Imprime el tiempo arranque->TX marcado con boot_mode_mark_tx()
+ *
+ * Incluye el último valor medido en el otro modo, y las fases si
+ * BOOT_PHASE_REPORT está activado. Desde el contexto de loop() (p. ej. con
+ * deferred_call()).
+ */
+void boot_mode_report_tx(void);
+
+#endif // BOOT_MODE_H
@@ -0,0 +1,79 @@
+/**
+ * @file      deferred_output.h
+ * @brief     Cola de salida diferida (log y pantalla) mientras la radio está ocupada
+ *
+ * LMIC sin interrupciones detecta el fin de la transmisión al sondear DIO0
+ * desde os_runloop_once(); el instante del fin de TX fija la apertura de RX1
+ * y RX2. Cualquier bloqueo mientras la radio transmite o escucha (volcado I2C
+ * de la pantalla, Serial con el buffer lleno) retrasa ese sondeo y desplaza
+ * las ventanas de recepción.
+ *
+ * Mientras LMIC.opmode tenga OP_TXRXPEND, los mensajes no críticos se
+ * guardan en una cola fija y se emiten al terminar la transacción. Con la
+ * radio libre se emiten directamente. Los errores deben seguir escribiéndose
+ * directamente.
+ *
+ * Con ENABLE_DUAL_CORE la cola es el canal entre núcleos: la tarea de LMIC
+ * es el único productor (todo se encola) y loop() el único consumidor, que
+ * lo emite en su núcleo sin esperar a que la radio quede libre.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef DEFERRED_OUTPUT_H
+#define DEFERRED_OUTPUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "screen.h"
+
+/**
+ * @brief true mientras hay una transacción TX/RX de LMIC en curso
+ */
+bool deferred_radio_busy(void);
+
+/**
+ * @brief Escribe una línea de log por Serial o la encola si la radio está ocupada
+ *
+ * Las líneas más largas que el hueco de la cola se truncan.
+ */
+void deferred_log(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief showMessage() diferido
+ */
+void deferred_show(ScreenMessageType type, const char* text, uint32_t duration);
+
+/**
+ * @brief showStatus() diferido
+ */
+void deferred_status(StatusMessage id, uint32_t duration);
+
+/**
+ * @brief Ejecuta una función en el contexto que emite la salida
+ *
+ * Se ejecuta en orden con el resto de la cola; con ENABLE_DUAL_CORE, en
+ * el núcleo de loop(). Para lo que toca la pantalla o el sensor desde LMIC.
+ * A diferencia del log y la pantalla, nunca se descarta con la cola llena.
+ */
+void deferred_call(void (*fn)(void));
+
+/**
+ * @brief Emite en orden lo encolado si la radio está libre
+ *
+ * Llamar en cada iteración del bucle tras os_runloop_once() y antes de dormir.
+ * Con ENABLE_DUAL_CORE solo debe llamarla loop().
+ */
+void deferred_drain(void);
+
+/**
+ * @brief Espera a que se haya emitido todo lo encolado
+ *
+ * Desde el productor: con un solo núcleo equivale a deferred_drain(); con
+ * ENABLE_DUAL_CORE espera (como mucho 1 s) a que loop() vacíe la cola.
+ */
+void deferred_flush(void);
+
+#endif // DEFERRED_OUTPUT_H
@@ -0,0 +1,100 @@
+/**
+ * @file      gnss_parser.h
+ * @brief     Analizador incremental de NMEA y UBX sin memoria dinámica
+ *
+ * Recibe los bytes del receptor GNSS de uno en uno (o en bloques leídos del
+ * buffer de la UART) y valida la suma de comprobación de cada sentencia o
+ * trama sobre la marcha. Entrega por callback:
+ * - cada sentencia NMEA válida (sin '$' ni "*hh"),
+ * - cada trama UBX válida (clase, id y payload),
+ * - la posición de cada RMC o GGA, ya convertida a enteros.
+ *
+ * Todo el estado vive en gnss_parser_t; las sentencias y tramas se pasan
+ * como punteros a su buffer interno, válidos solo durante el callback.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef GNSS_PARSER_H
+#define GNSS_PARSER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Longitud máxima de una sentencia NMEA entre '$' y '*' (NMEA 0183: 79)
+#define GNSS_NMEA_MAX_LEN 88
+
+// Payload UBX máximo (NAV-PVT ocupa 92 bytes); una trama que anuncia más se
+// descarta al leer su longitud y cuenta en overflows
+#define GNSS_UBX_MAX_PAYLOAD 128
+
+/**
+ * @brief Posición de una sentencia RMC o GGA
+ */
+typedef struct {
+    char type;             /**< 'R' (RMC) o 'G' (GGA) */
+    bool valid;            /**< RMC con estado A o GGA con calidad > 0 */
+    int32_t lat_e7;        /**< Latitud (grados * 1e7, sur negativo) */
+    int32_t lon_e7;        /**< Longitud (grados * 1e7, oeste negativo) */
+    uint32_t time_ms;      /**< Hora UTC del día (ms) */
+    uint32_t date;         /**< Fecha ddmmaa (solo RMC, 0 si no hay) */
+    int32_t alt_dm;        /**< Altitud sobre el nivel del mar (dm, solo GGA) */
+    uint8_t satellites;    /**< Satélites en uso (solo GGA) */
+    uint16_t hdop_x10;     /**< HDOP * 10 (solo GGA) */
+} gnss_fix_t;
+
+typedef void (*gnss_sentence_cb)(const char* sentence, void* ctx);
+typedef void (*gnss_ubx_cb)(uint8_t cls, uint8_t id, const uint8_t* payload, uint16_t len, void* ctx);
+typedef void (*gnss_fix_cb)(const gnss_fix_t* fix, void* ctx);
+
+/**
+ * @brief Estado del analizador (no acceder a los campos directamente)
+ */
+typedef struct {
+    uint8_t state;
+    uint8_t checksum;          // XOR de NMEA o CK_A de UBX
+    uint8_t checksum_b;        // CK_B de UBX
+    uint8_t ubx_class;
+    uint8_t ubx_id;
+    uint16_t len;              // Bytes de la sentencia o del payload recibidos
+    uint16_t ubx_len;          // Longitud anunciada del payload UBX
+    char nmea[GNSS_NMEA_MAX_LEN + 1];
+    uint8_t ubx[GNSS_UBX_MAX_PAYLOAD];
+
+    gnss_sentence_cb on_sentence;
+    gnss_ubx_cb on_ubx;
+    gnss_fix_cb on_fix;
+    void* ctx;
+
+    // Estadísticas
+    uint32_t sentences;        // Sentencias NMEA válidas
+    uint32_t frames;           // Tramas UBX válidas
+    uint32_t checksum_errors;
+    uint32_t overflows;        // Sentencias o payloads más largos que el buffer
+} gnss_parser_t;
+
+/**
+ * @brief Prepara el analizador; cualquier callback puede ser NULL
+ */
+void gnss_parser_init(gnss_parser_t* p, gnss_sentence_cb on_sentence, gnss_ubx_cb on_ubx,
+                      gnss_fix_cb on_fix, void* ctx);
+
+/**
+ * @brief Descarta la sentencia o trama a medias (p. ej. tras cambiar de baudios)
+ */
+void gnss_parser_reset(gnss_parser_t* p);
+
+/**
+ * @brief Procesa un byte; los callbacks se llaman desde aquí
+ */
+void gnss_parser_feed(gnss_parser_t* p, uint8_t c);
+
+/**
+ * @brief Procesa un bloque de bytes
+ */
+void gnss_parser_feed_buf(gnss_parser_t* p, const uint8_t* data, size_t len);
+
+#endif // GNSS_PARSER_H
@@ -0,0 +1,70 @@
+/**
+ * @file      gnss_power.h
+ * @brief     Gestión de energía del receptor GNSS con arranque en caliente
+ *
+ * Un arranque en frío del GNSS (sin efemérides ni hora) tarda 30 s o más
+ * consumiendo decenas de mA. Si el receptor conserva su alimentación de
+ * respaldo (VBACKUP en el AXP2101, pila de respaldo en el T-Beam con AXP192)
+ * mantiene RTC, almanaque y efemérides con el raíl principal apagado (modo
+ * "backup" de u-blox y L76K), y la siguiente posición es un arranque en
+ * caliente de pocos segundos.
+ *
+ * En cada despertar:
+ * - gnss_power_begin() enciende el raíl principal y estima el tipo de
+ *   arranque según la antigüedad de la última posición.
+ * - gnss_power_loop() procesa la UART sin bloquear y apaga el raíl en cuanto
+ *   hay una posición o se agota el presupuesto de ese tipo de arranque.
+ * - gnss_power_finish() antes de dormir espera como mucho
+ *   GNSS_FINISH_SLICE_MS; si la búsqueda sigue abierta, el siguiente
+ *   despertar la continúa con el presupuesto que queda.
+ *
+ * Antes de cortar el raíl se pide al receptor que pase a reposo
+ * (standbyGPS()). En memoria RTC solo se guarda la hora de la última
+ * posición y el estado de la búsqueda: la posición no se envía.
+ *
+ * Solo actúa con ENABLE_GNSS_TRACKING en placas con HAS_GPS y HAS_PMU.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef GNSS_POWER_H
+#define GNSS_POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Enciende el receptor y empieza (o continúa) la búsqueda de este despertar
+ *
+ * Debe llamarse tras setupBoards(), fuera de los nodos del arranque en
+ * paralelo (usa el I2C del PMU).
+ */
+void gnss_power_begin(void);
+
+/**
+ * @brief Procesa la UART del GNSS; apaga el raíl al terminar la búsqueda
+ *
+ * Llamar desde loop(), en el mismo hilo que el resto de usuarios del I2C.
+ */
+void gnss_power_loop(void);
+
+/**
+ * @brief Espera como mucho GNSS_FINISH_SLICE_MS al final de la búsqueda y apaga el raíl
+ *
+ * Llamar antes de entrar en sueño profundo. Si no hay posición ni se ha
+ * agotado el presupuesto, la búsqueda queda aplazada al siguiente
+ * despertar. VBACKUP no se toca.
+ */
+void gnss_power_finish(void);
+
+/**
+ * @brief true si VBACKUP sigue encendido en sueño profundo (GNSS_KEEP_BACKUP_POWER)
+ *
+ * Ningún perfil de pmu_profile lo apaga: el valor solo decide si el
+ * siguiente despertar puede esperar un arranque templado o en caliente.
+ */
+bool gnss_power_keep_backup(void);
+
+#endif // GNSS_POWER_H
@@ -0,0 +1,70 @@
+/**
+ * @file      init_graph.h
+ * @brief     Arranque de periféricos como grafo de dependencias
+ *
+ * Cada nodo es una función de inicialización con la lista de nodos de los
+ * que depende, un tiempo máximo y el núcleo en el que se ejecuta. Los nodos
+ * cuyas dependencias ya han terminado corren a la vez como tareas de
+ * FreeRTOS, de modo que el arranque dura lo que su camino crítico y no la
+ * suma de todos los pasos.
+ *
+ * Un nodo que falla o que supera su tiempo máximo se da por fallido y los
+ * que dependen de él (deps) no se ejecutan. Una tarea caducada no se puede
+ * abortar y puede seguir usando su periférico: los nodos ordenados tras
+ * ella (after) esperan a que termine de verdad, e init_graph_run() no
+ * vuelve hasta que han terminado todas.
+ *
+ * Dos nodos sin dependencia entre sí pueden ejecutarse a la vez: si usan el
+ * mismo bus (p. ej. I2C de la pantalla y de un sensor), uno debe ir después
+ * del otro con after, que no exige que el primero termine bien.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef INIT_GRAPH_H
+#define INIT_GRAPH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Máximo de nodos por grafo (un bit por nodo en el grupo de eventos)
+#define INIT_GRAPH_MAX_NODES 8
+
+// Máscara de dependencia sobre el nodo de índice n
+#define INIT_DEP(n) (1u << (n))
+
+/**
+ * @brief Función de un nodo; false si la inicialización falló
+ */
+typedef bool (*init_node_fn)(void);
+
+/**
+ * @brief Nodo del grafo de arranque
+ */
+typedef struct {
+    const char* name;       /**< Nombre para el informe */
+    init_node_fn run;       /**< Inicialización */
+    uint8_t deps;           /**< INIT_DEP() de los nodos que deben terminar bien */
+    uint8_t after;          /**< INIT_DEP() de los nodos que solo deben haber terminado */
+    uint16_t timeout_ms;    /**< Tiempo máximo desde que empieza a ejecutarse */
+    int8_t core;            /**< Núcleo (0 o 1) en el que se ejecuta */
+} init_node_t;
+
+/**
+ * @brief Ejecuta el grafo y espera a que todos los nodos terminen o caduquen
+ *
+ * Los nodos solo pueden depender de nodos con índice menor. Con
+ * ENABLE_PARALLEL_INIT desactivado se ejecutan en orden en la tarea que
+ * llama, sin tiempo máximo. Vuelve cuando todas las tareas han terminado,
+ * también las caducadas. Al final imprime la duración de cada nodo, el
+ * tiempo total y la suma de todos los pasos.
+ *
+ * @param nodes Nodos del grafo
+ * @param count Número de nodos (máximo INIT_GRAPH_MAX_NODES)
+ * @return Máscara INIT_DEP() de los nodos que terminaron bien
+ */
+uint8_t init_graph_run(const init_node_t* nodes, uint8_t count);
+
+#endif // INIT_GRAPH_H
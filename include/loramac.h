@@ -20,13 +20,22 @@
 #pragma once
 
 /**
- * @brief     Inicializa LMIC, sensor BME280 y configura OTAA
+ * @brief     Inicializa LMIC y configura OTAA
  *
- * Configura pines LoRa, claves LoRaWAN, callbacks de eventos y sensor.
- * Debe llamarse una vez en setup().
+ * Configura pines LoRa, claves LoRaWAN y callbacks de eventos, e inicia el
+ * join. Debe llamarse una vez en setup().
  */
 void setupLMIC(void);
 
+/**
+ * @brief     Inicializa los sensores y los enciende por adelantado
+ *
+ * Debe llamarse una vez en setup(), con la pantalla ya inicializada.
+ *
+ * @return    true si al menos un sensor está disponible
+ */
+bool setupSensors(void);
+
 /**
  * @brief     Bucle principal para procesar eventos LoRaWAN
  *
@@ -35,4 +44,21 @@ void setupLMIC(void);
  */
 void loopLMIC(void);
 
+/**
+ * @brief     Arranca la tarea de LMIC en su núcleo
+ *
+ * Con ENABLE_DUAL_CORE, os_runloop_once() y el sondeo de la radio corren
+ * en una tarea fijada a LMIC_CORE y loopLMIC() solo emite lo que esa tarea
+ * encola (log, pantalla, lectura de sensores, sueño). Sin esa opción no
+ * hace nada. Llamar al final de setup(), con el watchdog ya configurado.
+ */
+void startLMICTask(void);
 
+/**
+ * @brief     Toma una muestra para la ventana de estadísticas
+ *
+ * Con ENABLE_WINDOWED_STATS, acumula la lectura en memoria RTC y vuelve a
+ * sueño profundo sin usar la radio mientras la ventana no esté completa.
+ * Sin esa opción no hace nada. Debe llamarse en setup() antes de setupLMIC().
+ */
+void sampleStatsWindow(void);
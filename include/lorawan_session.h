@@ -0,0 +1,82 @@
+/**
+ * @file      lorawan_session.h
+ * @brief     Sesión LoRaWAN persistente con contadores de bajo desgaste
+ *
+ * La sesión OTAA (direcciones y claves de sesión) se conserva entre
+ * despertares en memoria RTC y entre arranques en frío en NVS, de modo que
+ * el nodo no necesita un join por despertar.
+ *
+ * El contador de tramas (LMIC.seqnoUp) y el devNonce no pueden repetirse,
+ * pero escribirlos en NVS en cada envío gasta una escritura en flash por
+ * despertar. En su lugar se reserva un bloque de valores:
+ * - En NVS se guarda el límite del bloque (contador + SESSION_FCNT_COMMIT_INTERVAL).
+ * - La memoria RTC guarda el valor exacto (caché de escritura diferida).
+ * - Solo al alcanzar el límite se escribe el siguiente en NVS.
+ * - Tras un arranque en frío el contador salta al límite guardado: como mucho
+ *   se pierden SESSION_FCNT_COMMIT_INTERVAL valores, nunca se repite uno.
+ *
+ * El contador de bajada (seqnoDn) solo vive en memoria RTC; tras un arranque
+ * en frío vuelve a 0 y se acepta cualquier bajada.
+ *
+ * Solo actúa con ENABLE_SESSION_PERSISTENCE.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef LORAWAN_SESSION_H
+#define LORAWAN_SESSION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Contadores de la persistencia
+ */
+typedef struct {
+    uint32_t nvsWrites;          /**< Escrituras en NVS desde el último arranque en frío */
+    uint32_t writesPerYear;      /**< Escrituras en NVS esperadas al año con SEND_INTERVAL_SECONDS */
+    float eraseCyclesPerYear;    /**< Ciclos de borrado esperados al año por página de NVS */
+    float enduranceYears;        /**< Años hasta NVS_ERASE_CYCLES ciclos por página */
+} lorawan_session_stats_t;
+
+/**
+ * @brief Aplica el devNonce guardado y, si la hay, restaura la sesión
+ *
+ * Llamar justo después de cada LMIC_reset() (que elige un devNonce
+ * aleatorio y descarta la sesión) y antes de configurar los canales.
+ * En un arranque en frío la lee de NVS e informa de la resistencia esperada.
+ *
+ * @return true si hay sesión y no hace falta LMIC_startJoining()
+ */
+bool lorawan_session_resume(void);
+
+/**
+ * @brief Guarda la sesión recién establecida (EV_JOINED)
+ */
+void lorawan_session_save(void);
+
+/**
+ * @brief Copia los contadores de LMIC a memoria RTC y reserva otro bloque si hace falta
+ *
+ * Llamar tras cada os_runloop_once(), en la misma tarea que LMIC, y antes
+ * de dormir. La reserva en NVS espera a que termine la transmisión en
+ * curso (EV_TXCOMPLETE); como LMIC no construye otra trama mientras tanto,
+ * el contador en uso nunca alcanza el límite guardado en NVS.
+ */
+void lorawan_session_update(void);
+
+/**
+ * @brief Descarta la sesión guardada (el siguiente arranque hará join)
+ *
+ * El devNonce reservado se conserva.
+ */
+void lorawan_session_forget(void);
+
+/**
+ * @brief Copia los contadores de la persistencia
+ */
+void lorawan_session_get_stats(lorawan_session_stats_t* out);
+
+#endif // LORAWAN_SESSION_H
@@ -0,0 +1,71 @@
+/**
+ * @file      pmu_profile.h
+ * @brief     Perfiles de alimentación del PMU aplicados como transacción
+ *
+ * Cada perfil declara, para un pequeño conjunto de registros del AXP192 o
+ * AXP2101, qué bits controla y qué valor deben tener. Al aplicarlo se calcula
+ * el valor final de cada registro una sola vez y solo se escriben los que
+ * difieren de la copia cacheada, en lugar de encadenar lecturas-modificación-
+ * escritura bit a bit con disable*Measure() / disablePowerOutput().
+ *
+ * Los raíles que alimentan al ESP32 (DC3 en el AXP192, DCDC1 en el AXP2101)
+ * nunca forman parte de un perfil.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef PMU_PROFILE_H
+#define PMU_PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Perfiles de alimentación disponibles
+ */
+typedef enum {
+    PMU_PROFILE_ACTIVE = 0,   /**< Todo encendido: radio, GNSS, pantalla y medidas del PMU */
+    PMU_PROFILE_SENSING,      /**< Solo lectura de sensores: radio y GNSS apagados */
+    PMU_PROFILE_RADIO_ONLY,   /**< Radio encendida, GNSS apagado, solo medida de batería */
+    PMU_PROFILE_DEEP_SLEEP,   /**< Sueño profundo: periféricos, medidas, LED e IRQ apagados
+                                   (salvo la corriente de batería del AXP192 con ENABLE_COULOMB_COUNTING) */
+    PMU_PROFILE_COUNT
+} pmu_profile_t;
+
+/**
+ * @brief Aplica un perfil escribiendo solo los registros que cambian
+ *
+ * Al salir de PMU_PROFILE_ACTIVE guarda en memoria RTC el estado de los
+ * registros gestionados para que pmu_profile_restore() lo recupere al despertar.
+ *
+ * @param profile Perfil a aplicar
+ * @return Número de registros escritos, -1 si no hay PMU compatible o falla el I2C
+ */
+int pmu_profile_apply(pmu_profile_t profile);
+
+/**
+ * @brief Restaura el estado guardado antes del último sueño profundo
+ *
+ * Debe llamarse tras beginPower() en cada despertar. Si no hay estado
+ * guardado (arranque en frío) aplica PMU_PROFILE_ACTIVE.
+ *
+ * @return Número de registros escritos, -1 si no hay PMU compatible o falla el I2C
+ */
+int pmu_profile_restore(void);
+
+/**
+ * @brief Descarta la copia cacheada de los registros
+ *
+ * Necesario si se modifican registros gestionados directamente a través de
+ * PMU (por ejemplo enablePowerOutput()) entre dos aplicaciones de perfil.
+ */
+void pmu_profile_invalidate(void);
+
+/**
+ * @brief Perfil aplicado por última vez en este arranque
+ */
+pmu_profile_t pmu_profile_current(void);
+
+#endif // PMU_PROFILE_H
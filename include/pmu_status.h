@@ -0,0 +1,41 @@
+/**
+ * @file      pmu_status.h
+ * @brief     Estado del PMU leído una vez por ciclo y compartido entre módulos
+ *
+ * VBUS, carga, tensión y corrientes de batería salen de una sola llamada a
+ * getStatusSnapshot() (dos lecturas en ráfaga en el AXP192 y el AXP2101).
+ * La copia se conserva hasta el siguiente despertar: solar.cpp,
+ * battery_soc.cpp y battery_adc.cpp la consultan en lugar de pedir cada
+ * campo al PMU con una transacción I2C propia.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef PMU_STATUS_H
+#define PMU_STATUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <XPowersLibInterface.hpp>
+
+/**
+ * @brief Estado del PMU de este ciclo
+ *
+ * La primera llamada tras el despertar (o tras pmu_status_invalidate())
+ * lee el PMU; las siguientes devuelven la misma copia.
+ *
+ * @return Estado decodificado, NULL si no hay PMU o falla el I2C
+ */
+const XPowersStatusSnapshot_t* pmu_status(void);
+
+/**
+ * @brief Descarta la copia: la próxima consulta vuelve a leer el PMU
+ *
+ * Un despertar de sueño profundo empieza sin copia; hace falta al volver
+ * de un sueño ligero, que conserva la RAM.
+ */
+void pmu_status_invalidate(void);
+
+#endif // PMU_STATUS_H
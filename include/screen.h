@@ -10,20 +10,26 @@
 #pragma once
 
 #include <Arduino.h>
+#include "screen_types.h"     // Tipos de mensaje y geometría
+#include "status_bitmaps.h"   // Mensajes fijos prerenderizados
 
-// Tipos de mensajes de pantalla
-enum ScreenMessageType {
-    MSG_INFO,           // Información general
-    MSG_WARNING,        // Advertencia
-    MSG_ERROR,          // Error
-    MSG_SUCCESS,        // Éxito
-    MSG_SENSOR_DATA,    // Datos del sensor
-    MSG_STATUS          // Estado del sistema
-};
+/**
+ * @brief Medidas de los fotogramas enviados a la pantalla (DISPLAY_CAPTURE)
+ */
+typedef struct {
+    uint32_t frames;        /**< Fotogramas enviados */
+    uint32_t lastMicros;    /**< Dibujo y envío del último fotograma (µs) */
+    uint32_t lastBytes;     /**< Bytes enviados al backend I2C en el último fotograma */
+    uint32_t totalMicros;   /**< Suma de lastMicros de todos los fotogramas */
+    uint32_t totalBytes;    /**< Suma de lastBytes de todos los fotogramas */
+} ScreenStats;
 
 /**
  * @brief Inicializa la pantalla OLED U8g2
  *
+ * Dibuja la pantalla de inicio y vuelve sin esperar: quien llama la deja
+ * ver MESSAGE_DURATION_SPLASH antes del primer mensaje.
+ *
  * @return true si la inicialización es exitosa, false en caso contrario
  */
 bool initDisplay();
@@ -38,10 +44,24 @@ void updateDisplay();
  * @brief Muestra un mensaje en la pantalla con duración específica
  *
  * @param type Tipo de mensaje
+ * El texto se copia a un buffer fijo (se trunca a 63 caracteres) y se reparte
+ * en líneas según el ancho real de los glifos, sin reservar memoria dinámica.
+ *
  * @param text Texto del mensaje
  * @param duration Duración en milisegundos (0 = mostrar hasta que llegue otro mensaje)
  */
-void showMessage(ScreenMessageType type, const String& text, uint32_t duration = 3000);
+void showMessage(ScreenMessageType type, const char* text, uint32_t duration = 3000);
+
+/**
+ * @brief Muestra un mensaje fijo de status_messages.def
+ *
+ * Copia al buffer la imagen generada al compilar en lugar de rasterizar el
+ * texto; si no está disponible lo dibuja con la fuente.
+ *
+ * @param id Mensaje fijo
+ * @param duration Duración en milisegundos (0 = mostrar hasta que llegue otro mensaje)
+ */
+void showStatus(StatusMessage id, uint32_t duration = 3000);
 
 /**
  * @brief Muestra un mensaje de información
@@ -49,7 +69,7 @@ void showMessage(ScreenMessageType type, const String& text, uint32_t duration =
  * @param text Texto del mensaje
  * @param duration Duración en milisegundos (por defecto 3000ms)
  */
-void showInfo(const String& text, uint32_t duration = 3000);
+void showInfo(const char* text, uint32_t duration = 3000);
 
 /**
  * @brief Muestra un mensaje de advertencia
@@ -57,7 +77,7 @@ void showInfo(const String& text, uint32_t duration = 3000);
  * @param text Texto del mensaje
  * @param duration Duración en milisegundos (por defecto 4000ms)
  */
-void showWarning(const String& text, uint32_t duration = 4000);
+void showWarning(const char* text, uint32_t duration = 4000);
 
 /**
  * @brief Muestra un mensaje de error
@@ -65,7 +85,7 @@ void showWarning(const String& text, uint32_t duration = 4000);
  * @param text Texto del mensaje
  * @param duration Duración en milisegundos (por defecto 5000ms)
  */
-void showError(const String& text, uint32_t duration = 5000);
+void showError(const char* text, uint32_t duration = 5000);
 
 /**
  * @brief Muestra un mensaje de éxito
@@ -73,7 +93,7 @@ void showError(const String& text, uint32_t duration = 5000);
  * @param text Texto del mensaje
  * @param duration Duración en milisegundos (por defecto 2000ms)
  */
-void showSuccess(const String& text, uint32_t duration = 2000);
+void showSuccess(const char* text, uint32_t duration = 2000);
 
 /**
  * @brief Muestra datos del sensor en la pantalla
@@ -98,4 +118,13 @@ void turnOffDisplayCompletely();
 /**
  * @brief Enciende la pantalla si está apagada
  */
-void turnOnDisplay();
\ No newline at end of file
+void turnOnDisplay();
+
+/**
+ * @brief Copia las medidas de los fotogramas enviados
+ *
+ * Solo se miden con DISPLAY_CAPTURE activado; si no, todo vale 0.
+ *
+ * @param out Destino de las medidas
+ */
+void getDisplayStats(ScreenStats* out);
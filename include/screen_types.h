@@ -0,0 +1,40 @@
+/**
+ * @file      screen_types.h
+ * @brief     Tipos y geometría de los mensajes de pantalla
+ *
+ * Cabecera en C sin dependencias de Arduino: la comparten screen.cpp y el
+ * generador de mensajes prerenderizados (scripts/status_bitmap_gen.c), que
+ * debe dibujar exactamente igual que renderMessage().
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef SCREEN_TYPES_H
+#define SCREEN_TYPES_H
+
+// Tipos de mensajes de pantalla
+enum ScreenMessageType {
+    MSG_INFO,           // Información general
+    MSG_WARNING,        // Advertencia
+    MSG_ERROR,          // Error
+    MSG_SUCCESS,        // Éxito
+    MSG_SENSOR_DATA,    // Datos del sensor
+    MSG_STATUS          // Estado del sistema
+};
+
+// Etiqueta de la cabecera de cada tipo, en el orden de ScreenMessageType
+// (inicializador de SCREEN_TYPE_LABELS en screen.cpp y en el generador)
+#define SCREEN_TYPE_LABEL_STRINGS "[INFO]", "[WARN]", "[ERROR]", "[OK]", "[SENSOR]", "[STATUS]"
+
+// Fuente de los mensajes
+#define SCREEN_FONT u8g2_font_ncenB08_tr
+
+// Línea base de la cabecera y del área de texto bajo ella
+#define SCREEN_HEADER_Y 10
+#define SCREEN_TEXT_FIRST_Y 25
+#define SCREEN_TEXT_LINE_STEP 12
+#define SCREEN_TEXT_MAX_LINES 3
+
+#endif // SCREEN_TYPES_H
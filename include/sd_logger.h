@@ -0,0 +1,105 @@
+/**
+ * @file      sd_logger.h
+ * @brief     Registro binario de solo anexado en la tarjeta SD
+ *
+ * Cada lectura se guarda como un registro de tamaño fijo (sensor_data_t,
+ * hora y número de secuencia) en un buffer de memoria RTC que sobrevive al
+ * sueño profundo. Solo se escriben bloques completos de 512 bytes (un
+ * sector), en una única apertura del archivo por vaciado, en lugar de abrir,
+ * escribir y cerrar el archivo por cada lectura.
+ *
+ * Los archivos (SD_LOG_DIR/LOGnnnnn.BIN) rotan al llegar a
+ * SD_LOG_MAX_FILE_BYTES. El índice SD_LOG_DIR/INDEX.BIN guarda una entrada
+ * por archivo (número, primera secuencia y hora) para localizar el archivo
+ * actual y leer los últimos registros sin recorrer el directorio.
+ *
+ * Solo actúa con ENABLE_SD_LOGGER en placas con HAS_SDCARD.
+ *
+ * Las estructuras sensor_data_t y payload_config_t están definidas en config.h.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef SD_LOGGER_H
+#define SD_LOGGER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Tamaño de bloque de escritura (sector de la SD)
+#define SD_LOG_BLOCK_BYTES 512
+
+/**
+ * @brief Registro tal y como se guarda en la SD (32 bytes)
+ */
+typedef struct {
+    uint32_t timestamp;    /**< Hora del reloj RTC (s) */
+    uint32_t sequence;     /**< Número de registro desde el primer archivo */
+    sensor_data_t data;    /**< Lectura */
+} sd_log_record_t;
+
+/**
+ * @brief Contadores del registro desde el último arranque en frío
+ */
+typedef struct {
+    uint32_t records;        /**< Registros anexados */
+    uint32_t dropped;        /**< Registros perdidos por buffer lleno o SD ausente */
+    uint32_t flushes;        /**< Aperturas del archivo para vaciar el buffer */
+    uint32_t bytesWritten;   /**< Bytes escritos en la SD (registros e índice) */
+} sd_logger_stats_t;
+
+/**
+ * @brief Localiza el archivo actual; en frío lo recupera del índice
+ *
+ * Llamar tras setupBoards() en cada despertar.
+ *
+ * @return false si no hay tarjeta o el registro está desactivado
+ */
+bool sd_logger_begin(void);
+
+/**
+ * @brief Anexa una lectura al buffer (sin acceder a la SD)
+ *
+ * Si el buffer está lleno, vacía antes los bloques completos.
+ *
+ * @return false si el registro no está activo o la lectura se perdió
+ */
+bool sd_logger_append(const sensor_data_t* data);
+
+/**
+ * @brief Escribe los bloques completos del buffer si superan el umbral
+ *
+ * Lo que no llena un bloque sigue en memoria RTC. Llamar antes de dormir.
+ *
+ * @return Bytes escritos en la SD
+ */
+size_t sd_logger_flush(void);
+
+/**
+ * @brief Escribe todo lo pendiente, aunque no llene un bloque
+ *
+ * Solo para apagados controlados: los siguientes vaciados dejan de estar
+ * alineados a bloque hasta la próxima rotación.
+ *
+ * @return Bytes escritos en la SD
+ */
+size_t sd_logger_sync(void);
+
+/**
+ * @brief Lee los últimos registros (incluidos los aún no escritos)
+ *
+ * @param out Destino, del más antiguo al más reciente
+ * @param max Número máximo de registros
+ * @return Registros leídos
+ */
+size_t sd_logger_read_tail(sd_log_record_t* out, size_t max);
+
+/**
+ * @brief Copia los contadores del registro
+ */
+void sd_logger_get_stats(sd_logger_stats_t* out);
+
+#endif // SD_LOGGER_H
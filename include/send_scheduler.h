@@ -0,0 +1,56 @@
+/**
+ * @file      send_scheduler.h
+ * @brief     Planificador adaptativo del intervalo de envío según energía
+ *
+ * Ajusta el tiempo de sueño profundo entre envíos a partir de:
+ * - El estado de carga estimado (battery_soc_estimate()).
+ * - Si la placa solar está cargando la batería (isSolarChargingBattery()).
+ * - La energía medida por ciclo (tiempo despierto x consumo típico).
+ *
+ * Muestrea más rápido mientras hay cosecha solar y espacia los envíos
+ * cuando la batería baja, de modo que la carga restante dure al menos
+ * BATTERY_TARGET_AUTONOMY_DAYS.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef SEND_SCHEDULER_H
+#define SEND_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Registra la duración del ciclo despierto que acaba de terminar
+ *
+ * @param awake_ms Tiempo despierto en milisegundos desde el arranque, sin
+ *                 contar el pasado en sueño ligero
+ */
+void scheduler_record_cycle(uint32_t awake_ms);
+
+/**
+ * @brief Calcula el intervalo de sueño hasta el siguiente envío
+ *
+ * @param soc_percent Estado de carga estimado (0-100) o BATTERY_SOC_UNKNOWN
+ * @param harvesting true si la placa solar está cargando la batería
+ * @return Intervalo en segundos, entre SEND_INTERVAL_MIN_SECONDS y SEND_INTERVAL_MAX_SECONDS
+ *         (SEND_INTERVAL_SECONDS si el SoC es desconocido)
+ */
+uint32_t scheduler_compute_interval(uint8_t soc_percent, bool harvesting);
+
+/**
+ * @brief Intervalo para el próximo sueño usando el estado actual de la batería
+ *
+ * Consulta el SoC y la carga solar y aplica scheduler_compute_interval().
+ * Con ENABLE_ADAPTIVE_INTERVAL desactivado devuelve SEND_INTERVAL_SECONDS.
+ */
+uint32_t scheduler_next_interval_seconds(void);
+
+/**
+ * @brief Energía media por ciclo despierto estimada (mAh)
+ */
+float scheduler_cycle_energy_mah(void);
+
+#endif // SEND_SCHEDULER_H
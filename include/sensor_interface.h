@@ -41,6 +41,11 @@ bool sensor_dht22_is_available(void);
  */
 bool sensor_dht22_retry_init(void);
 
+/**
+ * @brief Enciende el sensor DHT22 por adelantado (ver sensors_warm_up_all)
+ */
+void sensor_dht22_warm_up(void);
+
 /**
  * @brief Lee todos los datos del sensor DHT22
  */
@@ -76,6 +81,11 @@ bool sensor_dht11_is_available(void);
  */
 bool sensor_dht11_retry_init(void);
 
+/**
+ * @brief Enciende el sensor DHT11 por adelantado (ver sensors_warm_up_all)
+ */
+void sensor_dht11_warm_up(void);
+
 /**
  * @brief Lee todos los datos del sensor DHT11
  */
@@ -246,6 +256,14 @@ bool sensors_init_all(void);
  */
 bool sensors_is_any_available(void);
 
+/**
+ * @brief Enciende por adelantado los sensores que necesitan estabilizarse
+ *
+ * Así la espera de estabilización transcurre durante el join y la lectura
+ * de do_send() solo espera lo que falte. Los sensores sin espera no hacen nada.
+ */
+void sensors_warm_up_all(void);
+
 /**
  * @brief Intenta reinicializar todos los sensores
  */
@@ -261,6 +279,11 @@ bool sensors_read_all(sensor_data_t* data);
  */
 uint8_t sensors_get_payload(payload_config_t* config);
 
+/**
+ * @brief Construye el payload a partir de una lectura ya hecha (sin volver a leer)
+ */
+uint8_t sensors_build_payload(const sensor_data_t* data, payload_config_t* config);
+
 /**
  * @brief Obtiene el nombre de los sensores activos
  */
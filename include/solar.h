@@ -23,7 +23,7 @@
  * @brief Verifica si la placa solar está cargando la batería
  * @return true si hay entrada VBUS y la batería está cargándose
  */
-// bool isSolarChargingBattery();
+bool isSolarChargingBattery();
 
 /**
  * @brief Obtiene el estado de carga de la placa solar
@@ -0,0 +1,75 @@
+/**
+ * @file      spsc_queue.h
+ * @brief     Cola sin bloqueos de un productor y un consumidor
+ *
+ * Cola circular de N mensajes de tamaño fijo para pasar datos entre dos
+ * tareas (p. ej. entre los dos núcleos del ESP32) sin mutex ni secciones
+ * críticas. Un solo hilo puede llamar a push() y un solo hilo a pop();
+ * pueden ser el mismo.
+ *
+ * Cada índice lo escribe un único lado: el productor publica un mensaje con
+ * una escritura release de head_ después de copiarlo, y el consumidor libera
+ * el hueco con una escritura release de tail_ después de leerlo.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+template <typename T, size_t N>
+class SpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N debe ser potencia de 2");
+
+public:
+    /**
+     * @brief Añade una copia del mensaje (solo productor)
+     *
+     * @param reserve Huecos que deben quedar libres después (para mensajes
+     *                que no se pueden perder)
+     * @return false si la cola está llena
+     */
+    bool push(const T& item, size_t reserve = 0) {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) + reserve >= N) {
+            return false;
+        }
+        slots_[head & (N - 1)] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Saca el mensaje más antiguo (solo consumidor)
+     * @return false si la cola está vacía
+     */
+    bool pop(T& out) {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (head_.load(std::memory_order_acquire) == tail) {
+            return false;
+        }
+        out = slots_[tail & (N - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief true si no hay mensajes (exacto desde el consumidor, orientativo desde el productor)
+     */
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    T slots_[N];
+    std::atomic<uint32_t> head_{0};  // Siguiente hueco a escribir; solo lo modifica el productor
+    std::atomic<uint32_t> tail_{0};  // Siguiente hueco a leer; solo lo modifica el consumidor
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,53 @@
+/**
+ * @file      status_bitmaps.h
+ * @brief     Mensajes fijos de pantalla prerenderizados en flash
+ *
+ * Los mensajes de status_messages.def se dibujan al compilar con el mismo
+ * motor U8g2, fuente y posiciones que renderMessage(), y se guardan como
+ * filas de tiles en el formato del buffer de la pantalla. Mostrarlos es
+ * copiar esas filas al buffer, sin pasar por el motor de fuentes.
+ *
+ * src/status_bitmaps_data.c lo genera scripts/gen_status_bitmaps.py. Si no
+ * se puede generar, las entradas quedan vacías (tiles NULL), la compilación
+ * avisa con un #warning y screen.cpp dibuja el texto con la fuente.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef STATUS_BITMAPS_H
+#define STATUS_BITMAPS_H
+
+#include <stdint.h>
+
+/**
+ * @brief Identificadores de los mensajes fijos
+ */
+typedef enum {
+#define STATUS_MESSAGE(id, type, text) id,
+#include "status_messages.def"
+#undef STATUS_MESSAGE
+    STATUS_MESSAGE_COUNT
+} StatusMessage;
+
+/**
+ * @brief Mensaje prerenderizado: filas de tiles completas desde la fila 0
+ */
+typedef struct {
+    uint8_t tile_width;    /**< Ancho de la pantalla en tiles para el que se generó */
+    uint8_t tile_rows;     /**< Filas de tiles (8 px) ocupadas por el mensaje */
+    const uint8_t* tiles;  /**< tile_width * 8 * tile_rows bytes, NULL si no se generó */
+} status_bitmap_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const status_bitmap_t STATUS_BITMAPS[STATUS_MESSAGE_COUNT];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STATUS_BITMAPS_H
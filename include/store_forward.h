@@ -0,0 +1,95 @@
+/**
+ * @file      store_forward.h
+ * @brief     Cola persistente en flash para los envíos que no pudieron salir
+ *
+ * Si el join falla o el enlace se pierde, el payload de cada lectura se
+ * guarda en la partición "upqueue" (ver partitions.csv) en lugar de
+ * perderse. Cuando vuelve el enlace se reenvía en lotes por
+ * STORE_FORWARD_FPORT (ver store_forward_build_batch()).
+ *
+ * La partición es un anillo de registros de 32 bytes con número de
+ * secuencia y CRC16. Los sectores se borran en orden al entrar la cabeza en
+ * ellos, así que cada uno se borra una vez por vuelta (desgaste uniforme).
+ * Cabeza y cola no se guardan: se deducen de los propios registros, de modo
+ * que un corte de alimentación en cualquier punto deja, como mucho, un
+ * registro a medias (CRC inválido, se ignora) o un lote que se reenvía.
+ * Un registro enviado se marca programando a 0 su byte de estado, sin borrar.
+ *
+ * Con la cola llena, al borrar el siguiente sector se pierden los
+ * registros más antiguos.
+ *
+ * Formato del lote (FPort STORE_FORWARD_FPORT):
+ * - Byte 0: número de registros
+ * - Por registro: secuencia (uint16 BE), antigüedad en minutos (uint16 BE,
+ *   0xFFFF si se desconoce), longitud (1 byte) y el payload original
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef STORE_FORWARD_H
+#define STORE_FORWARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Payload máximo de un registro (los más largos no se guardan)
+#define STORE_FORWARD_MAX_PAYLOAD 20
+
+/**
+ * @brief Contadores de la cola
+ */
+typedef struct {
+    uint32_t pending;    /**< Registros sin enviar */
+    uint32_t capacity;   /**< Registros que caben en la partición */
+    uint32_t stored;     /**< Registros guardados desde el último arranque en frío */
+    uint32_t sent;       /**< Registros enviados desde el último arranque en frío */
+    uint32_t dropped;    /**< Registros perdidos por cola llena */
+    uint32_t erases;     /**< Sectores borrados desde el último arranque en frío */
+} store_forward_stats_t;
+
+/**
+ * @brief Localiza la partición; en frío reconstruye cabeza y cola leyéndola
+ *
+ * @return false si la cola está desactivada o no existe la partición
+ */
+bool store_forward_begin(void);
+
+/**
+ * @brief Guarda un payload al final de la cola
+ *
+ * @return false si la cola no está activa o falla la escritura
+ */
+bool store_forward_push(const uint8_t* payload, uint8_t len);
+
+/**
+ * @brief Registros pendientes de enviar
+ */
+uint32_t store_forward_pending(void);
+
+/**
+ * @brief Construye un lote con los registros más antiguos
+ *
+ * No los saca de la cola: hay que confirmarlos con store_forward_commit()
+ * cuando el envío termine bien.
+ *
+ * @param buf      Destino del lote
+ * @param max_size Tamaño máximo del lote (payload LoRaWAN)
+ * @param count    Registros incluidos en el lote
+ * @return Bytes del lote, 0 si no hay nada pendiente
+ */
+uint8_t store_forward_build_batch(uint8_t* buf, uint8_t max_size, uint8_t* count);
+
+/**
+ * @brief Marca como enviados los registros del último lote
+ */
+void store_forward_commit(void);
+
+/**
+ * @brief Copia los contadores de la cola
+ */
+void store_forward_get_stats(store_forward_stats_t* out);
+
+#endif // STORE_FORWARD_H
@@ -0,0 +1,97 @@
+/**
+ * @file      windowed_stats.h
+ * @brief     Estadísticas por ventana (min/max/media/desviación) de las lecturas
+ *
+ * Acumulador en streaming basado en el algoritmo de Welford: cada muestra se
+ * incorpora en O(1) sin guardar la serie, de modo que el estado cabe en
+ * memoria RTC y sobrevive al sueño profundo entre despertares de muestreo.
+ *
+ * Las estructuras sensor_data_t y payload_config_t están definidas en config.h.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef WINDOWED_STATS_H
+#define WINDOWED_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// ACUMULADOR DE UN CAMPO
+// ============================================================================
+
+/**
+ * @brief Estado del acumulador de Welford para un único campo
+ */
+typedef struct {
+    uint16_t count;   /**< Número de muestras válidas acumuladas */
+    float min;        /**< Valor mínimo observado */
+    float max;        /**< Valor máximo observado */
+    float mean;       /**< Media en curso */
+    float m2;         /**< Suma de cuadrados de las desviaciones (Welford) */
+} stats_accumulator_t;
+
+/**
+ * @brief Reinicia un acumulador a estado vacío
+ */
+void stats_accumulator_reset(stats_accumulator_t* acc);
+
+/**
+ * @brief Incorpora una muestra al acumulador
+ */
+void stats_accumulator_add(stats_accumulator_t* acc, float value);
+
+/**
+ * @brief Desviación típica poblacional de las muestras acumuladas
+ * @return 0 si hay menos de dos muestras
+ */
+float stats_accumulator_stddev(const stats_accumulator_t* acc);
+
+// ============================================================================
+// VENTANA DE ESTADÍSTICAS DE sensor_data_t
+// ============================================================================
+
+/**
+ * @brief Reinicia la ventana (llamar tras enviar el resumen)
+ */
+void stats_window_reset(void);
+
+/**
+ * @brief Añade una lectura a la ventana; los campos con valor de error se ignoran
+ */
+void stats_window_add_sample(const sensor_data_t* data);
+
+/**
+ * @brief Número de muestras tomadas en la ventana actual
+ */
+uint16_t stats_window_sample_count(void);
+
+/**
+ * @brief Indica si la ventana está completa y toca enviar el resumen
+ */
+bool stats_window_is_due(void);
+
+/**
+ * @brief Acceso de solo lectura al acumulador de cada campo
+ */
+const stats_accumulator_t* stats_window_temperature(void);
+const stats_accumulator_t* stats_window_humidity(void);
+const stats_accumulator_t* stats_window_pressure(void);
+const stats_accumulator_t* stats_window_distance(void);
+const stats_accumulator_t* stats_window_battery(void);
+
+/**
+ * @brief Construye el payload compacto con el resumen de la ventana
+ *
+ * Formato (big-endian): nº de muestras (1 byte), y para cada campo activo
+ * min, max, media y desviación con la misma escala que el payload normal;
+ * al final la batería mínima de la ventana (V * 100).
+ *
+ * @return Número de bytes escritos (0 si el buffer es insuficiente)
+ */
+uint8_t stats_window_get_payload(payload_config_t* config);
+
+#endif // WINDOWED_STATS_H
@@ -209,6 +209,14 @@ class U8G2
       { u8g2_UpdateDisplayArea(&u8g2, tx, ty, tw, th); }
     void updateDisplay(void)
       { u8g2_UpdateDisplay(&u8g2); }
+#ifdef U8G2_WITH_DIRTY_TILES
+    void updateDirty(void)
+      { u8g2_UpdateDirty(&u8g2); }
+    void markAllDirty(void)
+      { u8g2_MarkAllDirty(&u8g2); }
+#endif
+    void blitTileRows(uint8_t tile_row, uint8_t cnt, const uint8_t *src)
+      { u8g2_BlitTileRows(&u8g2, tile_row, cnt, src); }
     void refreshDisplay(void)
       { u8x8_RefreshDisplay(u8g2_GetU8x8(&u8g2)); }
     
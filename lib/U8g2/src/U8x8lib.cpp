@@ -1374,6 +1374,106 @@ extern "C" uint8_t u8x8_byte_arduino_hw_i2c(U8X8_UNUSED u8x8_t *u8x8, U8X8_UNUSE
   return 1;
 }
 
+/*=============================================*/
+/*=== ESP32 HARDWARE I2C ===*/
+
+/*
+  ESP32 byte procedure, which bypasses the 128 byte Wire buffer:
+    - Each transfer is collected in a local buffer and written with a single
+      i2cWrite() of the esp32-hal, so a complete tile row (control byte plus
+      128 data bytes) is one I2C transaction if U8X8_I2C_DATA_CHUNK allows it.
+    - The display clock (u8x8->bus_clock) is applied only when it differs from
+      the current bus clock. The previous clock of the shared bus is kept and
+      restored by u8x8_esp32_hw_i2c_release(), so that other devices (PMU,
+      sensors) continue with their own speed.
+  The bus must be the one used by "Wire" (I2C port 0).
+*/
+#if defined(U8X8_HAVE_HW_I2C) && defined(ARDUINO_ARCH_ESP32)
+
+#ifndef U8X8_ESP32_I2C_PORT
+#define U8X8_ESP32_I2C_PORT 0
+#endif
+
+#ifndef U8X8_ESP32_I2C_TIMEOUT_MS
+#define U8X8_ESP32_I2C_TIMEOUT_MS 20
+#endif
+
+/* control byte + largest data chunk of the cad procedures */
+#define U8X8_ESP32_I2C_BUF_SIZE (U8X8_I2C_DATA_CHUNK + 8)
+
+static uint8_t u8x8_esp32_i2c_buf[U8X8_ESP32_I2C_BUF_SIZE];
+static uint16_t u8x8_esp32_i2c_len;
+static uint8_t u8x8_esp32_i2c_addr;
+static uint32_t u8x8_esp32_i2c_shared_clock;	/* clock of the shared bus, 0: display clock not applied */
+
+static void u8x8_esp32_i2c_flush(void)
+{
+  if ( u8x8_esp32_i2c_len > 0 )
+    i2cWrite(U8X8_ESP32_I2C_PORT, u8x8_esp32_i2c_addr, u8x8_esp32_i2c_buf, u8x8_esp32_i2c_len, U8X8_ESP32_I2C_TIMEOUT_MS);
+  u8x8_esp32_i2c_len = 0;
+}
+
+extern "C" uint8_t u8x8_byte_esp32_hw_i2c(U8X8_UNUSED u8x8_t *u8x8, U8X8_UNUSED uint8_t msg, U8X8_UNUSED uint8_t arg_int, U8X8_UNUSED void *arg_ptr)
+{
+  uint32_t clock;
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      /* a transfer larger than the buffer is split, this only happens with a misconfigured U8X8_I2C_DATA_CHUNK */
+      if ( u8x8_esp32_i2c_len + arg_int > U8X8_ESP32_I2C_BUF_SIZE )
+        u8x8_esp32_i2c_flush();
+      memcpy(u8x8_esp32_i2c_buf + u8x8_esp32_i2c_len, arg_ptr, arg_int);
+      u8x8_esp32_i2c_len += arg_int;
+      break;
+    case U8X8_MSG_BYTE_INIT:
+      if ( u8x8->bus_clock == 0 ) 	/* issue 769 */
+	u8x8->bus_clock = u8x8->display_info->i2c_bus_clock_100kHz * 100000UL;
+      /* Wire owns the port: let it install the driver if this did not happen yet */
+      if ( u8x8->pins[U8X8_PIN_I2C_CLOCK] != U8X8_PIN_NONE && u8x8->pins[U8X8_PIN_I2C_DATA] != U8X8_PIN_NONE )
+      {
+	Wire.begin((int)u8x8->pins[U8X8_PIN_I2C_DATA] , u8x8->pins[U8X8_PIN_I2C_CLOCK]);
+      }
+      else
+      {
+	Wire.begin();
+      }
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      if ( u8x8_esp32_i2c_shared_clock == 0 )
+      {
+        clock = 0;
+        i2cGetClock(U8X8_ESP32_I2C_PORT, &clock);
+        if ( clock != u8x8->bus_clock )
+          i2cSetClock(U8X8_ESP32_I2C_PORT, u8x8->bus_clock);
+        u8x8_esp32_i2c_shared_clock = clock != 0 ? clock : u8x8->bus_clock;
+      }
+      u8x8_esp32_i2c_addr = u8x8_GetI2CAddress(u8x8)>>1;
+      u8x8_esp32_i2c_len = 0;
+      break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      u8x8_esp32_i2c_flush();
+      break;
+    default:
+      return 0;
+  }
+  return 1;
+}
+
+/* restore the clock of the shared bus after a display update */
+extern "C" void u8x8_esp32_hw_i2c_release(void)
+{
+  uint32_t clock = 0;
+  if ( u8x8_esp32_i2c_shared_clock == 0 )
+    return;
+  i2cGetClock(U8X8_ESP32_I2C_PORT, &clock);
+  if ( clock != u8x8_esp32_i2c_shared_clock )
+    i2cSetClock(U8X8_ESP32_I2C_PORT, u8x8_esp32_i2c_shared_clock);
+  u8x8_esp32_i2c_shared_clock = 0;
+}
+#endif /* U8X8_HAVE_HW_I2C && ARDUINO_ARCH_ESP32 */
+
 extern "C" uint8_t u8x8_byte_arduino_2nd_hw_i2c(U8X8_UNUSED u8x8_t *u8x8, U8X8_UNUSED uint8_t msg, U8X8_UNUSED uint8_t arg_int, U8X8_UNUSED void *arg_ptr)
 {
 #ifdef U8X8_HAVE_2ND_HW_I2C
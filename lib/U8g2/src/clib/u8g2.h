@@ -176,6 +176,45 @@
 #endif
 
 
+/*
+  Dirty tile tracking for full buffer mode (opt-in, define U8G2_WITH_DIRTY_TILES).
+  The hvline procedures mark every 8x8 tile they modify. u8g2_UpdateDirty()
+  then transfers only the modified tile spans instead of the complete buffer.
+  Two bitmaps per tile row are kept:
+    dirty_tiles:   tiles which differ from the display RAM
+    touched_tiles: tiles drawn since the last u8g2_ClearBuffer(); a clear
+                   moves them to dirty_tiles, because they become blank
+  Bit n is tile column n, bit 31 covers column 31 and all columns to the right.
+  Displays higher than U8G2_DIRTY_TILE_ROWS tile rows fall back to a full transfer.
+  Direct writes into the buffer (u8g2_GetBufferPtr) are not tracked.
+*/
+#ifdef U8G2_WITH_DIRTY_TILES
+#ifndef U8G2_DIRTY_TILE_ROWS
+#define U8G2_DIRTY_TILE_ROWS 16
+#endif
+#endif
+
+
+/*
+  Glyph offset index for the current font (opt-in, define U8G2_WITH_GLYPH_INDEX).
+  Without the index, u8g2_font_get_glyph_data() walks the glyph list from the
+  'A' or 'a' jump offset for every character. With the index, the offsets of
+  all glyphs with an encoding from U8G2_GLYPH_INDEX_FIRST to U8G2_GLYPH_INDEX_LAST
+  are collected in a single pass over the font, the first time a glyph is
+  requested after u8g2_SetFont(). Later lookups in this range are one table access.
+  Encodings outside the range use the linear search as before.
+  RAM: 2 bytes per encoding, 192 bytes for the default range 32..127.
+*/
+#ifdef U8G2_WITH_GLYPH_INDEX
+#ifndef U8G2_GLYPH_INDEX_FIRST
+#define U8G2_GLYPH_INDEX_FIRST 32
+#endif
+#ifndef U8G2_GLYPH_INDEX_LAST
+#define U8G2_GLYPH_INDEX_LAST 127
+#endif
+#endif
+
+
 /*==========================================*/
 
 
@@ -382,6 +421,16 @@ struct u8g2_struct
 					
 	// the following variable should be renamed to is_buffer_auto_clear
   uint8_t is_auto_page_clear; 		/* set to 0 to disable automatic clear of the buffer in firstPage() and nextPage() */
+
+#ifdef U8G2_WITH_DIRTY_TILES
+  uint32_t dirty_tiles[U8G2_DIRTY_TILE_ROWS];	/* tiles not yet transfered to the display, one bitmap per tile row */
+  uint32_t touched_tiles[U8G2_DIRTY_TILE_ROWS];	/* tiles drawn since the last u8g2_ClearBuffer() */
+#endif
+
+#ifdef U8G2_WITH_GLYPH_INDEX
+  const uint8_t *glyph_index_font;	/* font for which glyph_index has been built, NULL if none */
+  uint16_t glyph_index[U8G2_GLYPH_INDEX_LAST-U8G2_GLYPH_INDEX_FIRST+1];	/* glyph offset + 1, 0: glyph not in font */
+#endif
   
 };
 
@@ -1568,6 +1617,11 @@ uint8_t u8g2_NextPage(u8g2_t *u8g2);
 
 void u8g2_UpdateDisplayArea(u8g2_t *u8g2, uint8_t  tx, uint8_t ty, uint8_t tw, uint8_t th);
 void u8g2_UpdateDisplay(u8g2_t *u8g2);
+#ifdef U8G2_WITH_DIRTY_TILES
+void u8g2_UpdateDirty(u8g2_t *u8g2);
+void u8g2_MarkAllDirty(u8g2_t *u8g2);
+#endif
+void u8g2_BlitTileRows(u8g2_t *u8g2, uint8_t tile_row, uint8_t cnt, const uint8_t *src);
 
 void u8g2_WriteBufferPBM(u8g2_t *u8g2, void (*out)(const char *s));
 void u8g2_WriteBufferXBM(u8g2_t *u8g2, void (*out)(const char *s));
@@ -44,6 +44,17 @@ void u8g2_ClearBuffer(u8g2_t *u8g2)
   cnt *= u8g2->tile_buf_height;
   cnt *= 8;
   memset(u8g2->tile_buf_ptr, 0, cnt);
+#ifdef U8G2_WITH_DIRTY_TILES
+  {
+    uint8_t i;
+    /* everything drawn so far becomes blank and must be transfered again */
+    for( i = 0; i < U8G2_DIRTY_TILE_ROWS; i++ )
+    {
+      u8g2->dirty_tiles[i] |= u8g2->touched_tiles[i];
+      u8g2->touched_tiles[i] = 0;
+    }
+  }
+#endif
 }
 
 /*============================================*/
@@ -87,6 +98,10 @@ static void u8g2_send_buffer(u8g2_t *u8g2)
     src_row++;
     dest_row++;
   } while( src_row < src_max && dest_row < dest_max );
+
+#ifdef U8G2_WITH_DIRTY_TILES
+  memset(u8g2->dirty_tiles, 0, sizeof(u8g2->dirty_tiles));
+#endif
 }
 
 /* same as u8g2_send_buffer but also send the DISPLAY_REFRESH message (used by SSD1606) */
@@ -180,6 +195,98 @@ void u8g2_UpdateDisplay(u8g2_t *u8g2)
   u8g2_send_buffer(u8g2);
 }
 
+#ifdef U8G2_WITH_DIRTY_TILES
+/*
+  Description:
+    Transfer only the tiles modified since the last transfer. Each run of
+    consecutive dirty tiles within a tile row is sent with one u8x8_DrawTile().
+    Like u8g2_UpdateDisplay(), the ePaper refresh message is not sent.
+
+  Limitations:
+    - Falls back to a full transfer in page mode and for displays with more
+      than U8G2_DIRTY_TILE_ROWS tile rows
+    - Direct modifications of the buffer memory are not detected, call
+      u8g2_MarkAllDirty() after such changes
+*/
+void u8g2_UpdateDirty(u8g2_t *u8g2)
+{
+  uint8_t tile_width;
+  uint8_t tile_height;
+  uint8_t tx, ty, tw;
+  uint16_t page_size;
+  uint32_t bits;
+  uint8_t *ptr;
+
+  tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  tile_height = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  if ( u8g2->tile_buf_height != tile_height || tile_height > U8G2_DIRTY_TILE_ROWS )
+  {
+    u8g2_send_buffer(u8g2);
+    return;
+  }
+
+  page_size = u8g2->pixel_buf_width;
+  ptr = u8g2_GetBufferPtr(u8g2);
+  for( ty = 0; ty < tile_height; ty++ )
+  {
+    bits = u8g2->dirty_tiles[ty];
+    tx = 0;
+    while( bits != 0 && tx < tile_width )
+    {
+      if ( (bits & ((uint32_t)1 << (tx < 31 ? tx : 31))) == 0 )
+      {
+        tx++;
+        continue;
+      }
+      tw = 1;
+      while( tx + tw < tile_width && (bits & ((uint32_t)1 << (tx + tw < 31 ? tx + tw : 31))) != 0 )
+        tw++;
+      u8x8_DrawTile(u8g2_GetU8x8(u8g2), tx, ty, tw, ptr + tx*8);
+      tx += tw;
+    }
+    u8g2->dirty_tiles[ty] = 0;
+    ptr += page_size;
+  }
+}
+
+/* force the next u8g2_UpdateDirty() to transfer the complete buffer */
+void u8g2_MarkAllDirty(u8g2_t *u8g2)
+{
+  memset(u8g2->dirty_tiles, 0xff, sizeof(u8g2->dirty_tiles));
+  memset(u8g2->touched_tiles, 0xff, sizeof(u8g2->touched_tiles));
+}
+#endif
+
+/*
+  Description:
+    Copy complete tile rows, prepared in the memory format of this display
+    (for example with a host build of u8g2), into the buffer. "tile_row" is the
+    display tile row of the first source row, "src" holds "cnt" rows of
+    tile_width*8 bytes each. In page mode only the rows inside the current
+    page are copied. With U8G2_WITH_DIRTY_TILES the rows are marked as drawn.
+*/
+void u8g2_BlitTileRows(u8g2_t *u8g2, uint8_t tile_row, uint8_t cnt, const uint8_t *src)
+{
+  uint16_t row_size;
+  uint8_t r;
+  
+  row_size = u8g2_GetBufferTileWidth(u8g2);
+  row_size *= 8;
+  for( r = tile_row; r < tile_row + cnt; r++, src += row_size )
+  {
+    if ( r < u8g2->tile_curr_row || r >= u8g2->tile_curr_row + u8g2->tile_buf_height )
+      continue;
+    memcpy(u8g2_GetBufferPtr(u8g2) + (uint16_t)(r - u8g2->tile_curr_row) * row_size, src, row_size);
+#ifdef U8G2_WITH_DIRTY_TILES
+    if ( r < U8G2_DIRTY_TILE_ROWS )
+    {
+      u8g2->dirty_tiles[r] = 0xffffffff;
+      u8g2->touched_tiles[r] = 0xffffffff;
+    }
+#endif
+  }
+}
+
 
 /*============================================*/
 
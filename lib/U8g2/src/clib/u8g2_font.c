@@ -771,6 +771,38 @@ int8_t u8g2_font_2x_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
   return d*2;
 }
 
+#ifdef U8G2_WITH_GLYPH_INDEX
+/*
+  Description:
+    Collect the offsets of all glyphs in the index range with one pass over
+    the 8 bit glyph list of the current font.
+*/
+static void u8g2_font_build_glyph_index(u8g2_t *u8g2) U8G2_NOINLINE;
+static void u8g2_font_build_glyph_index(u8g2_t *u8g2)
+{
+  const uint8_t *glyph_start = u8g2->font + U8G2_FONT_DATA_STRUCT_SIZE;
+  const uint8_t *font = glyph_start;
+  uint8_t encoding;
+  uint8_t len;
+  uint16_t i;
+  
+  for( i = 0; i <= U8G2_GLYPH_INDEX_LAST-U8G2_GLYPH_INDEX_FIRST; i++ )
+    u8g2->glyph_index[i] = 0;
+  
+  for(;;)
+  {
+    len = u8x8_pgm_read( font + 1 );
+    if ( len == 0 )
+      break;
+    encoding = u8x8_pgm_read( font );
+    if ( encoding >= U8G2_GLYPH_INDEX_FIRST && encoding <= U8G2_GLYPH_INDEX_LAST )
+      u8g2->glyph_index[encoding-U8G2_GLYPH_INDEX_FIRST] = (uint16_t)(font - glyph_start) + 1;
+    font += len;
+  }
+  u8g2->glyph_index_font = u8g2->font;
+}
+#endif
+
 /*
   Description:
     Find the starting point of the glyph data.
@@ -787,6 +819,18 @@ const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding)
   
   if ( encoding <= 255 )
   {
+#ifdef U8G2_WITH_GLYPH_INDEX
+    if ( encoding >= U8G2_GLYPH_INDEX_FIRST && encoding <= U8G2_GLYPH_INDEX_LAST )
+    {
+      uint16_t pos;
+      if ( u8g2->glyph_index_font != u8g2->font )
+	u8g2_font_build_glyph_index(u8g2);
+      pos = u8g2->glyph_index[encoding-U8G2_GLYPH_INDEX_FIRST];
+      if ( pos == 0 )
+	return NULL;
+      return font+pos+1;	/* pos is offset + 1, skip encoding and glyph size */
+    }
+#endif
     if ( encoding >= 'a' )
     {
       font += u8g2->font_info.start_pos_lower_a;
@@ -129,6 +129,45 @@ static uint8_t u8g2_clip_intersection2(u8g2_uint_t *ap, u8g2_uint_t *len, u8g2_u
   will clip the line and call u8g2_draw_low_level_hv_line()
 
 */
+#ifdef U8G2_WITH_DIRTY_TILES
+/*
+  mark the tiles covered by a clipped line in pixel buffer coordinates
+*/
+static void u8g2_mark_dirty_tiles(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  u8g2_uint_t c0, c1, r0, r1;
+  uint32_t mask;
+
+  c0 = x >> 3;
+  r0 = y >> 3;
+  if ( dir == 0 )
+  {
+    c1 = (x + len - 1) >> 3;
+    r1 = r0;
+  }
+  else
+  {
+    c1 = c0;
+    r1 = (y + len - 1) >> 3;
+  }
+  if ( c0 > 31 )
+    c0 = 31;
+  if ( c1 > 31 )
+    c1 = 31;
+  if ( r1 >= U8G2_DIRTY_TILE_ROWS )
+    r1 = U8G2_DIRTY_TILE_ROWS - 1;
+
+  /* bits c0..c1, "2<<31" becomes 0 and the subtraction still wraps to the right mask */
+  mask = ((uint32_t)2 << c1) - ((uint32_t)1 << c0);
+  while ( r0 <= r1 )
+  {
+    u8g2->dirty_tiles[r0] |= mask;
+    u8g2->touched_tiles[r0] |= mask;
+    r0++;
+  }
+}
+#endif
+
 void u8g2_draw_hv_line_2dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
 {
 
@@ -136,6 +175,10 @@ void u8g2_draw_hv_line_2dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uin
 
   /* transform to pixel buffer coordinates */
   y -= u8g2->pixel_curr_row;
+
+#ifdef U8G2_WITH_DIRTY_TILES
+  u8g2_mark_dirty_tiles(u8g2, x, y, len, dir);
+#endif
   
   u8g2->ll_hvline(u8g2, x, y, len, dir);
 }
@@ -89,6 +89,14 @@ void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_
   u8g2->draw_color = 1;
   u8g2->is_auto_page_clear = 1;
   
+#ifdef U8G2_WITH_DIRTY_TILES
+  u8g2_MarkAllDirty(u8g2);	/* content of buffer and display RAM is unknown */
+#endif
+
+#ifdef U8G2_WITH_GLYPH_INDEX
+  u8g2->glyph_index_font = NULL;	/* index is built with the first glyph lookup */
+#endif
+  
   u8g2->cb = u8g2_cb;
   u8g2->cb->update_dimension(u8g2);
 #ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
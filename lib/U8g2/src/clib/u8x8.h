@@ -106,6 +106,15 @@
 /* 26 May 2016: Obsolete */
 //#define U8X8_DEFAULT_FLIP_MODE 0
 
+/* Largest data block the ssd13xx i2c cad procedures pass to the byte procedure */
+/* in one transfer. 24 keeps control byte and data within the 32 byte Arduino */
+/* Wire buffer. Byte procedures without this limit (u8x8_byte_esp32_hw_i2c) */
+/* can use 128, so that a complete tile row of a 128 pixel wide display is */
+/* one I2C transaction. */
+#ifndef U8X8_I2C_DATA_CHUNK
+#define U8X8_I2C_DATA_CHUNK 24
+#endif
+
 /*==========================================*/
 /* Includes */
 
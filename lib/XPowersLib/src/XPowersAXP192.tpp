@@ -1248,6 +1248,43 @@ public:
         return readRegisterH8L4(XPOWERS_AXP192_APS_AVERVOL_H8, XPOWERS_AXP192_APS_AVERVOL_L4) * XPOWERS_AXP192_APS_VOLTAGE_STEP;
     }
 
+    /*
+    * Status snapshot: STATUS/MODE_CHGSTATUS (0x00-0x01) and the ADC block
+    * (0x56-0x7F) are read in one burst each instead of one transaction per byte.
+    */
+    bool getStatusSnapshot(XPowersStatusSnapshot_t &snap)
+    {
+        uint8_t status[2];
+        uint8_t adc[XPOWERS_AXP192_APS_AVERVOL_L4 - XPOWERS_AXP192_ACIN_VOL_H8 + 1];
+        if (readRegister(XPOWERS_AXP192_STATUS, status, sizeof(status)) != 0) {
+            return false;
+        }
+        if (readRegister(XPOWERS_AXP192_ACIN_VOL_H8, adc, sizeof(adc)) != 0) {
+            return false;
+        }
+#define AXP192_ADC_H8L4(h, l) ((adc[(h) - XPOWERS_AXP192_ACIN_VOL_H8] << 4) | (adc[(l) - XPOWERS_AXP192_ACIN_VOL_H8] & 0x0F))
+#define AXP192_ADC_H8L5(h, l) ((adc[(h) - XPOWERS_AXP192_ACIN_VOL_H8] << 5) | (adc[(l) - XPOWERS_AXP192_ACIN_VOL_H8] & 0x1F))
+        snap.vbusIn = status[0] & _BV(5);
+        snap.discharging = !(status[0] & _BV(2));
+        snap.charging = status[1] & _BV(6);
+        snap.batteryConnected = status[1] & _BV(5);
+        snap.battVoltage = snap.batteryConnected ?
+                           AXP192_ADC_H8L4(XPOWERS_AXP192_BAT_AVERVOL_H8, XPOWERS_AXP192_BAT_AVERVOL_L4) * XPOWERS_AXP192_BATT_VOLTAGE_STEP : 0;
+        snap.vbusVoltage = snap.vbusIn ?
+                           AXP192_ADC_H8L4(XPOWERS_AXP192_VBUS_VOL_H8, XPOWERS_AXP192_VBUS_VOL_L4) * XPOWERS_AXP192_VBUS_VOLTAGE_STEP : 0;
+        snap.systemVoltage = AXP192_ADC_H8L4(XPOWERS_AXP192_APS_AVERVOL_H8, XPOWERS_AXP192_APS_AVERVOL_L4) * XPOWERS_AXP192_APS_VOLTAGE_STEP;
+        snap.temperature = AXP192_ADC_H8L4(XPOWERS_AXP192_INTERNAL_TEMP_H8, XPOWERS_AXP192_INTERNAL_TEMP_L4)
+                           * XPOWERS_AXP192_INTERNAL_TEMP_STEP - XPOWERS_AXP192_INERNAL_TEMP_OFFSET;
+        snap.chargeCurrent = AXP192_ADC_H8L5(XPOWERS_AXP192_BAT_AVERCHGCUR_H8, XPOWERS_AXP192_BAT_AVERCHGCUR_L5)
+                             * XPOWERS_AXP192_BATT_CHARGE_CUR_STEP;
+        snap.dischargeCurrent = snap.batteryConnected ?
+                                AXP192_ADC_H8L5(XPOWERS_AXP192_BAT_AVERDISCHGCUR_H8, XPOWERS_AXP192_BAT_AVERDISCHGCUR_L5)
+                                * XPOWERS_AXP192_BATT_DISCHARGE_CUR_STEP : 0;
+#undef AXP192_ADC_H8L4
+#undef AXP192_ADC_H8L5
+        return true;
+    }
+
     /*
     * Timer Control
     */
@@ -2323,6 +2323,36 @@ public:
         return readRegister(XPOWERS_AXP2101_BAT_PERCENT_DATA);
     }
 
+    /*
+    * Status snapshot: STATUS1/STATUS2 (0x00-0x01) and the ADC results
+    * (0x34-0x3D) are read in one burst each instead of one transaction per byte.
+    */
+    bool getStatusSnapshot(XPowersStatusSnapshot_t &snap)
+    {
+        uint8_t status[2];
+        uint8_t adc[XPOWERS_AXP2101_ADC_DATA_RELUST9 - XPOWERS_AXP2101_ADC_DATA_RELUST0 + 1];
+        if (readRegister(XPOWERS_AXP2101_STATUS1, status, sizeof(status)) != 0) {
+            return false;
+        }
+        if (readRegister(XPOWERS_AXP2101_ADC_DATA_RELUST0, adc, sizeof(adc)) != 0) {
+            return false;
+        }
+        // adc[0..1] battery (H5L8), adc[2..3] TS, adc[4..5] VBUS, adc[6..7] VSYS, adc[8..9] die temp (H6L8)
+        bool vbusGood = status[0] & _BV(5);
+        uint8_t chg = status[1] >> 5;
+        snap.batteryConnected = status[0] & _BV(3);
+        snap.vbusIn = !(status[1] & _BV(3)) && vbusGood;
+        snap.charging = chg == 0x01;
+        snap.discharging = chg == 0x02;
+        snap.battVoltage = snap.batteryConnected ? (((adc[0] & 0x1F) << 8) | adc[1]) : 0;
+        snap.vbusVoltage = snap.vbusIn ? (((adc[4] & 0x3F) << 8) | adc[5]) : 0;
+        snap.systemVoltage = ((adc[6] & 0x3F) << 8) | adc[7];
+        snap.temperature = XPOWERS_AXP2101_CONVERSION((uint16_t)(((adc[8] & 0x3F) << 8) | adc[9]));
+        snap.chargeCurrent = 0;
+        snap.dischargeCurrent = 0;
+        return true;
+    }
+
     /*
     * CHG LED setting and control
     */
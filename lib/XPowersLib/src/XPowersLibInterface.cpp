@@ -107,6 +107,21 @@ uint16_t XPowersLibInterface::getVbusVoltage()
     return 0;
 }
 
+bool XPowersLibInterface::getStatusSnapshot(XPowersStatusSnapshot_t &snap)
+{
+    snap.vbusIn = isVbusIn();
+    snap.batteryConnected = isBatteryConnect();
+    snap.charging = isCharging();
+    snap.discharging = isDischarge();
+    snap.battVoltage = getBattVoltage();
+    snap.vbusVoltage = getVbusVoltage();
+    snap.systemVoltage = getSystemVoltage();
+    snap.temperature = 0;
+    snap.chargeCurrent = 0;
+    snap.dischargeCurrent = 0;
+    return true;
+}
+
 static uint64_t inline check_params(uint32_t opt, uint32_t params, uint64_t mask)
 {
     return ((opt & params) == params) ? mask : 0;
@@ -156,6 +156,20 @@ public:
     }
 };
 
+// @brief Decoded PMU status, filled from a few burst register reads
+typedef struct __XPowersStatusSnapshot {
+    bool     vbusIn;            // VBUS/USB power present
+    bool     batteryConnected;  // Battery detected
+    bool     charging;          // Battery is being charged
+    bool     discharging;       // Battery is supplying the system
+    uint16_t battVoltage;       // Battery voltage in millivolt, 0 if no battery
+    uint16_t vbusVoltage;       // VBUS voltage in millivolt, 0 if no vbus
+    uint16_t systemVoltage;     // System (APS/VSYS) voltage in millivolt
+    float    temperature;       // Die temperature in degrees Celsius
+    float    chargeCurrent;     // Battery charge current in mA, 0 if not measured
+    float    dischargeCurrent;  // Battery discharge current in mA, 0 if not measured
+} XPowersStatusSnapshot_t;
+
 // @brief Power resource interface class
 class XPowersLibInterface : public HasBatteryLevel
 {
@@ -647,6 +661,16 @@ public:
      */
     virtual uint8_t getPowerKeyPressOffTime() = 0;
 
+    /**
+     * @brief  Read status and ADC results in as few I2C transactions as possible
+     * @note   AXP192/AXP2101 read their contiguous status and ADC register blocks
+     *         in one burst each and decode every field from the local copy.
+     *         Other chips fall back to the individual getters.
+     * @param  snap: Filled with the decoded values
+     * @retval true valid false i2c error
+     */
+    virtual bool getStatusSnapshot(XPowersStatusSnapshot_t &snap);
+
     /**
      * @brief Get the chip model
      * @retval See XPowersChipModel_t enumeration
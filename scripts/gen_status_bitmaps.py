@@ -0,0 +1,111 @@
+"""
+Genera src/status_bitmaps_data.c con los mensajes fijos de pantalla
+prerenderizados (ver include/status_bitmaps.h).
+
+Se ejecuta antes de cada compilación como extra_script de PlatformIO y
+también a mano: python scripts/gen_status_bitmaps.py
+
+Compila scripts/status_bitmap_gen.c para el PC junto con las fuentes C de
+U8g2 de lib/ y guarda su salida. Solo se regenera si alguna entrada (también
+las fuentes de U8g2) es más reciente que el fichero generado. Si no hay
+compilador nativo o el generador no compila (por ejemplo, porque lib/U8g2 no
+trae u8g2_fonts.c), escribe una tabla vacía con un #warning que indica el
+motivo y el firmware dibuja esos mensajes con la fuente. Para reintentar,
+borrar src/status_bitmaps_data.c.
+"""
+
+import glob
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+try:
+    Import("env")  # noqa: F821 (definido por PlatformIO)
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SCRIPT_DIR = os.path.join(PROJECT_DIR, "scripts")
+INCLUDE_DIR = os.path.join(PROJECT_DIR, "include")
+U8G2_DIR = os.path.join(PROJECT_DIR, "lib", "U8g2", "src", "clib")
+OUTPUT = os.path.join(PROJECT_DIR, "src", "status_bitmaps_data.c")
+
+U8G2_SOURCES = sorted(glob.glob(os.path.join(U8G2_DIR, "u8g2_*.c")) +
+                      glob.glob(os.path.join(U8G2_DIR, "u8x8_*.c")))
+
+INPUTS = [
+    os.path.join(INCLUDE_DIR, "status_messages.def"),
+    os.path.join(INCLUDE_DIR, "screen_types.h"),
+    os.path.join(SCRIPT_DIR, "status_bitmap_gen.c"),
+    os.path.abspath(__file__) if "__file__" in globals() else os.path.join(SCRIPT_DIR, "gen_status_bitmaps.py"),
+    U8G2_DIR,  # Cambia si se añaden o quitan fuentes (u8g2_fonts.c)
+] + U8G2_SOURCES
+
+FALLBACK = """/* Generado por scripts/gen_status_bitmaps.py sin prerenderizar: no editar */
+
+#include "status_bitmaps.h"
+
+#warning "status_bitmaps: %s; los mensajes fijos se dibujan con la fuente (ver scripts/gen_status_bitmaps.py)"
+
+const status_bitmap_t STATUS_BITMAPS[STATUS_MESSAGE_COUNT] = {{0, 0, 0}};
+"""
+
+
+def up_to_date():
+    if not os.path.exists(OUTPUT):
+        return False
+    out_time = os.path.getmtime(OUTPUT)
+    return all(os.path.getmtime(p) <= out_time for p in INPUTS if os.path.exists(p))
+
+
+def write_output(text):
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT) as f:
+            if f.read() == text:
+                os.utime(OUTPUT)  # Al día sin forzar la recompilación
+                return
+    with open(OUTPUT, "w", newline="\n") as f:
+        f.write(text)
+
+
+def write_fallback(reason):
+    print("status_bitmaps: AVISO: %s, mensajes fijos sin prerenderizar" % reason)
+    write_output(FALLBACK % reason)
+
+
+def find_host_compiler():
+    for name in (os.environ.get("HOST_CC"), "cc", "gcc", "clang"):
+        if name and shutil.which(name):
+            return shutil.which(name)
+    return None
+
+
+def generate():
+    compiler = find_host_compiler()
+    if compiler is None:
+        write_fallback("sin compilador nativo")
+        return
+
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, "status_bitmap_gen")
+        cmd = [compiler, "-O1", "-w", "-I", U8G2_DIR, "-I", INCLUDE_DIR,
+               os.path.join(SCRIPT_DIR, "status_bitmap_gen.c")] + U8G2_SOURCES + ["-o", exe]
+        build = subprocess.run(cmd, capture_output=True, text=True)
+        if build.returncode != 0:
+            print(build.stderr)
+            write_fallback("el generador no compila")
+            return
+
+        run = subprocess.run([exe], capture_output=True, text=True)
+        if run.returncode != 0:
+            # Un mensaje que no cabe es un error de la lista, no del entorno
+            sys.stderr.write(run.stderr)
+            raise SystemExit("status_bitmaps: error generando los mensajes fijos")
+        write_output(run.stdout)
+        print("status_bitmaps: %s generado" % os.path.relpath(OUTPUT, PROJECT_DIR))
+
+
+if not up_to_date():
+    generate()
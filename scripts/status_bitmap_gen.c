@@ -0,0 +1,86 @@
+/**
+ * @file      status_bitmap_gen.c
+ * @brief     Generador nativo de los mensajes fijos prerenderizados
+ *
+ * Se compila para el PC con las fuentes C de U8g2 del proyecto y dibuja cada
+ * mensaje de status_messages.def igual que renderMessage() (misma fuente,
+ * cabecera y posiciones de screen_types.h) en el buffer de una SSD1306
+ * 128x64. Escribe por stdout el fichero C con las filas de tiles ocupadas.
+ *
+ * Lo invoca scripts/gen_status_bitmaps.py; no forma parte del firmware.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <stdio.h>
+#include "u8g2.h"
+#include "screen_types.h"
+
+typedef struct {
+    const char* id;
+    int type;
+    const char* text;
+} message_t;
+
+static const message_t MESSAGES[] = {
+#define STATUS_MESSAGE(id, type, text) { #id, type, text },
+#include "status_messages.def"
+#undef STATUS_MESSAGE
+};
+
+#define MESSAGE_COUNT (sizeof(MESSAGES) / sizeof(MESSAGES[0]))
+
+static const char* const SCREEN_TYPE_LABELS[] = {SCREEN_TYPE_LABEL_STRINGS};
+
+int main(void) {
+    u8g2_t u8g2;
+    u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_empty, u8x8_dummy_cb);
+
+    const unsigned tileWidth = u8g2_GetBufferTileWidth(&u8g2);
+    const unsigned tileRows = u8g2_GetBufferTileHeight(&u8g2);
+    const unsigned rowBytes = tileWidth * 8;
+    const uint8_t* buf = u8g2_GetBufferPtr(&u8g2);
+    unsigned rows[MESSAGE_COUNT];
+
+    printf("/* Generado por scripts/gen_status_bitmaps.py a partir de status_messages.def: no editar */\n\n");
+    printf("#include \"status_bitmaps.h\"\n");
+
+    for (unsigned i = 0; i < MESSAGE_COUNT; i++) {
+        u8g2_ClearBuffer(&u8g2);
+        u8g2_SetFont(&u8g2, SCREEN_FONT);
+        u8g2_DrawStr(&u8g2, 0, SCREEN_HEADER_Y, SCREEN_TYPE_LABELS[MESSAGES[i].type]);
+
+        if (u8g2_GetStrWidth(&u8g2, MESSAGES[i].text) > u8g2_GetDisplayWidth(&u8g2)) {
+            fprintf(stderr, "%s: \"%s\" no cabe en una línea\n", MESSAGES[i].id, MESSAGES[i].text);
+            return 1;
+        }
+        u8g2_DrawStr(&u8g2, 0, SCREEN_TEXT_FIRST_Y, MESSAGES[i].text);
+
+        // Solo se guardan las filas hasta la última con algún píxel encendido
+        rows[i] = 0;
+        for (unsigned r = 0; r < tileRows; r++) {
+            for (unsigned b = 0; b < rowBytes; b++) {
+                if (buf[r * rowBytes + b] != 0) {
+                    rows[i] = r + 1;
+                    break;
+                }
+            }
+        }
+
+        printf("\n// %s: \"%s\"\n", MESSAGES[i].id, MESSAGES[i].text);
+        printf("static const uint8_t %s_TILES[] = {", MESSAGES[i].id);
+        for (unsigned b = 0; b < rows[i] * rowBytes; b++) {
+            printf("%s0x%02x,", (b % 16) ? " " : "\n    ", buf[b]);
+        }
+        printf("\n};\n");
+    }
+
+    printf("\nconst status_bitmap_t STATUS_BITMAPS[STATUS_MESSAGE_COUNT] = {\n");
+    for (unsigned i = 0; i < MESSAGE_COUNT; i++) {
+        printf("    {%u, %u, %s_TILES},\n", tileWidth, rows[i], MESSAGES[i].id);
+    }
+    printf("};\n");
+    return 0;
+}
@@ -16,8 +16,13 @@
  */
 
 #include "LoRaBoards.h"
+#include "battery_adc.h"
+#include "battery_soc.h"
+#include "pmu_profile.h"
+#include "boot_mode.h"
 
 #include "soc/rtc.h"
+#include <esp_sleep.h>
 #ifdef ENABLE_BLE
 #include <BLEDevice.h>
 #include <BLEUtils.h>
@@ -52,11 +57,6 @@ XPowersLibInterface *PMU = NULL;
 bool pmuInterrupt;
 #endif
 
-#ifdef HAS_GPS
-static bool find_gps = false;
-String gps_model = "None";
-#endif
-
 
 uint32_t deviceOnline = 0x00;
 
@@ -374,13 +374,10 @@ void disablePeripherals()
 
     if (!PMU)return;
 
-    PMU->setChargingLedMode(XPOWERS_CHG_LED_OFF);
-    // Disable the PMU measurement section
-    PMU->disableSystemVoltageMeasure();
-    PMU->disableVbusVoltageMeasure();
-    PMU->disableBattVoltageMeasure();
-    PMU->disableTemperatureMeasure();
-    PMU->disableBattDetection();
+    // Medidas, LED de carga, IRQ y raíles de LoRa/GNSS/OLED en una sola transacción
+    pmu_profile_apply(PMU_PROFILE_DEEP_SLEEP);
+    // Clear the PMU interrupt status before sleeping, otherwise the sleep current will increase
+    PMU->clearIrqStatus();
 
 #if defined(T_BEAM_S3_BPF)
     PMU->disablePowerOutput(XPOWERS_ALDO4); //gps
@@ -392,48 +389,17 @@ void disablePeripherals()
 
     if (PMU->getChipModel() == XPOWERS_AXP2101) {
 
-        // Disable all PMU interrupts
-        PMU->disableIRQ(XPOWERS_AXP2101_ALL_IRQ);
-        // Clear the PMU interrupt status before sleeping, otherwise the sleep current will increase
-        PMU->clearIrqStatus();
         // OLED VDD
         PMU->disablePowerOutput(XPOWERS_DCDC1);
         // GNSS RTC Power , Turning off GPS backup voltage and current can further reduce ~ 100 uA
         PMU->disablePowerOutput(XPOWERS_VBACKUP);
-        // LoRa VDD
-        PMU->disablePowerOutput(XPOWERS_ALDO2);
-        // GNSS VDD
-        PMU->disablePowerOutput(XPOWERS_ALDO3);
 
 #if defined(T_BEAM_S3_SUPREME)
         PMU->disablePowerOutput(XPOWERS_ALDO4);
-        PMU->disablePowerOutput(XPOWERS_ALDO1);
-        PMU->disablePowerOutput(XPOWERS_BLDO1);
-        PMU->disablePowerOutput(XPOWERS_BLDO2);
         PMU->disablePowerOutput(XPOWERS_DCDC3);
         PMU->disablePowerOutput(XPOWERS_DCDC4);
         PMU->disablePowerOutput(XPOWERS_DCDC5);
 #endif
-
-        // Additional disables for maximum power saving
-        PMU->disablePowerOutput(XPOWERS_ALDO1);
-        PMU->disablePowerOutput(XPOWERS_BLDO1);
-        PMU->disablePowerOutput(XPOWERS_BLDO2);
-
-    } else if (PMU->getChipModel() == XPOWERS_AXP192) {
-
-        // Disable all PMU interrupts
-        PMU->disableIRQ(XPOWERS_AXP192_ALL_IRQ);
-        // Clear the PMU interrupt status before sleeping, otherwise the sleep current will increase
-        PMU->clearIrqStatus();
-        // LoRa VDD
-        PMU->disablePowerOutput(XPOWERS_LDO2);
-        // GNSS VDD
-        PMU->disablePowerOutput(XPOWERS_LDO3);
-        // OLED VDD
-        PMU->disablePowerOutput(XPOWERS_DCDC1);
-
-
     }
 #endif
 }
@@ -507,6 +473,12 @@ bool beginDisplay()
     if (Wire.endTransmission() == 0) {
         Serial.printf("Find Display model at 0x%X address\n", DISPLAY_ADDR);
         u8g2 = new DISPLAY_MODEL(U8G2_R0, U8X8_PIN_NONE);
+#if defined(ARDUINO_ARCH_ESP32)
+        // Backend I2C del ESP32: una transacción por fila de tiles y reloj propio
+        // para la pantalla, sin cambiar la velocidad del resto del bus
+        u8g2->getU8x8()->byte_cb = u8x8_byte_esp32_hw_i2c;
+        u8g2->setBusClock(DISPLAY_I2C_CLOCK_HZ);
+#endif
         u8g2->begin();
         u8g2->clearBuffer();
 
@@ -528,8 +500,11 @@ bool beginDisplay()
 
         // ===== OPCIÓN: SIN LOGO =====
         // Pantalla en blanco durante inicialización (ahorro de energía)
+        // Con buffer por páginas begin() ya dejó la pantalla en blanco
+#if !DISPLAY_PAGE_BUFFER
         u8g2->clearBuffer();
         u8g2->sendBuffer();
+#endif
 
         // ===== OPCIÓN: SIN LOGO =====
         // Comenta las líneas anteriores y descomenta:
@@ -578,7 +553,7 @@ bool writeFile(const char *path, const char *buffer)
  * @param path Ruta del archivo en la SD.
  * @param buffer Buffer donde almacenar los datos leídos.
  * @param size Tamaño máximo a leer.
- * @return true si la lectura es exitosa, false en caso contrario.
+ * @return true si se leyó al menos un byte, false en caso contrario.
  */
 bool readFile(const char *path, uint8_t *buffer, size_t size)
 {
@@ -587,9 +562,9 @@ bool readFile(const char *path, uint8_t *buffer, size_t size)
         Serial.println("Failed to open file for reading");
         return false;
     }
-    file.read(buffer, size);
+    size_t n = file.read(buffer, size);
     file.close();
-    return false;
+    return n > 0;
 }
 
 /**
@@ -610,9 +585,7 @@ bool testSDWriteAndRead()
     }
     delay(100);
 
-    readFile(path, buffer, 128);
-
-    if (memcmp(buffer, message, strlen(message)) != 0) {
+    if (!readFile(path, buffer, sizeof(buffer)) || memcmp(buffer, message, strlen(message)) != 0) {
         Serial.println("SD verification failed");
         return false;
     }
@@ -796,7 +769,10 @@ void setupBoards(bool disable_u8g2 )
 
     Serial.println("setupBoards");
 
-    getChipInfo();
+    // En caliente el chip es el mismo que en el último arranque completo
+    if (!boot_mode_warm()) {
+        getChipInfo();
+    }
 
 #if defined(ARDUINO_ARCH_ESP32)
     SPI.begin(RADIO_SCLK_PIN, RADIO_MISO_PIN, RADIO_MOSI_PIN);
@@ -849,10 +825,15 @@ void setupBoards(bool disable_u8g2 )
 #endif // HAS_GPS
 
 #if OLED_RST
+    // En caliente el OLED sigue configurado; begin() lo reinicializa si hace falta
     pinMode(OLED_RST, OUTPUT);
-    digitalWrite(OLED_RST, HIGH); delay(20);
-    digitalWrite(OLED_RST, LOW);  delay(20);
-    digitalWrite(OLED_RST, HIGH); delay(20);
+    if (boot_mode_warm()) {
+        digitalWrite(OLED_RST, HIGH);
+    } else {
+        digitalWrite(OLED_RST, HIGH); delay(20);
+        digitalWrite(OLED_RST, LOW);  delay(20);
+        digitalWrite(OLED_RST, HIGH); delay(20);
+    }
 #endif
 
 #ifdef BOARD_LED
@@ -911,6 +892,12 @@ void setupBoards(bool disable_u8g2 )
 
     beginPower();
 
+    // Recuperar medidas e IRQ que el perfil de sueño apagó en el PMU
+    pmu_profile_restore();
+
+    // Elegir una sola vez la fuente de medida de batería (PMU o ADC)
+    battery_adc_begin();
+
     // Perform an I2C scan after power-on operation
 #ifdef I2C_SDA
     Wire.begin(I2C_SDA, I2C_SCL);
@@ -921,9 +908,16 @@ void setupBoards(bool disable_u8g2 )
     beginSDCard();
 
 #ifdef HAS_DISPLAY
-    beginDisplay();
+    // Al despertar por temporizador la pantalla no se toca; screen.cpp la
+    // inicializa bajo demanda si hay que mostrar un error
+    if (!boot_mode_headless()) {
+        beginDisplay();
+    }
     if (u8g2) {
         u8g2->setPowerSave(1);  // Apagar display inmediatamente para ahorro de energía
+#if defined(ARDUINO_ARCH_ESP32)
+        u8x8_esp32_hw_i2c_release();  // Devolver el bus a la velocidad del PMU y sensores
+#endif
     }
 #endif
 
@@ -937,28 +931,7 @@ void setupBoards(bool disable_u8g2 )
 
 #ifdef HAS_GPS
 
-#if defined(T_BEAM_S3_SUPREME) || defined(T_BEAM_1W) || defined(T_BEAM_S3_BPF)
-    // T-Beam v1.2 skips L76K
-    find_gps = beginGPS();
-#endif
-    uint32_t baudrate[] = {9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600, 4800};
-    if (!find_gps) {
-        // Restore factory settings
-        for ( int i = 0; i < sizeof(baudrate) / sizeof(baudrate[0]); ++i) {
-            Serial.printf("Update baudrate : %u\n", baudrate[i]);
-            SerialGPS.updateBaudRate(baudrate[i]);
-            if (recoveryGPS()) {
-                Serial.println("UBlox GNSS init succeeded, using UBlox GNSS Module\n");
-                gps_model = "UBlox";
-                find_gps = true;
-                break;
-            }
-        }
-    } else {
-        gps_model = "L76K";
-    }
-
-    if (find_gps) {
+    if (detectGPS()) {
         deviceOnline |= GPS_ONLINE;
     }
 
@@ -971,10 +944,12 @@ void setupBoards(bool disable_u8g2 )
 
     // Indicador visual de inicio con LED (breve parpadeo para ahorro de energía)
 #ifdef BOARD_LED
-    digitalWrite(BOARD_LED, LED_ON);
-    delay(100);
-    digitalWrite(BOARD_LED, !LED_ON);  // Apagar LED después del parpadeo
-    Serial.println("DEBUG: BOARD_LED turned OFF after setup");
+    if (!boot_mode_warm()) {
+        digitalWrite(BOARD_LED, LED_ON);
+        delay(100);
+        digitalWrite(BOARD_LED, !LED_ON);  // Apagar LED después del parpadeo
+        Serial.println("DEBUG: BOARD_LED turned OFF after setup");
+    }
 #endif
 
     // Asegurar que el LED de carga del PMU esté apagado
@@ -1018,31 +993,32 @@ void printResult(bool radio_online)
 
 #ifdef HAS_GPS
     Serial.print("GPS          : ");
-    Serial.println(( find_gps ) ? "+" : "-");
+    Serial.println(( gpsDetected() ) ? "+" : "-");
 #endif
 
 #ifdef DISPLAY_MODEL
     if (u8g2) {
 
-        u8g2->clearBuffer();
-        u8g2->setFont(u8g2_font_NokiaLargeBold_tf );
-        uint16_t str_w =  u8g2->getStrWidth(BOARD_VARIANT_NAME);
-        u8g2->drawStr((u8g2->getWidth() - str_w) / 2, 16, BOARD_VARIANT_NAME);
-        u8g2->drawHLine(5, 21, u8g2->getWidth() - 5);
+        // Bucle de páginas: válido tanto con buffer completo como por páginas
+        u8g2->firstPage();
+        do {
+            u8g2->setFont(u8g2_font_NokiaLargeBold_tf );
+            uint16_t str_w =  u8g2->getStrWidth(BOARD_VARIANT_NAME);
+            u8g2->drawStr((u8g2->getWidth() - str_w) / 2, 16, BOARD_VARIANT_NAME);
+            u8g2->drawHLine(5, 21, u8g2->getWidth() - 5);
 
-        u8g2->drawStr( 0, 38, "Disp:");     u8g2->drawStr( 45, 38, ( u8g2) ? "+" : "-");
+            u8g2->drawStr( 0, 38, "Disp:");     u8g2->drawStr( 45, 38, ( u8g2) ? "+" : "-");
 
 #ifdef HAS_SDCARD
-        u8g2->drawStr( 0, 54, "SD :");      u8g2->drawStr( 45, 54, (SD.cardSize() != 0) ? "+" : "-");
+            u8g2->drawStr( 0, 54, "SD :");      u8g2->drawStr( 45, 54, (SD.cardSize() != 0) ? "+" : "-");
 #endif
 
-        u8g2->drawStr( 62, 38, "Radio:");    u8g2->drawStr( 120, 38, ( radio_online ) ? "+" : "-");
+            u8g2->drawStr( 62, 38, "Radio:");    u8g2->drawStr( 120, 38, ( radio_online ) ? "+" : "-");
 
 #ifdef HAS_PMU
-        u8g2->drawStr( 62, 54, "Power:");    u8g2->drawStr( 120, 54, ( PMU ) ? "+" : "-");
+            u8g2->drawStr( 62, 54, "Power:");    u8g2->drawStr( 120, 54, ( PMU ) ? "+" : "-");
 #endif
-
-        u8g2->sendBuffer();
+        } while (u8g2->nextPage());
 
         delay(2000);
     }
@@ -1079,265 +1055,6 @@ void flashLed()
 #endif
 
 
-/**
- * @brief Escanea dispositivos I2C en el bus especificado.
- *        Intenta comunicarse con direcciones I2C del 0x01 al 0x7F
- *        e identifica dispositivos conocidos como sensores o displays.
- *
- * @param w Puntero al objeto TwoWire (bus I2C) a escanear.
- */
-void scanDevices(TwoWire *w)
-{
-    uint8_t err, addr;
-    int nDevices = 0;
-    uint32_t start = 0;
-
-    Serial.println("I2C Devices scanning");
-    for (addr = 1; addr < 127; addr++) {
-        start = millis();
-        w->beginTransmission(addr); delay(2);
-        err = w->endTransmission();
-        if (err == 0) {
-            nDevices++;
-            switch (addr) {
-            case 0x34:
-                Serial.println("\tFind AXP192/AXP2101 PMU!");
-                deviceOnline |= POWERMANAGE_ONLINE;
-                break;
-            case 0x3C:
-                Serial.println("\tFind SSD1306/SH1106 dispaly!");
-                deviceOnline |= DISPLAY_ONLINE;
-                break;
-            case 0x51:
-                Serial.println("\tFind PCF8563 RTC!");
-                deviceOnline |= PCF8563_ONLINE;
-                break;
-            case 0x1C:
-                Serial.println("\tFind QMC6310 MAG Sensor!");
-                deviceOnline |= QMC6310_ONLINE;
-                break;
-            default:
-                Serial.print("\tI2C device found at address 0x");
-                if (addr < 16) {
-                    Serial.print("0");
-                }
-                Serial.print(addr, HEX);
-                Serial.println(" !");
-                break;
-            }
-
-        } else if (err == 4) {
-            Serial.print("Unknow error at address 0x");
-            if (addr < 16) {
-                Serial.print("0");
-            }
-            Serial.println(addr, HEX);
-        }
-    }
-    if (nDevices == 0)
-        Serial.println("No I2C devices found\n");
-
-    Serial.println("Scan devices done.");
-    Serial.println("\n");
-}
-
-
-#ifdef HAS_GPS
-
-/**
- * @brief Prueba la conexión con el módulo GPS L76K.
- *        Envía comandos para detener NMEA y configurar el módulo.
- *
- * @return true si el módulo responde correctamente, false en caso contrario.
- */
-bool l76kProbe()
-{
-    bool result = false;
-    uint32_t startTimeout ;
-    SerialGPS.write("$PCAS03,0,0,0,0,0,0,0,0,0,0,,,0,0*02\r\n");
-    delay(5);
-    // Get version information
-    startTimeout = millis() + 3000;
-    Serial.print("Try to init L76K . Wait stop .");
-    // SerialGPS.flush();
-    while (SerialGPS.available()) {
-        int c = SerialGPS.read();
-        // Serial.write(c);
-        // Serial.print(".");
-        // Serial.flush();
-        // SerialGPS.flush();
-        if (millis() > startTimeout) {
-            Serial.println("Wait L76K stop NMEA timeout!");
-            return false;
-        }
-    };
-    Serial.println();
-    SerialGPS.flush();
-    delay(200);
-
-    SerialGPS.write("$PCAS06,0*1B\r\n");
-    startTimeout = millis() + 500;
-    String ver = "";
-    while (!SerialGPS.available()) {
-        if (millis() > startTimeout) {
-            Serial.println("Get L76K timeout!");
-            return false;
-        }
-    }
-    SerialGPS.setTimeout(10);
-    ver = SerialGPS.readStringUntil('\n');
-    if (ver.startsWith("$GPTXT,01,01,02")) {
-        Serial.println("L76K GNSS init succeeded, using L76K GNSS Module\n");
-        result = true;
-    }
-    delay(500);
-
-    // Initialize the L76K Chip, use GPS + GLONASS
-    SerialGPS.write("$PCAS04,5*1C\r\n");
-    delay(250);
-    // only ask for RMC and GGA
-    SerialGPS.write("$PCAS03,1,0,0,0,1,0,0,0,0,0,,,0,0*02\r\n");
-    delay(250);
-    // Switch to Vehicle Mode, since SoftRF enables Aviation < 2g
-    SerialGPS.write("$PCAS11,3*1E\r\n");
-    return result;
-}
-
-/**
- * @brief Inicializa el módulo GPS.
- *        Intenta inicializar L76K hasta 3 veces.
- *
- * @return true si la inicialización es exitosa, false en caso contrario.
- */
-bool beginGPS()
-{
-    SerialGPS.begin(GPS_BAUD_RATE, SERIAL_8N1, GPS_RX_PIN, GPS_TX_PIN);
-    bool result = false;
-    for ( int i = 0; i < 3; ++i) {
-        result = l76kProbe();
-        if (result) {
-            return result;
-        }
-    }
-    return result;
-}
-
-
-
-/**
- * @brief Obtiene el acknowledgment (ACK) del módulo GPS UBX.
- *        Espera una respuesta específica del módulo GPS.
- *
- * @param buffer Buffer para almacenar la respuesta.
- * @param size Tamaño máximo del buffer.
- * @param requestedClass Clase UBX esperada.
- * @param requestedID ID UBX esperado.
- * @return Número de bytes leídos, 0 si falla.
- */
-static int getAck(uint8_t *buffer, uint16_t size, uint8_t requestedClass, uint8_t requestedID)
-{
-    uint16_t    ubxFrameCounter = 0;
-    bool        ubxFrame = 0;
-    uint32_t    startTime = millis();
-    uint16_t    needRead;
-
-    while (millis() - startTime < 800) {
-        while (SerialGPS.available()) {
-            int c = SerialGPS.read();
-            switch (ubxFrameCounter) {
-            case 0:
-                if (c == 0xB5) {
-                    ubxFrameCounter++;
-                }
-                break;
-            case 1:
-                if (c == 0x62) {
-                    ubxFrameCounter++;
-                } else {
-                    ubxFrameCounter = 0;
-                }
-                break;
-            case 2:
-                if (c == requestedClass) {
-                    ubxFrameCounter++;
-                } else {
-                    ubxFrameCounter = 0;
-                }
-                break;
-            case 3:
-                if (c == requestedID) {
-                    ubxFrameCounter++;
-                } else {
-                    ubxFrameCounter = 0;
-                }
-                break;
-            case 4:
-                needRead = c;
-                ubxFrameCounter++;
-                break;
-            case 5:
-                needRead |=  (c << 8);
-                ubxFrameCounter++;
-                break;
-            case 6:
-                if (needRead >= size) {
-                    ubxFrameCounter = 0;
-                    break;
-                }
-                if (SerialGPS.readBytes(buffer, needRead) != needRead) {
-                    ubxFrameCounter = 0;
-                } else {
-                    return needRead;
-                }
-                break;
-
-            default:
-                break;
-            }
-        }
-    }
-    return 0;
-}
-
-/**
- * @brief Recupera la configuración del módulo GPS UBX.
- *        Envía comandos para restaurar configuración por defecto y configurar tasa de navegación.
- *
- * @return true si la recuperación es exitosa, false en caso contrario.
- */
-bool recoveryGPS()
-{
-    uint8_t buffer[256];
-    uint8_t cfg_clear1[] = {0xB5, 0x62, 0x06, 0x09, 0x0D, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x1C, 0xA2};
-    uint8_t cfg_clear2[] = {0xB5, 0x62, 0x06, 0x09, 0x0D, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x1B, 0xA1};
-    uint8_t cfg_clear3[] = {0xB5, 0x62, 0x06, 0x09, 0x0D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x03, 0x1D, 0xB3};
-    SerialGPS.write(cfg_clear1, sizeof(cfg_clear1));
-
-    if (getAck(buffer, 256, 0x05, 0x01)) {
-        Serial.println("Get ack successes!");
-    }
-    SerialGPS.write(cfg_clear2, sizeof(cfg_clear2));
-    if (getAck(buffer, 256, 0x05, 0x01)) {
-        Serial.println("Get ack successes!");
-    }
-    SerialGPS.write(cfg_clear3, sizeof(cfg_clear3));
-    if (getAck(buffer, 256, 0x05, 0x01)) {
-        Serial.println("Get ack successes!");
-    }
-    // UBX-CFG-RATE, Size 8, 'Navigation/measurement rate settings'
-    uint8_t cfg_rate[] = {0xB5, 0x62, 0x06, 0x08, 0x00, 0x00, 0x0E, 0x30};
-    SerialGPS.write(cfg_rate, sizeof(cfg_rate));
-    if (getAck(buffer, 256, 0x06, 0x08)) {
-        Serial.println("Get ack successes!");
-    } else {
-        return false;
-    }
-    return true;
-}
-
-#endif
-
-
 #if defined(ARDUINO_ARCH_ESP32)
 
 //NCP18XH103F03RB: https://item.szlcsc.com/14214.html
@@ -1522,67 +1239,23 @@ void scanWiFi()
 /**
  * @brief Lee el voltaje de batería de la forma más fiable disponible.
  *        Si hay PMU, usa el chip AXP192/AXP2101. Si no, usa el ADC y divisor resistivo.
- *        El voltaje máximo esperado es 4.2V (batería 18650 Li-Ion).
+ *        La fuente se elige una vez por arranque y el valor se cachea durante el
+ *        despertar (ver battery_adc.cpp).
  *
- * @return Voltaje de batería en voltios (float).
+ * @return Voltaje de batería en voltios (float), 0.0 si no hay medida válida.
  */
 float readBatteryVoltage() {
-
-#ifdef HAS_PMU
-    if (PMU) {
-        float v = PMU->getBattVoltage() / 1000.0f;
-        Serial.printf("DEBUG: PMU battery voltage raw: %d mV, converted: %.3f V\n", PMU->getBattVoltage(), v);
-        // Protección: solo valores razonables
-        if (v > 2.5f && v < 4.5f) {
-            Serial.printf("DEBUG: Using PMU voltage: %.3f V\n", v);
-            return v;
-        } else {
-            Serial.printf("DEBUG: PMU voltage %.3f V out of range, trying ADC\n", v);
-        }
-    } else {
-        Serial.println("DEBUG: PMU not available");
-    }
-#endif
-
-#ifdef ADC_PIN
-    // Leer ADC y calcular voltaje usando divisor resistivo
-    uint16_t raw = analogRead(ADC_PIN);
-    float vref = 3.3f; // Voltaje de referencia ESP32
-    float adcMax = 4095.0f;
-    float v_adc = (raw / adcMax) * vref;
-    float r1 = BAT_ADC_PULLUP_RES;
-    float r2 = BAT_ADC_PULLDOWN_RES;
-    float v_bat = v_adc * ((r1 + r2) / r2);
-    // Compensación opcional
-    v_bat += BAT_VOL_COMPENSATION;
-
-    Serial.printf("DEBUG: ADC raw: %d, v_adc: %.3f V, r1: %.0f, r2: %.0f, v_bat: %.3f V\n",
-                  raw, v_adc, r1, r2, v_bat);
-
-    // Protección: solo valores razonables
-    if (v_bat > 2.5f && v_bat < 4.5f) {
-        Serial.printf("DEBUG: Using ADC voltage: %.3f V\n", v_bat);
-        return v_bat;
-    } else {
-        Serial.printf("DEBUG: ADC voltage %.3f V out of range\n", v_bat);
-    }
-#endif
-
-    Serial.println("DEBUG: All voltage readings failed, returning 0.0V");
-    // Si todo falla, devuelve 0.0V
-    return 0.0f;
+    return battery_read_voltage();
 }
 
 /**
  * @brief Obtiene el porcentaje de batería estimado a partir del voltaje.
- *        3.0V = 0%, 4.2V = 100% (batería 18650 Li-Ion).
+ *        Usa la curva OCV de una celda 18650 Li-Ion compensando la caída por
+ *        la corriente típica con el ESP32 despierto (ver battery_soc.cpp).
  *
- * @param voltage Voltaje de batería en voltios.
+ * @param voltage Voltaje de batería en voltios medido con el equipo despierto.
  * @return Porcentaje estimado (0-100).
  */
 uint8_t batteryPercentFromVoltage(float voltage) {
-    if (voltage < 3.0f) return 0;
-    if (voltage > 4.2f) return 100;
-    return (uint8_t)(((voltage - 3.0f) / (4.2f - 3.0f)) * 100.0f);
+    return battery_soc_from_voltage(voltage);
 }
-
@@ -0,0 +1,183 @@
+/**
+ * @file      battery_adc.cpp
+ * @brief     Implementación de la medición de batería calibrada y cacheada
+ *
+ * - La elección PMU/ADC se hace una vez por arranque.
+ * - El ADC se caracteriza con los valores de eFuse (Two Point o Vref) y, si
+ *   el chip no los tiene, con la referencia por defecto de 1100 mV.
+ * - Se toman BATTERY_ADC_SAMPLES muestras, se ordenan y se descarta un cuarto
+ *   por cada extremo antes de promediar (media recortada).
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "battery_adc.h"
+#include "LoRaBoards.h"        // PMU y constantes del divisor de batería
+#include "pmu_status.h"        // Estado del PMU leído una vez por ciclo
+
+#if defined(ADC_PIN) && defined(ARDUINO_ARCH_ESP32)
+#include <driver/adc.h>
+#include <esp_adc_cal.h>
+#endif
+
+#ifndef BATTERY_ADC_SAMPLES
+#define BATTERY_ADC_SAMPLES 16
+#endif
+
+#ifndef BATTERY_CACHE_MS
+#define BATTERY_CACHE_MS 60000
+#endif
+
+// Rango de voltajes plausibles para una celda Li-Ion
+#define BATTERY_MIN_VALID_V 2.5f
+#define BATTERY_MAX_VALID_V 4.5f
+
+static battery_source_t source = BATTERY_SOURCE_UNKNOWN;
+static float cachedVoltage = 0.0f;
+static uint32_t cachedAt = 0;
+static bool cacheValid = false;
+
+#if defined(ADC_PIN) && defined(ARDUINO_ARCH_ESP32)
+static esp_adc_cal_characteristics_t adcChars;
+static adc1_channel_t adcChannel;
+static bool adcReady = false;
+
+/**
+ * @brief Configura el canal ADC1 del pin de batería y carga la calibración eFuse
+ */
+static bool adc_setup() {
+    int8_t channel = digitalPinToAnalogChannel(ADC_PIN);
+    if (channel < 0 || channel >= ADC1_CHANNEL_MAX) {
+        Serial.printf("Bateria: el pin %d no pertenece a ADC1\n", ADC_PIN);
+        return false;
+    }
+    adcChannel = (adc1_channel_t)channel;
+
+    adc1_config_width(ADC_WIDTH_BIT_12);
+    adc1_config_channel_atten(adcChannel, ADC_ATTEN_DB_11);
+
+    esp_adc_cal_value_t cal = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11,
+                                                       ADC_WIDTH_BIT_12, 1100, &adcChars);
+    switch (cal) {
+        case ESP_ADC_CAL_VAL_EFUSE_TP:   Serial.println("Bateria: ADC calibrado (eFuse Two Point)"); break;
+        case ESP_ADC_CAL_VAL_EFUSE_VREF: Serial.println("Bateria: ADC calibrado (eFuse Vref)"); break;
+        default:                         Serial.println("Bateria: ADC sin eFuse, Vref por defecto"); break;
+    }
+    adcReady = true;
+    return true;
+}
+
+/**
+ * @brief Lee el ADC con sobremuestreo y media recortada
+ * @return Voltaje de batería en V (antes de validar el rango)
+ */
+static float adc_read_voltage() {
+    uint16_t samples[BATTERY_ADC_SAMPLES];
+
+    for (int i = 0; i < BATTERY_ADC_SAMPLES; i++) {
+        uint16_t raw = adc1_get_raw(adcChannel);
+        // Inserción ordenada: N es pequeño y evita una pasada extra
+        int j = i;
+        while (j > 0 && samples[j - 1] > raw) {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = raw;
+    }
+
+    // Descartar el cuarto inferior y superior (picos de ruido, acoplos de la radio)
+    const int trim = BATTERY_ADC_SAMPLES / 4;
+    uint32_t sum = 0;
+    for (int i = trim; i < BATTERY_ADC_SAMPLES - trim; i++) {
+        sum += samples[i];
+    }
+    uint32_t raw = sum / (BATTERY_ADC_SAMPLES - 2 * trim);
+
+    float v_adc = esp_adc_cal_raw_to_voltage(raw, &adcChars) / 1000.0f;
+    float v_bat = v_adc * ((BAT_ADC_PULLUP_RES + BAT_ADC_PULLDOWN_RES) / BAT_ADC_PULLDOWN_RES);
+    return v_bat + BAT_VOL_COMPENSATION;
+}
+#endif
+
+/**
+ * @brief Comprueba que un voltaje está en el rango de una celda Li-Ion
+ */
+static bool is_plausible(float v) {
+    return v > BATTERY_MIN_VALID_V && v < BATTERY_MAX_VALID_V;
+}
+
+void battery_adc_begin(void) {
+    if (source != BATTERY_SOURCE_UNKNOWN) {
+        return;
+    }
+
+#ifdef HAS_PMU
+    const XPowersStatusSnapshot_t* status = pmu_status();
+    if (status && is_plausible(status->battVoltage / 1000.0f)) {
+        source = BATTERY_SOURCE_PMU;
+        Serial.println("Bateria: usando medida del PMU");
+        return;
+    }
+#endif
+
+#if defined(ADC_PIN) && defined(ARDUINO_ARCH_ESP32)
+    if (adc_setup()) {
+        source = BATTERY_SOURCE_ADC;
+        return;
+    }
+#endif
+
+    source = BATTERY_SOURCE_NONE;
+    Serial.println("Bateria: sin fuente de medida disponible");
+}
+
+float battery_read_voltage(void) {
+    if (cacheValid && millis() - cachedAt < BATTERY_CACHE_MS) {
+        return cachedVoltage;
+    }
+
+    battery_adc_begin();
+
+    float v = 0.0f;
+    switch (source) {
+#ifdef HAS_PMU
+        case BATTERY_SOURCE_PMU:
+        {
+            const XPowersStatusSnapshot_t* status = pmu_status();
+            v = status ? status->battVoltage / 1000.0f : 0.0f;
+            break;
+        }
+#endif
+#if defined(ADC_PIN) && defined(ARDUINO_ARCH_ESP32)
+        case BATTERY_SOURCE_ADC:
+            v = adc_read_voltage();
+            break;
+#endif
+        default:
+            break;
+    }
+
+    if (!is_plausible(v)) {
+        // Sin caché: un fallo aislado no debe dar la batería por agotada
+        // durante BATTERY_CACHE_MS; la siguiente llamada vuelve a medir
+        Serial.printf("Bateria: lectura fuera de rango (%.3f V)\n", v);
+        return 0.0f;
+    }
+
+    cachedVoltage = v;
+    cachedAt = millis();
+    cacheValid = true;
+    return v;
+}
+
+void battery_invalidate_cache(void) {
+    cacheValid = false;
+    pmu_status_invalidate();
+}
+
+battery_source_t battery_get_source(void) {
+    return source;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file      battery_soc.cpp
+ * @brief     Implementación del modelo de estado de carga Li-Ion
+ *
+ * La curva de una celda Li-Ion es casi plana entre el 30 % y el 70 %, por lo
+ * que un mapeo lineal de la tensión se equivoca en decenas de puntos. Aquí se
+ * interpola una tabla OCV y, con el AXP192, se integra la carga neta medida
+ * por su contador de culombios.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "battery_soc.h"
+#include "LoRaBoards.h"        // PMU y readBatteryVoltage()
+#include "pmu_status.h"        // Estado del PMU leído una vez por ciclo
+
+#ifndef BATTERY_CAPACITY_MAH
+#define BATTERY_CAPACITY_MAH 3000
+#endif
+
+#ifndef BATTERY_INTERNAL_RESISTANCE_MOHM
+#define BATTERY_INTERNAL_RESISTANCE_MOHM 150
+#endif
+
+#ifndef BATTERY_AWAKE_CURRENT_MA
+#define BATTERY_AWAKE_CURRENT_MA 45
+#endif
+
+#ifndef ENABLE_COULOMB_COUNTING
+#define ENABLE_COULOMB_COUNTING true
+#endif
+
+// Peso de la OCV en cada corrección del conteo de culombios (limita la deriva)
+#define SOC_OCV_CORRECTION_WEIGHT 0.05f
+
+// Tensión en reposo (mV) de una celda 18650 típica, del 0 % al 100 % en pasos del 5 %
+static const uint16_t OCV_TABLE_MV[] = {
+    3000, 3300, 3450, 3530, 3590, 3630, 3660, 3690, 3710, 3730, 3760,
+    3790, 3820, 3860, 3900, 3940, 3980, 4030, 4080, 4130, 4190
+};
+#define OCV_TABLE_STEPS (sizeof(OCV_TABLE_MV) / sizeof(OCV_TABLE_MV[0]) - 1)
+
+/**
+ * @brief Estado persistente entre despertares (memoria RTC)
+ */
+typedef struct {
+    bool valid;            /**< true si soc contiene una estimación previa */
+    float soc;             /**< Estado de carga en % (0-100) */
+    float lastCoulombMah;  /**< Lectura del contador del PMU en la última estimación */
+} soc_state_t;
+
+RTC_DATA_ATTR static soc_state_t state;
+
+uint8_t battery_soc_from_ocv(float ocv_voltage) {
+    float mv = ocv_voltage * 1000.0f;
+    if (mv <= OCV_TABLE_MV[0]) return 0;
+    if (mv >= OCV_TABLE_MV[OCV_TABLE_STEPS]) return 100;
+
+    for (uint8_t i = 1; i <= OCV_TABLE_STEPS; i++) {
+        if (mv < OCV_TABLE_MV[i]) {
+            float span = OCV_TABLE_MV[i] - OCV_TABLE_MV[i - 1];
+            float fraction = (mv - OCV_TABLE_MV[i - 1]) / span;
+            return (uint8_t)(((i - 1) + fraction) * (100.0f / OCV_TABLE_STEPS) + 0.5f);
+        }
+    }
+    return 100;
+}
+
+float battery_soc_compensate(float terminal_voltage, float current_ma) {
+    // V_ocv = V_bornes + I * R_interna (I > 0 descargando, I < 0 cargando)
+    return terminal_voltage + (current_ma / 1000.0f) * (BATTERY_INTERNAL_RESISTANCE_MOHM / 1000.0f);
+}
+
+uint8_t battery_soc_from_voltage(float voltage) {
+    return battery_soc_from_ocv(battery_soc_compensate(voltage, BATTERY_AWAKE_CURRENT_MA));
+}
+
+#ifdef HAS_PMU
+/**
+ * @brief Devuelve el AXP192 si es el PMU detectado (único con contador de culombios)
+ */
+static XPowersAXP192* coulomb_pmu() {
+    if (!ENABLE_COULOMB_COUNTING || !PMU || PMU->getChipModel() != XPOWERS_AXP192) {
+        return NULL;
+    }
+    return static_cast<XPowersAXP192*>(PMU);
+}
+#endif
+
+/**
+ * @brief Corriente de batería estimada en mA (positiva descargando)
+ */
+static float battery_current_ma() {
+#ifdef HAS_PMU
+    // Del estado de este ciclo, ya leído para la tensión y la carga solar
+    const XPowersStatusSnapshot_t* status = coulomb_pmu() ? pmu_status() : NULL;
+    if (status) {
+        return status->charging ? -status->chargeCurrent : status->dischargeCurrent;
+    }
+#endif
+    // Sin medida de corriente: consumo típico con el ESP32 despierto
+    return BATTERY_AWAKE_CURRENT_MA;
+}
+
+bool battery_soc_uses_coulomb_counter(void) {
+#ifdef HAS_PMU
+    return coulomb_pmu() != NULL && state.valid;
+#else
+    return false;
+#endif
+}
+
+uint8_t battery_soc_estimate(void) {
+    float voltage = readBatteryVoltage();
+    if (voltage <= 0.0f) {
+        return state.valid ? (uint8_t)(state.soc + 0.5f) : BATTERY_SOC_UNKNOWN;
+    }
+
+    float ocvSoc = battery_soc_from_ocv(battery_soc_compensate(voltage, battery_current_ma()));
+
+#ifdef HAS_PMU
+    XPowersAXP192* axp = coulomb_pmu();
+    if (axp) {
+        if (!state.valid) {
+            // Primera estimación tras arranque en frío: sembrar con la OCV
+            axp->enableCoulomb();
+            state.soc = ocvSoc;
+            state.lastCoulombMah = axp->getCoulombData();
+            state.valid = true;
+        } else {
+            float coulombMah = axp->getCoulombData();
+            float deltaMah = coulombMah - state.lastCoulombMah;
+            state.lastCoulombMah = coulombMah;
+
+            state.soc += deltaMah * 100.0f / BATTERY_CAPACITY_MAH;
+            // Corrección lenta hacia la OCV para acotar la deriva del contador
+            state.soc += (ocvSoc - state.soc) * SOC_OCV_CORRECTION_WEIGHT;
+        }
+        state.soc = constrain(state.soc, 0.0f, 100.0f);
+        return (uint8_t)(state.soc + 0.5f);
+    }
+#endif
+
+    state.soc = ocvSoc;
+    state.valid = true;
+    return (uint8_t)ocvSoc;
+}
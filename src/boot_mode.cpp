@@ -0,0 +1,124 @@
+/**
+ * @file      boot_mode.cpp
+ * @brief     Implementación de la política de arranque y de las medidas del arranque
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "boot_mode.h"
+#include <esp_sleep.h>
+#include <esp_timer.h>
+
+static const char* const MODE_NAMES[BOOT_MODE_COUNT] = {
+    "interactivo", "sin pantalla"
+};
+
+static const char* const PHASE_NAMES[BOOT_PHASE_COUNT] = {
+    "setup", "placa", "LMIC", "listo", "TX"
+};
+
+static bool modeKnown = false;
+static boot_mode_t mode = BOOT_MODE_INTERACTIVE;
+static bool warmKnown = false;
+static bool warm = false;
+static bool txMarked = false;
+
+// Último tiempo arranque->TX medido en cada modo (ms, 0 = sin medir)
+RTC_DATA_ATTR static uint32_t lastBootToTxMs[BOOT_MODE_COUNT];
+
+// El ciclo anterior llegó al sueño profundo
+RTC_DATA_ATTR static bool lastCycleHealthy = false;
+
+// Instante de cada fase del último arranque (µs desde el arranque, 0 = sin marcar)
+RTC_DATA_ATTR static uint32_t phaseUs[BOOT_PHASE_COUNT];
+
+boot_mode_t boot_mode_get(void) {
+    if (!modeKnown) {
+        bool timerWake = esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER;
+        mode = (timerWake && !DISPLAY_ON_TIMER_WAKE) ? BOOT_MODE_HEADLESS : BOOT_MODE_INTERACTIVE;
+        modeKnown = true;
+    }
+    return mode;
+}
+
+bool boot_mode_headless(void) {
+    return boot_mode_get() == BOOT_MODE_HEADLESS;
+}
+
+bool boot_mode_cold(void) {
+    // Arranque en frío: la memoria RTC no contiene datos válidos
+    return esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_UNDEFINED;
+}
+
+bool boot_mode_warm(void) {
+    if (!warmKnown) {
+        if (boot_mode_cold()) {
+            lastCycleHealthy = false;
+        }
+        warm = ENABLE_WARM_BOOT && esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER && lastCycleHealthy;
+        // Si este ciclo no llega a dormir, el siguiente arranque hará el camino completo
+        lastCycleHealthy = false;
+        warmKnown = true;
+    }
+    return warm;
+}
+
+void boot_mode_mark_healthy(void) {
+    boot_mode_warm();  // Decidir antes de marcar, por si nadie lo consultó
+    lastCycleHealthy = true;
+}
+
+void boot_mode_phase(boot_phase_t phase) {
+    boot_mode_warm();  // La primera fase decide el modo
+    if (phase == BOOT_PHASE_SETUP) {
+        // Arranque nuevo, también en caliente o de solo muestreo: las fases
+        // que no se alcancen no deben mostrar las del arranque anterior
+        memset(phaseUs, 0, sizeof(phaseUs));
+    }
+    phaseUs[phase] = (uint32_t)esp_timer_get_time();
+}
+
+void boot_mode_dump_phases(void) {
+    Serial.printf("Fases del arranque (%s):", boot_mode_warm() ? "en caliente" : "completo");
+    uint32_t prev = 0;
+    for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+        if (phaseUs[i] == 0) {
+            continue;
+        }
+        Serial.printf(" %s=%lu us (+%lu)", PHASE_NAMES[i],
+                      (unsigned long)phaseUs[i], (unsigned long)(phaseUs[i] - prev));
+        prev = phaseUs[i];
+    }
+    Serial.println();
+}
+
+bool boot_mode_mark_tx(void) {
+    if (txMarked) {
+        return false;
+    }
+    txMarked = true;
+
+    // esp_timer cuenta desde el arranque del ESP32, incluido el bootloader
+    boot_mode_phase(BOOT_PHASE_TX);
+    boot_mode_t m = boot_mode_get();
+    lastBootToTxMs[m] = phaseUs[BOOT_PHASE_TX] / 1000;
+    return true;
+}
+
+void boot_mode_report_tx(void) {
+    if (!txMarked) {
+        return;
+    }
+    boot_mode_t m = boot_mode_get();
+    uint32_t ms = lastBootToTxMs[m];
+    boot_mode_t other = (m == BOOT_MODE_HEADLESS) ? BOOT_MODE_INTERACTIVE : BOOT_MODE_HEADLESS;
+    Serial.printf("Arranque->TX: %lu ms (modo %s; último %s: %lu ms)\n",
+                  (unsigned long)ms, MODE_NAMES[m], MODE_NAMES[other],
+                  (unsigned long)lastBootToTxMs[other]);
+#if BOOT_PHASE_REPORT
+    boot_mode_dump_phases();
+#endif
+}
@@ -0,0 +1,186 @@
+/**
+ * @file      deferred_output.cpp
+ * @brief     Implementación de la cola de salida diferida
+ *
+ * Cola SPSC de huecos fijos: no reserva memoria dinámica y el coste de
+ * encolar durante TX/RX es un vsnprintf y la copia del hueco. Con
+ * ENABLE_DUAL_CORE el productor es la tarea de LMIC y el consumidor loop().
+ *
+ * Log y pantalla se descartan (y se cuentan) con la cola llena, pero dejan
+ * DEFERRED_CALL_RESERVE huecos libres: las llamadas (apagar la pantalla,
+ * guardar el envío, dormir) nunca se pierden. Si aun así no caben, con dos
+ * núcleos se espera a que loop() libere un hueco y con uno se emite lo más
+ * antiguo aunque la radio esté ocupada.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "deferred_output.h"
+#include "spsc_queue.h"
+#include <stdarg.h>
+#include <atomic>
+
+// Número de huecos, huecos solo para DEFERRED_CALL y tamaño del texto de cada uno
+#define DEFERRED_QUEUE_SIZE 16
+#define DEFERRED_CALL_RESERVE 4
+#define DEFERRED_TEXT_LEN 80
+
+// Tiempo máximo que deferred_flush() espera al otro núcleo (ms)
+#define DEFERRED_FLUSH_TIMEOUT_MS 1000
+
+typedef enum {
+    DEFERRED_LOG,
+    DEFERRED_SHOW,
+    DEFERRED_STATUS,
+    DEFERRED_CALL
+} deferred_kind_t;
+
+typedef struct {
+    uint8_t kind;        /**< deferred_kind_t */
+    uint8_t id;          /**< ScreenMessageType o StatusMessage */
+    uint32_t duration;   /**< Duración del mensaje de pantalla (ms) */
+    void (*fn)(void);    /**< Función de DEFERRED_CALL */
+    char text[DEFERRED_TEXT_LEN];
+} deferred_entry_t;
+
+static SpscQueue<deferred_entry_t, DEFERRED_QUEUE_SIZE> queue;
+static std::atomic<uint16_t> dropped{0};
+
+bool deferred_radio_busy(void) {
+    return (LMIC.opmode & OP_TXRXPEND) != 0;
+}
+
+/**
+ * @brief true si se puede emitir directamente sin pasar por la cola
+ *
+ * Con ENABLE_DUAL_CORE quien llama es la tarea de LMIC, que nunca escribe
+ * en Serial ni en la pantalla: todo pasa por la cola hacia loop().
+ */
+static bool emitNow(void) {
+#if ENABLE_DUAL_CORE
+    return false;
+#else
+    return !deferred_radio_busy() && queue.empty();
+#endif
+}
+
+static bool emitNext(void);
+
+static void push(const deferred_entry_t& e) {
+    if (!queue.push(e, DEFERRED_CALL_RESERVE)) {
+        dropped++;
+    }
+}
+
+static void pushCall(const deferred_entry_t& e) {
+    while (!queue.push(e)) {
+#if ENABLE_DUAL_CORE
+        vTaskDelay(1);  // loop() vacía la cola en el otro núcleo
+#else
+        emitNext();     // Productor y consumidor son el mismo: se libera el hueco más antiguo
+#endif
+    }
+}
+
+void deferred_log(const char* fmt, ...) {
+    deferred_entry_t e;
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(e.text, sizeof(e.text), fmt, args);
+    va_end(args);
+    if (emitNow()) {
+        Serial.println(e.text);
+        return;
+    }
+    e.kind = DEFERRED_LOG;
+    push(e);
+}
+
+void deferred_show(ScreenMessageType type, const char* text, uint32_t duration) {
+    if (emitNow()) {
+        showMessage(type, text, duration);
+        return;
+    }
+    deferred_entry_t e;
+    e.kind = DEFERRED_SHOW;
+    e.id = type;
+    e.duration = duration;
+    strlcpy(e.text, text, sizeof(e.text));
+    push(e);
+}
+
+void deferred_status(StatusMessage id, uint32_t duration) {
+    if (emitNow()) {
+        showStatus(id, duration);
+        return;
+    }
+    deferred_entry_t e;
+    e.kind = DEFERRED_STATUS;
+    e.id = id;
+    e.duration = duration;
+    push(e);
+}
+
+void deferred_call(void (*fn)(void)) {
+    if (emitNow()) {
+        fn();
+        return;
+    }
+    deferred_entry_t e;
+    e.kind = DEFERRED_CALL;
+    e.fn = fn;
+    pushCall(e);
+}
+
+/**
+ * @brief Emite lo más antiguo de la cola, sin mirar la radio
+ *
+ * @return false si la cola estaba vacía
+ */
+static bool emitNext(void) {
+    deferred_entry_t e;
+    if (!queue.pop(e)) {
+        return false;
+    }
+    switch (e.kind) {
+        case DEFERRED_LOG:
+            Serial.println(e.text);
+            break;
+        case DEFERRED_SHOW:
+            showMessage((ScreenMessageType)e.id, e.text, e.duration);
+            break;
+        case DEFERRED_STATUS:
+            showStatus((StatusMessage)e.id, e.duration);
+            break;
+        case DEFERRED_CALL:
+            e.fn();
+            break;
+    }
+    return true;
+}
+
+void deferred_drain(void) {
+    // Con un solo núcleo la radio manda (una llamada puede empezar otro envío); con dos,
+    // loop() no interfiere con LMIC
+    while ((ENABLE_DUAL_CORE || !deferred_radio_busy()) && emitNext()) {
+    }
+    if (queue.empty() && dropped > 0) {
+        Serial.printf("Salida diferida: %u mensajes descartados con la cola llena\n",
+                      (unsigned)dropped.exchange(0));
+    }
+}
+
+void deferred_flush(void) {
+#if ENABLE_DUAL_CORE
+    // El consumidor es loop(), en el otro núcleo: esperar a que vacíe la cola
+    uint32_t start = millis();
+    while (!queue.empty() && millis() - start < DEFERRED_FLUSH_TIMEOUT_MS) {
+        vTaskDelay(1);
+    }
+#else
+    deferred_drain();
+#endif
+}
@@ -0,0 +1,333 @@
+/**
+ * @file      gnss_parser.cpp
+ * @brief     Implementación del analizador incremental NMEA/UBX
+ *
+ * Máquina de estados de un byte: no depende de Arduino, así que también
+ * compila en el PC para probarla con registros grabados.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "gnss_parser.h"
+#include <string.h>
+
+typedef enum {
+    ST_IDLE = 0,
+    ST_NMEA_BODY,
+    ST_NMEA_CK1,
+    ST_NMEA_CK2,
+    ST_UBX_SYNC2,
+    ST_UBX_CLASS,
+    ST_UBX_ID,
+    ST_UBX_LEN1,
+    ST_UBX_LEN2,
+    ST_UBX_PAYLOAD,
+    ST_UBX_CKA,
+    ST_UBX_CKB
+} parser_state_t;
+
+#define UBX_SYNC1 0xB5
+#define UBX_SYNC2 0x62
+
+// Campos como máximo que se indexan de una sentencia (GGA tiene 15)
+#define NMEA_MAX_FIELDS 16
+
+static int hexValue(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+/**
+ * @brief Convierte un decimal "123.45" en entero escalado por 10^decimals
+ *
+ * Trunca los decimales sobrantes. Devuelve false si el campo está vacío o
+ * contiene algo que no sea dígitos, signo o un punto.
+ */
+static bool parseFixed(const char* s, const char* end, uint8_t decimals, int32_t* out) {
+    bool negative = false;
+    if (s < end && (*s == '-' || *s == '+')) {
+        negative = (*s == '-');
+        s++;
+    }
+    if (s >= end) {
+        return false;
+    }
+    int32_t value = 0;
+    int8_t fraction = -1;   // Decimales leídos; -1 antes del punto
+    for (; s < end; s++) {
+        if (*s == '.' && fraction < 0) {
+            fraction = 0;
+        } else if (*s >= '0' && *s <= '9') {
+            if (fraction < 0) {
+                value = value * 10 + (*s - '0');
+            } else if (fraction < decimals) {
+                value = value * 10 + (*s - '0');
+                fraction++;
+            }
+        } else {
+            return false;
+        }
+    }
+    for (int8_t i = (fraction < 0 ? 0 : fraction); i < decimals; i++) {
+        value *= 10;
+    }
+    *out = negative ? -value : value;
+    return true;
+}
+
+/**
+ * @brief Convierte "ddmm.mmmmm" (o "dddmm.mmmmm") y su hemisferio en grados * 1e7
+ */
+static bool parseCoordinate(const char* s, const char* end, char hemisphere, int32_t* out) {
+    int32_t minutes_e5;    // ddmm.mmmmm * 1e5
+    if (!parseFixed(s, end, 5, &minutes_e5) || minutes_e5 < 0) {
+        return false;
+    }
+    int32_t degrees = minutes_e5 / 10000000;
+    minutes_e5 -= degrees * 10000000;
+    // minutos * 1e5 -> grados * 1e7: * 100 / 60
+    int32_t value = degrees * 10000000 + minutes_e5 * 10 / 6;
+    *out = (hemisphere == 'S' || hemisphere == 'W') ? -value : value;
+    return true;
+}
+
+/**
+ * @brief Convierte "hhmmss.sss" en milisegundos del día
+ */
+static bool parseTime(const char* s, const char* end, uint32_t* out) {
+    int32_t hhmmss_ms;
+    if (!parseFixed(s, end, 3, &hhmmss_ms) || hhmmss_ms < 0) {
+        return false;
+    }
+    uint32_t ms = hhmmss_ms % 1000;
+    uint32_t hhmmss = hhmmss_ms / 1000;
+    *out = ((hhmmss / 10000) * 3600 + (hhmmss / 100 % 100) * 60 + hhmmss % 100) * 1000 + ms;
+    return true;
+}
+
+/**
+ * @brief Extrae la posición de una RMC o GGA y la entrega por on_fix
+ */
+static void dispatchFix(gnss_parser_t* p) {
+    const char* s = p->nmea;
+    if (p->len < 6) {
+        return;
+    }
+    char type;
+    if (memcmp(s + 2, "RMC,", 4) == 0) {
+        type = 'R';
+    } else if (memcmp(s + 2, "GGA,", 4) == 0) {
+        type = 'G';
+    } else {
+        return;
+    }
+
+    // Inicio de cada campo; el campo i termina en field[i + 1] - 1
+    const char* field[NMEA_MAX_FIELDS + 1];
+    uint8_t count = 0;
+    field[count++] = s;
+    for (const char* c = s; *c && count < NMEA_MAX_FIELDS; c++) {
+        if (*c == ',') {
+            field[count++] = c + 1;
+        }
+    }
+    field[count] = s + p->len + 1;
+#define FIELD(i) field[i], field[(i) + 1] - 1
+#define FIELD_CHAR(i) (field[(i) + 1] - 1 > field[i] ? *field[i] : '\0')
+
+    gnss_fix_t fix;
+    memset(&fix, 0, sizeof(fix));
+    fix.type = type;
+    parseTime(FIELD(1), &fix.time_ms);
+
+    int32_t value;
+    if (type == 'R') {
+        // $xxRMC,hhmmss.ss,A,llll.ll,a,yyyyy.yy,a,x.x,x.x,ddmmyy,...
+        if (count < 10) {
+            return;
+        }
+        fix.valid = FIELD_CHAR(2) == 'A';
+        if (parseFixed(FIELD(9), 0, &value)) {
+            fix.date = (uint32_t)value;
+        }
+        bool pos = parseCoordinate(FIELD(3), FIELD_CHAR(4), &fix.lat_e7) &&
+                   parseCoordinate(FIELD(5), FIELD_CHAR(6), &fix.lon_e7);
+        fix.valid = fix.valid && pos;
+    } else {
+        // $xxGGA,hhmmss.ss,llll.ll,a,yyyyy.yy,a,q,nn,h.h,alt,M,...
+        if (count < 10) {
+            return;
+        }
+        fix.valid = FIELD_CHAR(6) >= '1' && FIELD_CHAR(6) <= '9';
+        if (parseFixed(FIELD(7), 0, &value)) {
+            fix.satellites = (uint8_t)value;
+        }
+        if (parseFixed(FIELD(8), 1, &value)) {
+            fix.hdop_x10 = (uint16_t)value;
+        }
+        if (parseFixed(FIELD(9), 1, &value)) {
+            fix.alt_dm = value;
+        }
+        bool pos = parseCoordinate(FIELD(2), FIELD_CHAR(3), &fix.lat_e7) &&
+                   parseCoordinate(FIELD(4), FIELD_CHAR(5), &fix.lon_e7);
+        fix.valid = fix.valid && pos;
+    }
+#undef FIELD
+#undef FIELD_CHAR
+    p->on_fix(&fix, p->ctx);
+}
+
+void gnss_parser_init(gnss_parser_t* p, gnss_sentence_cb on_sentence, gnss_ubx_cb on_ubx,
+                      gnss_fix_cb on_fix, void* ctx) {
+    memset(p, 0, sizeof(*p));
+    p->on_sentence = on_sentence;
+    p->on_ubx = on_ubx;
+    p->on_fix = on_fix;
+    p->ctx = ctx;
+}
+
+void gnss_parser_reset(gnss_parser_t* p) {
+    p->state = ST_IDLE;
+}
+
+void gnss_parser_feed(gnss_parser_t* p, uint8_t c) {
+    switch (p->state) {
+        case ST_IDLE:
+            break;
+
+        case ST_NMEA_BODY:
+            if (c == '*') {
+                p->state = ST_NMEA_CK1;
+                return;
+            }
+            if (c >= 0x20 && c <= 0x7E && c != '$') {
+                if (p->len >= GNSS_NMEA_MAX_LEN) {
+                    p->overflows++;
+                    p->state = ST_IDLE;
+                    return;
+                }
+                p->nmea[p->len++] = (char)c;
+                p->checksum ^= c;
+                return;
+            }
+            break;  // Sentencia cortada: reprocesar el byte como inicio
+
+        case ST_NMEA_CK1: {
+            int v = hexValue(c);
+            if (v < 0) {
+                break;
+            }
+            p->checksum_b = (uint8_t)(v << 4);
+            p->state = ST_NMEA_CK2;
+            return;
+        }
+
+        case ST_NMEA_CK2: {
+            int v = hexValue(c);
+            if (v < 0) {
+                break;
+            }
+            p->state = ST_IDLE;
+            if ((p->checksum_b | v) != p->checksum) {
+                p->checksum_errors++;
+                return;
+            }
+            p->nmea[p->len] = '\0';
+            p->sentences++;
+            if (p->on_sentence) {
+                p->on_sentence(p->nmea, p->ctx);
+            }
+            if (p->on_fix) {
+                dispatchFix(p);
+            }
+            return;
+        }
+
+        case ST_UBX_SYNC2:
+            if (c == UBX_SYNC2) {
+                p->state = ST_UBX_CLASS;
+                p->checksum = 0;
+                p->checksum_b = 0;
+                return;
+            }
+            break;
+
+        default:
+            // Cabecera, payload y suma UBX: cualquier valor es válido
+            if (p->state <= ST_UBX_PAYLOAD) {
+                p->checksum += c;
+                p->checksum_b += p->checksum;
+            }
+            switch (p->state) {
+                case ST_UBX_CLASS:
+                    p->ubx_class = c;
+                    p->state = ST_UBX_ID;
+                    break;
+                case ST_UBX_ID:
+                    p->ubx_id = c;
+                    p->state = ST_UBX_LEN1;
+                    break;
+                case ST_UBX_LEN1:
+                    p->ubx_len = c;
+                    p->state = ST_UBX_LEN2;
+                    break;
+                case ST_UBX_LEN2:
+                    p->ubx_len |= (uint16_t)c << 8;
+                    p->len = 0;
+                    if (p->ubx_len > GNSS_UBX_MAX_PAYLOAD) {
+                        // No cabe, o es ruido con la cabecera UBX: sin esperar al
+                        // payload anunciado (hasta 64 KB), que taparía lo que sigue
+                        p->overflows++;
+                        p->state = ST_IDLE;
+                        break;
+                    }
+                    p->state = p->ubx_len ? ST_UBX_PAYLOAD : ST_UBX_CKA;
+                    break;
+                case ST_UBX_PAYLOAD:
+                    p->ubx[p->len] = c;
+                    if (++p->len == p->ubx_len) {
+                        p->state = ST_UBX_CKA;
+                    }
+                    break;
+                case ST_UBX_CKA:
+                    p->state = (c == p->checksum) ? ST_UBX_CKB : ST_IDLE;
+                    if (p->state == ST_IDLE) {
+                        p->checksum_errors++;
+                    }
+                    break;
+                case ST_UBX_CKB:
+                    p->state = ST_IDLE;
+                    if (c != p->checksum_b) {
+                        p->checksum_errors++;
+                    } else {
+                        p->frames++;
+                        if (p->on_ubx) {
+                            p->on_ubx(p->ubx_class, p->ubx_id, p->ubx, p->ubx_len, p->ctx);
+                        }
+                    }
+                    break;
+            }
+            return;
+    }
+
+    // Fuera de una sentencia o trama: buscar el inicio de la siguiente
+    if (c == '$') {
+        p->state = ST_NMEA_BODY;
+        p->len = 0;
+        p->checksum = 0;
+    } else if (c == UBX_SYNC1) {
+        p->state = ST_UBX_SYNC2;
+    } else {
+        p->state = ST_IDLE;
+    }
+}
+
+void gnss_parser_feed_buf(gnss_parser_t* p, const uint8_t* data, size_t len) {
+    while (len--) {
+        gnss_parser_feed(p, *data++);
+    }
+}
@@ -0,0 +1,239 @@
+/**
+ * @file      gnss_power.cpp
+ * @brief     Implementación de la gestión de energía del GNSS
+ *
+ * El raíl principal del receptor se controla directamente (LDO3 en el
+ * AXP192, ALDO3/ALDO4 en el AXP2101) y se invalida la caché de pmu_profile.
+ * Los perfiles RADIO_ONLY y DEEP_SLEEP lo apagan igualmente; VBACKUP no
+ * forma parte de ningún perfil. Antes de cortar el raíl, standbyGPS() pasa
+ * el receptor a reposo.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "gnss_power.h"
+#include "LoRaBoards.h"        // PMU, loopGPS(), setGPSFixCallback()
+#include "pmu_profile.h"
+#include "boot_mode.h"         // boot_mode_cold()
+#include <time.h>
+
+#if defined(HAS_GPS) && defined(HAS_PMU) && ENABLE_GNSS_TRACKING
+#define GNSS_POWER_ACTIVE 1
+#else
+#define GNSS_POWER_ACTIVE 0
+#endif
+
+#if GNSS_POWER_ACTIVE
+/**
+ * @brief Tipo de arranque que se espera del receptor
+ */
+typedef enum {
+    GNSS_START_COLD = 0,   /**< Sin respaldo ni posición previa */
+    GNSS_START_WARM,       /**< Respaldo mantenido, efemérides caducadas */
+    GNSS_START_HOT,        /**< Respaldo mantenido y última posición reciente */
+    GNSS_START_COUNT
+} gnss_start_t;
+
+/**
+ * @brief Estado de la búsqueda de este despertar
+ */
+typedef enum {
+    GNSS_STATE_OFF = 0,    /**< No se ha encendido (desactivado o sin receptor) */
+    GNSS_STATE_SEARCHING,  /**< Raíl encendido, sin posición todavía */
+    GNSS_STATE_FIXED,      /**< Posición obtenida, raíl apagado */
+    GNSS_STATE_TIMEOUT,    /**< Presupuesto agotado sin posición, raíl apagado */
+    GNSS_STATE_PAUSED      /**< Raíl apagado para dormir, sigue en el siguiente despertar */
+} gnss_state_t;
+
+static gnss_state_t state = GNSS_STATE_OFF;
+
+// Hora del reloj RTC en que se obtuvo la última posición válida
+RTC_DATA_ATTR static time_t lastFixTime;
+RTC_DATA_ATTR static bool lastFixValid = false;
+// El receptor conservó VBACKUP durante el último sueño profundo
+RTC_DATA_ATTR static bool backupKept = false;
+// Búsquedas seguidas que agotaron el presupuesto
+RTC_DATA_ATTR static uint8_t missedFixes = 0;
+// Búsqueda aplazada por el sueño: tipo de arranque y tiempo ya gastado
+RTC_DATA_ATTR static uint8_t carriedStart = GNSS_START_COLD;
+RTC_DATA_ATTR static uint32_t carriedMs = 0;
+
+static const char* const START_NAMES[GNSS_START_COUNT] = {
+    "frío", "templado", "caliente"
+};
+
+static const uint32_t START_BUDGET_MS[GNSS_START_COUNT] = {
+    GNSS_COLD_FIX_BUDGET_MS, GNSS_WARM_FIX_BUDGET_MS, GNSS_HOT_FIX_BUDGET_MS
+};
+
+static gnss_start_t expected = GNSS_START_COLD;
+static uint32_t searchStartMs = 0;
+static uint32_t budgetMs = 0;     // Presupuesto que queda en este despertar
+static gnss_fix_t fix;            // Posición de este despertar (solo para el log)
+
+/**
+ * @brief Enciende o apaga el raíl principal del receptor
+ *
+ * Antes de apagarlo pide al receptor que pase a reposo.
+ */
+static void setMainRail(bool on) {
+    if (!PMU) {
+        return;
+    }
+    uint8_t channel;
+    if (PMU->getChipModel() == XPOWERS_AXP192) {
+        channel = XPOWERS_LDO3;
+    } else {
+#if defined(T_BEAM_S3_SUPREME) || defined(T_BEAM_S3_BPF)
+        channel = XPOWERS_ALDO4;
+#else
+        channel = XPOWERS_ALDO3;
+#endif
+    }
+    if (on) {
+        PMU->setPowerChannelVoltage(channel, 3300);
+        PMU->enablePowerOutput(channel);
+    } else {
+        standbyGPS();
+        PMU->disablePowerOutput(channel);
+    }
+    pmu_profile_invalidate();
+}
+
+/**
+ * @brief Tipo de arranque según el respaldo y la antigüedad de la última posición
+ */
+static gnss_start_t expectedStart(void) {
+    if (!backupKept || !lastFixValid) {
+        return GNSS_START_COLD;
+    }
+    const time_t now = time(NULL);
+    const uint32_t age = now >= lastFixTime ? (uint32_t)(now - lastFixTime) : 0;
+    return age <= GNSS_HOT_START_MAX_AGE_S ? GNSS_START_HOT : GNSS_START_WARM;
+}
+
+/**
+ * @brief Apaga el raíl y deja constancia del resultado de la búsqueda
+ */
+static void endSearch(gnss_state_t result) {
+    setMainRail(false);
+    state = result;
+    const uint32_t ms = carriedMs + (millis() - searchStartMs);
+    carriedMs = 0;
+    if (result == GNSS_STATE_FIXED) {
+        missedFixes = 0;
+        Serial.printf("GNSS: posición en %lu ms (arranque %s): %ld, %ld\n", (unsigned long)ms,
+                      START_NAMES[expected], (long)fix.lat_e7, (long)fix.lon_e7);
+    } else {
+        if (missedFixes < UINT8_MAX) {
+            missedFixes++;
+        }
+        Serial.printf("GNSS: sin posición en %lu ms (arranque %s, %u fallos seguidos)\n",
+                      (unsigned long)ms, START_NAMES[expected], missedFixes);
+    }
+}
+
+/**
+ * @brief Guarda la primera posición aceptable de este despertar
+ */
+static void onFix(const gnss_fix_t* candidate, void* ctx) {
+    if (state != GNSS_STATE_SEARCHING || !candidate->valid) {
+        return;
+    }
+    if (candidate->type == 'G' && candidate->hdop_x10 > GNSS_MAX_HDOP_X10) {
+        return;
+    }
+    fix = *candidate;
+    lastFixTime = time(NULL);
+    lastFixValid = true;
+    state = GNSS_STATE_FIXED;
+}
+#endif
+
+void gnss_power_begin(void) {
+#if GNSS_POWER_ACTIVE
+    if (boot_mode_cold()) {
+        lastFixValid = false;
+        backupKept = false;
+        missedFixes = 0;
+        carriedMs = 0;
+    }
+    if (!PMU || !gpsDetected()) {
+        return;
+    }
+    if (carriedMs > 0 && backupKept) {
+        // El receptor conservó lo que llevaba: seguir con el presupuesto que queda
+        expected = (gnss_start_t)carriedStart;
+    } else {
+        expected = expectedStart();
+        carriedMs = 0;
+    }
+    budgetMs = START_BUDGET_MS[expected] - carriedMs;
+    setGPSFixCallback(onFix, NULL);
+    if (GNSS_KEEP_BACKUP_POWER && PMU->getChipModel() == XPOWERS_AXP2101) {
+        // Algunas placas lo apagan en beginPower()
+        PMU->setPowerChannelVoltage(XPOWERS_VBACKUP, 3300);
+        PMU->enablePowerOutput(XPOWERS_VBACKUP);
+    }
+    setMainRail(true);
+    searchStartMs = millis();
+    state = GNSS_STATE_SEARCHING;
+    Serial.printf("GNSS: buscando posición (arranque %s, quedan %lu de %lu ms)\n", START_NAMES[expected],
+                  (unsigned long)budgetMs, (unsigned long)START_BUDGET_MS[expected]);
+#endif
+}
+
+void gnss_power_loop(void) {
+#if GNSS_POWER_ACTIVE
+    if (state != GNSS_STATE_SEARCHING) {
+        return;
+    }
+    loopGPS();
+    if (state == GNSS_STATE_FIXED) {
+        endSearch(GNSS_STATE_FIXED);
+    } else if (millis() - searchStartMs >= budgetMs) {
+        endSearch(GNSS_STATE_TIMEOUT);
+    }
+#endif
+}
+
+void gnss_power_finish(void) {
+#if GNSS_POWER_ACTIVE
+    if (!PMU) {
+        return;
+    }
+    // Dormir no puede esperar al presupuesto entero (hasta
+    // GNSS_COLD_FIX_BUDGET_MS): como mucho un tramo corto
+    const uint32_t waitStartMs = millis();
+    for (;;) {
+        gnss_power_loop();
+        if (state != GNSS_STATE_SEARCHING || millis() - waitStartMs >= GNSS_FINISH_SLICE_MS) {
+            break;
+        }
+        delay(10);
+    }
+    if (state == GNSS_STATE_SEARCHING) {
+        // gnss_power_loop() acaba de comprobar que queda presupuesto
+        carriedMs += millis() - searchStartMs;
+        carriedStart = expected;
+        setMainRail(false);
+        state = GNSS_STATE_PAUSED;
+        Serial.printf("GNSS: búsqueda aplazada al siguiente despertar (arranque %s, %lu ms gastados)\n",
+                      START_NAMES[expected], (unsigned long)carriedMs);
+    }
+    // El siguiente despertar solo puede arrancar en caliente si el receptor
+    // conserva su respaldo durante el sueño (en el AXP192 es una pila propia)
+    backupKept = gnss_power_keep_backup() || PMU->getChipModel() == XPOWERS_AXP192;
+#endif
+}
+
+bool gnss_power_keep_backup(void) {
+#if GNSS_POWER_ACTIVE
+    return GNSS_KEEP_BACKUP_POWER;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,432 @@
+/**
+ * @file      gps_detect.cpp
+ * @brief     Detección del receptor GPS por su UART y receptor guardado en NVS
+ *
+ * Separado de LoRaBoards.cpp para poder probarlo en el PC con una UART
+ * simulada (test/test_gps_detect).
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "LoRaBoards.h"
+
+#ifdef HAS_GPS
+#include <Preferences.h>
+#include "gnss_parser.h"
+
+static bool find_gps = false;
+static const char *gps_model = "None";
+
+// Receptor detectado, guardado en NVS para confirmarlo con una sola prueba
+#define GPS_NVS_NAMESPACE "gps"
+#define GPS_CONFIRM_TIMEOUT_MS 1000
+#define GPS_CONFIRM_ATTEMPTS 2      // El receptor puede no haber terminado de arrancar
+#define GPS_ACK_TIMEOUT_MS 800
+enum {
+    GPS_MODEL_NONE = 0,
+    GPS_MODEL_L76K,
+    GPS_MODEL_UBLOX
+};
+static uint8_t gps_model_id = GPS_MODEL_NONE;
+
+// Configuración que se envía al L76K tras detectarlo: GPS + GLONASS, solo
+// RMC y GGA, modo vehículo (SoftRF activa Aviation < 2g) y guardar en su flash
+static const char *const L76K_CONFIG[] = {
+    "$PCAS04,5*1C\r\n",
+    "$PCAS03,1,0,0,0,1,0,0,0,0,0,,,0,0*02\r\n",
+    "$PCAS11,3*1E\r\n",
+    "$PCAS00*01\r\n",
+};
+
+// UBX-CFG-CFG: borrar y recargar la configuración por defecto
+static const uint8_t UBX_CFG_CLEAR1[] = {0xB5, 0x62, 0x06, 0x09, 0x0D, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x1C, 0xA2};
+static const uint8_t UBX_CFG_CLEAR2[] = {0xB5, 0x62, 0x06, 0x09, 0x0D, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x1B, 0xA1};
+static const uint8_t UBX_CFG_CLEAR3[] = {0xB5, 0x62, 0x06, 0x09, 0x0D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x03, 0x1D, 0xB3};
+// UBX-CFG-RATE, Size 8, 'Navigation/measurement rate settings' (sondeo)
+static const uint8_t UBX_CFG_RATE[] = {0xB5, 0x62, 0x06, 0x08, 0x00, 0x00, 0x0E, 0x30};
+
+// Reposo antes de cortar el raíl principal. L76K: $PCAS12, standby durante
+// el máximo (65535 s). UBlox: UBX-RXM-PMREQ, backup sin duración (flags = 2)
+static const char L76K_STANDBY[] = "$PCAS12,65535*1E\r\n";
+static const uint8_t UBX_RXM_PMREQ_BACKUP[] = {0xB5, 0x62, 0x02, 0x41, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x4D, 0x3B};
+
+// Analizador de la UART del GPS y respuesta que se está esperando
+static gnss_parser_t gpsParser;
+static struct {
+    const char *sentence;   // Prefijo de la sentencia NMEA esperada (sin '$')
+    uint8_t ubxClass;       // Trama UBX esperada
+    uint8_t ubxId;
+    volatile bool seen;
+} gpsExpect;
+static gnss_fix_cb gpsFixCallback = NULL;
+static void *gpsFixContext = NULL;
+
+static void onGpsSentence(const char *sentence, void *ctx)
+{
+    if (gpsExpect.sentence && strncmp(sentence, gpsExpect.sentence, strlen(gpsExpect.sentence)) == 0) {
+        gpsExpect.seen = true;
+    }
+}
+
+static void onGpsUbx(uint8_t cls, uint8_t id, const uint8_t *payload, uint16_t len, void *ctx)
+{
+    if (!gpsExpect.sentence && cls == gpsExpect.ubxClass && id == gpsExpect.ubxId) {
+        gpsExpect.seen = true;
+    }
+}
+
+static void onGpsFix(const gnss_fix_t *fix, void *ctx)
+{
+    if (gpsFixCallback) {
+        gpsFixCallback(fix, gpsFixContext);
+    }
+}
+
+/**
+ * @brief Pasa al analizador lo que haya en el buffer de la UART del GPS.
+ *        Las posiciones se entregan al callback de setGPSFixCallback().
+ */
+void loopGPS()
+{
+    static bool ready = false;
+    if (!ready) {
+        gnss_parser_init(&gpsParser, onGpsSentence, onGpsUbx, onGpsFix, NULL);
+        ready = true;
+    }
+    uint8_t chunk[64];
+    int avail;
+    while ((avail = SerialGPS.available()) > 0) {
+        size_t n = SerialGPS.read(chunk, avail < (int)sizeof(chunk) ? avail : sizeof(chunk));
+        gnss_parser_feed_buf(&gpsParser, chunk, n);
+    }
+}
+
+/**
+ * @brief Indica si setupBoards() encontró un receptor GPS.
+ */
+bool gpsDetected()
+{
+    return find_gps;
+}
+
+/**
+ * @brief Registra la función que recibe cada posición RMC/GGA del GPS.
+ */
+void setGPSFixCallback(gnss_fix_cb cb, void *ctx)
+{
+    gpsFixContext = ctx;
+    gpsFixCallback = cb;
+}
+
+/**
+ * @brief Pasa el receptor a reposo antes de cortar su raíl principal.
+ *        Con la alimentación de respaldo conserva hora y efemérides.
+ */
+void standbyGPS()
+{
+    if (gps_model_id == GPS_MODEL_L76K) {
+        SerialGPS.write(L76K_STANDBY);
+    } else if (gps_model_id == GPS_MODEL_UBLOX) {
+        SerialGPS.write(UBX_RXM_PMREQ_BACKUP, sizeof(UBX_RXM_PMREQ_BACKUP));
+    } else {
+        return;
+    }
+    SerialGPS.flush();  // Que el comando salga entero antes de cortar el raíl
+}
+
+/**
+ * @brief Procesa la UART del GPS hasta ver la respuesta esperada o agotar el tiempo.
+ *        Entre lecturas cede la CPU 1 ms en lugar de esperar activamente.
+ */
+static bool waitGPSResponse(uint32_t timeout_ms)
+{
+    uint32_t start = millis();
+    for (;;) {
+        loopGPS();
+        if (gpsExpect.seen) {
+            return true;
+        }
+        if (millis() - start >= timeout_ms) {
+            return false;
+        }
+        delay(1);
+    }
+}
+
+/**
+ * @brief Espera una sentencia NMEA que empiece por el prefijo dado (sin '$').
+ */
+static bool waitNmea(const char *prefix, uint32_t timeout_ms)
+{
+    gpsExpect.sentence = prefix;
+    gpsExpect.seen = false;
+    bool found = waitGPSResponse(timeout_ms);
+    gpsExpect.sentence = NULL;
+    return found;
+}
+
+/**
+ * @brief Espera una trama UBX (p. ej. ACK-ACK 0x05/0x01) con suma correcta.
+ */
+static bool waitUbx(uint8_t requestedClass, uint8_t requestedID, uint32_t timeout_ms)
+{
+    gpsExpect.sentence = NULL;
+    gpsExpect.ubxClass = requestedClass;
+    gpsExpect.ubxId = requestedID;
+    gpsExpect.seen = false;
+    return waitGPSResponse(timeout_ms);
+}
+
+/**
+ * @brief Prueba la conexión con el módulo GPS L76K.
+ *        Envía comandos para detener NMEA y configurar el módulo.
+ *
+ * @return true si el módulo responde correctamente, false en caso contrario.
+ */
+bool l76kProbe()
+{
+    bool result = false;
+    uint32_t startTimeout ;
+    SerialGPS.write("$PCAS03,0,0,0,0,0,0,0,0,0,0,,,0,0*02\r\n");
+    delay(5);
+    // Get version information
+    startTimeout = millis() + 3000;
+    Serial.print("Try to init L76K . Wait stop .");
+    // SerialGPS.flush();
+    while (SerialGPS.available()) {
+        int c = SerialGPS.read();
+        // Serial.write(c);
+        // Serial.print(".");
+        // Serial.flush();
+        // SerialGPS.flush();
+        if (millis() > startTimeout) {
+            Serial.println("Wait L76K stop NMEA timeout!");
+            return false;
+        }
+    };
+    Serial.println();
+    SerialGPS.flush();
+    delay(200);
+
+    loopGPS();
+    gnss_parser_reset(&gpsParser);
+    SerialGPS.write("$PCAS06,0*1B\r\n");
+    if (!waitNmea("GPTXT,01,01,02", 500)) {
+        Serial.println("Get L76K timeout!");
+        return false;
+    }
+    Serial.println("L76K GNSS init succeeded, using L76K GNSS Module\n");
+    result = true;
+    delay(500);
+
+    // Initialize the L76K Chip (ver L76K_CONFIG)
+    for (size_t i = 0; i < sizeof(L76K_CONFIG) / sizeof(L76K_CONFIG[0]); i++) {
+        if (i > 0) {
+            delay(250);
+        }
+        SerialGPS.write(L76K_CONFIG[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief Inicializa el módulo GPS.
+ *        Intenta inicializar L76K hasta 3 veces.
+ *
+ * @return true si la inicialización es exitosa, false en caso contrario.
+ */
+bool beginGPS()
+{
+    SerialGPS.begin(GPS_BAUD_RATE, SERIAL_8N1, GPS_RX_PIN, GPS_TX_PIN);
+    bool result = false;
+    for ( int i = 0; i < 3; ++i) {
+        result = l76kProbe();
+        if (result) {
+            return result;
+        }
+    }
+    return result;
+}
+
+
+
+/**
+ * @brief Recupera la configuración del módulo GPS UBX.
+ *        Envía comandos para restaurar configuración por defecto y configurar tasa de navegación.
+ *
+ * @return true si la recuperación es exitosa, false en caso contrario.
+ */
+bool recoveryGPS()
+{
+    // Tras cambiar de baudios lo que hubiera a medias no vale
+    loopGPS();
+    gnss_parser_reset(&gpsParser);
+
+    SerialGPS.write(UBX_CFG_CLEAR1, sizeof(UBX_CFG_CLEAR1));
+    if (waitUbx(0x05, 0x01, GPS_ACK_TIMEOUT_MS)) {
+        Serial.println("Get ack successes!");
+    }
+    SerialGPS.write(UBX_CFG_CLEAR2, sizeof(UBX_CFG_CLEAR2));
+    if (waitUbx(0x05, 0x01, GPS_ACK_TIMEOUT_MS)) {
+        Serial.println("Get ack successes!");
+    }
+    SerialGPS.write(UBX_CFG_CLEAR3, sizeof(UBX_CFG_CLEAR3));
+    if (waitUbx(0x05, 0x01, GPS_ACK_TIMEOUT_MS)) {
+        Serial.println("Get ack successes!");
+    }
+    SerialGPS.write(UBX_CFG_RATE, sizeof(UBX_CFG_RATE));
+    if (waitUbx(0x06, 0x08, GPS_ACK_TIMEOUT_MS)) {
+        Serial.println("Get ack successes!");
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Suma de comprobación (FNV-1a) de la configuración que se envía al GPS
+ *
+ * Si cambian los comandos de L76K_CONFIG o de recoveryGPS(), el receptor
+ * guardado en NVS deja de valer y se repite la detección completa.
+ */
+static uint32_t gpsConfigChecksum()
+{
+    uint32_t h = 2166136261u;
+    auto add = [&h](const uint8_t *p, size_t n) {
+        while (n--) {
+            h = (h ^ *p++) * 16777619u;
+        }
+    };
+    for (size_t i = 0; i < sizeof(L76K_CONFIG) / sizeof(L76K_CONFIG[0]); i++) {
+        add((const uint8_t *)L76K_CONFIG[i], strlen(L76K_CONFIG[i]));
+    }
+    add(UBX_CFG_CLEAR1, sizeof(UBX_CFG_CLEAR1));
+    add(UBX_CFG_CLEAR2, sizeof(UBX_CFG_CLEAR2));
+    add(UBX_CFG_CLEAR3, sizeof(UBX_CFG_CLEAR3));
+    add(UBX_CFG_RATE, sizeof(UBX_CFG_RATE));
+    return h;
+}
+
+/**
+ * @brief Guarda en NVS el receptor detectado (GPS_MODEL_NONE lo borra)
+ */
+static void gpsSaveDetected(uint8_t model, uint32_t baud)
+{
+    Preferences prefs;
+    if (!prefs.begin(GPS_NVS_NAMESPACE, false)) {
+        return;
+    }
+    if (model == GPS_MODEL_NONE) {
+        prefs.clear();
+    } else {
+        prefs.putUChar("model", model);
+        prefs.putULong("baud", baud);
+        prefs.putULong("config", gpsConfigChecksum());
+    }
+    prefs.end();
+}
+
+/**
+ * @brief Confirma el receptor guardado en NVS con una sola prueba
+ *
+ * L76K: pide la versión ($PCAS06) y espera la respuesta $GPTXT. La
+ * configuración ya quedó guardada en su flash con $PCAS00.
+ * UBlox: sondea UBX-CFG-RATE y espera la respuesta.
+ *
+ * Si no responde se repite la prueba (GPS_CONFIRM_ATTEMPTS) antes de
+ * borrar el receptor guardado: tras encenderlo puede tardar en arrancar.
+ *
+ * @return true si el receptor responde; false si no hay receptor guardado,
+ *         la configuración cambió o no responde (hay que detectarlo de nuevo).
+ */
+bool beginCachedGPS()
+{
+    Preferences prefs;
+    if (!prefs.begin(GPS_NVS_NAMESPACE, true)) {
+        return false;  // Sin detección previa
+    }
+    uint8_t model = prefs.getUChar("model", GPS_MODEL_NONE);
+    uint32_t baud = prefs.getULong("baud", 0);
+    uint32_t config = prefs.getULong("config", 0);
+    prefs.end();
+
+    if (model == GPS_MODEL_NONE || baud == 0 || config != gpsConfigChecksum()) {
+        return false;
+    }
+
+    SerialGPS.updateBaudRate(baud);
+    loopGPS();
+    gnss_parser_reset(&gpsParser);
+    bool found = false;
+    for (int attempt = 0; attempt < GPS_CONFIRM_ATTEMPTS && !found; attempt++) {
+        if (model == GPS_MODEL_L76K) {
+            SerialGPS.write("$PCAS06,0*1B\r\n");
+            found = waitNmea("GPTXT,01,01,02", GPS_CONFIRM_TIMEOUT_MS);
+        } else {
+            SerialGPS.write(UBX_CFG_RATE, sizeof(UBX_CFG_RATE));
+            found = waitUbx(0x06, 0x08, GPS_CONFIRM_TIMEOUT_MS);
+        }
+    }
+
+    if (!found) {
+        // Solo tras el reintento: borrar obliga al barrido completo en los siguientes arranques
+        Serial.println("GPS: el receptor guardado no responde, detección completa");
+        gpsSaveDetected(GPS_MODEL_NONE, 0);
+        SerialGPS.updateBaudRate(GPS_BAUD_RATE);
+        return false;
+    }
+    gps_model = (model == GPS_MODEL_L76K) ? "L76K" : "UBlox";
+    gps_model_id = model;
+    Serial.printf("GPS: %s confirmado a %lu baudios (guardado en NVS)\n",
+                  gps_model, (unsigned long)baud);
+    return true;
+}
+
+/**
+ * @brief Busca el receptor GPS: primero el guardado en NVS y, si no
+ *        responde, L76K y UBlox a todas las velocidades.
+ *
+ * @return true si se encontró un receptor (ver gpsDetected())
+ */
+bool detectGPS()
+{
+    uint32_t gpsStart = millis();
+
+    // Receptor de un arranque anterior: una prueba (y un reintento) en lugar del barrido
+    find_gps = beginCachedGPS();
+
+    if (!find_gps) {
+#if defined(T_BEAM_S3_SUPREME) || defined(T_BEAM_1W) || defined(T_BEAM_S3_BPF)
+        // T-Beam v1.2 skips L76K
+        find_gps = beginGPS();
+#endif
+        uint32_t baudrate[] = {9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600, 4800};
+        if (!find_gps) {
+            // Restore factory settings
+            for ( int i = 0; i < sizeof(baudrate) / sizeof(baudrate[0]); ++i) {
+                Serial.printf("Update baudrate : %u\n", baudrate[i]);
+                SerialGPS.updateBaudRate(baudrate[i]);
+                if (recoveryGPS()) {
+                    Serial.println("UBlox GNSS init succeeded, using UBlox GNSS Module\n");
+                    gps_model = "UBlox";
+                    gps_model_id = GPS_MODEL_UBLOX;
+                    find_gps = true;
+                    gpsSaveDetected(GPS_MODEL_UBLOX, baudrate[i]);
+                    break;
+                }
+            }
+        } else {
+            gps_model = "L76K";
+            gps_model_id = GPS_MODEL_L76K;
+            gpsSaveDetected(GPS_MODEL_L76K, GPS_BAUD_RATE);
+        }
+    }
+    Serial.printf("GPS: %s en %lu ms\n", find_gps ? gps_model : "no encontrado",
+                  (unsigned long)(millis() - gpsStart));
+    return find_gps;
+}
+
+#endif // HAS_GPS
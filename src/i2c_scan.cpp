@@ -0,0 +1,139 @@
+/**
+ * @file      i2c_scan.cpp
+ * @brief     Escaneo de los buses I2C con inventario en memoria RTC
+ *
+ * Separado de LoRaBoards.cpp para poder probarlo en el PC con un bus
+ * simulado (test/test_i2c_scan).
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "LoRaBoards.h"
+#include "boot_mode.h"
+#include <Wire.h>
+
+// Inventario I2C: direcciones que respondieron en el último escaneo completo,
+// un bit por dirección y bus (0 = Wire, 1 = Wire1). Se conserva en deep sleep
+// para que los despertares solo comprueben esas direcciones.
+#define I2C_INVENTORY_MAGIC 0x12C1A7EDu
+#define I2C_INVENTORY_BUSES 2
+RTC_DATA_ATTR static uint32_t i2cInventoryMagic;
+RTC_DATA_ATTR static uint8_t i2cInventoryValid;     // Bit n: inventario del bus n completo
+RTC_DATA_ATTR static uint32_t i2cInventory[I2C_INVENTORY_BUSES][4];
+
+/**
+ * @brief Marca en deviceOnline el dispositivo conocido en la dirección dada
+ */
+static void reportDevice(uint8_t addr)
+{
+    switch (addr) {
+    case 0x34:
+        Serial.println("\tFind AXP192/AXP2101 PMU!");
+        deviceOnline |= POWERMANAGE_ONLINE;
+        break;
+    case 0x3C:
+        Serial.println("\tFind SSD1306/SH1106 dispaly!");
+        deviceOnline |= DISPLAY_ONLINE;
+        break;
+    case 0x51:
+        Serial.println("\tFind PCF8563 RTC!");
+        deviceOnline |= PCF8563_ONLINE;
+        break;
+    case 0x1C:
+        Serial.println("\tFind QMC6310 MAG Sensor!");
+        deviceOnline |= QMC6310_ONLINE;
+        break;
+    default:
+        Serial.print("\tI2C device found at address 0x");
+        if (addr < 16) {
+            Serial.print("0");
+        }
+        Serial.print(addr, HEX);
+        Serial.println(" !");
+        break;
+    }
+}
+
+/**
+ * @brief Comprueba solo las direcciones del inventario guardado, sin esperas
+ *
+ * @return false si alguna ya no responde (hay que escanear el bus completo)
+ */
+static bool probeInventory(TwoWire *w, const uint32_t *inventory)
+{
+    for (uint8_t addr = 1; addr < 127; addr++) {
+        if (!(inventory[addr >> 5] & (1UL << (addr & 31)))) {
+            continue;
+        }
+        w->beginTransmission(addr);
+        if (w->endTransmission() != 0) {
+            Serial.printf("I2C: 0x%02X no responde, escaneo completo\n", addr);
+            return false;
+        }
+        reportDevice(addr);
+    }
+    return true;
+}
+
+/**
+ * @brief Escanea dispositivos I2C en el bus especificado.
+ *        Intenta comunicarse con direcciones I2C del 0x01 al 0x7F
+ *        e identifica dispositivos conocidos como sensores o displays.
+ *
+ *        En un arranque en caliente (boot_mode_warm()) solo se comprueban
+ *        las direcciones encontradas en el último escaneo completo
+ *        (inventario en memoria RTC), sin la espera por dirección. Si alguna
+ *        no responde, o en un arranque completo, se escanea el bus entero y
+ *        se renueva el inventario.
+ *
+ * @param w Puntero al objeto TwoWire (bus I2C) a escanear.
+ */
+void scanDevices(TwoWire *w)
+{
+    uint8_t err, addr;
+    int nDevices = 0;
+    uint8_t bus = (w == &Wire1) ? 1 : 0;
+    uint32_t *inventory = i2cInventory[bus];
+
+    if (boot_mode_warm() && i2cInventoryMagic == I2C_INVENTORY_MAGIC && (i2cInventoryValid & _BV(bus))) {
+        uint32_t deviceOnlineBefore = deviceOnline;
+        Serial.println("I2C Devices (inventario)");
+        if (probeInventory(w, inventory)) {
+            Serial.println("Scan devices done.");
+            return;
+        }
+        deviceOnline = deviceOnlineBefore;
+    }
+
+    if (i2cInventoryMagic != I2C_INVENTORY_MAGIC) {
+        i2cInventoryMagic = I2C_INVENTORY_MAGIC;
+        i2cInventoryValid = 0;
+    }
+    memset(inventory, 0, sizeof(i2cInventory[bus]));
+
+    Serial.println("I2C Devices scanning");
+    for (addr = 1; addr < 127; addr++) {
+        w->beginTransmission(addr); delay(2);
+        err = w->endTransmission();
+        if (err == 0) {
+            nDevices++;
+            inventory[addr >> 5] |= 1UL << (addr & 31);
+            reportDevice(addr);
+        } else if (err == 4) {
+            Serial.print("Unknow error at address 0x");
+            if (addr < 16) {
+                Serial.print("0");
+            }
+            Serial.println(addr, HEX);
+        }
+    }
+    i2cInventoryValid |= _BV(bus);
+    if (nDevices == 0)
+        Serial.println("No I2C devices found\n");
+
+    Serial.println("Scan devices done.");
+    Serial.println("\n");
+}
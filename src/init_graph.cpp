@@ -0,0 +1,157 @@
+/**
+ * @file      init_graph.cpp
+ * @brief     Implementación del arranque por grafo de dependencias
+ *
+ * Cada nodo es una tarea que espera en un grupo de eventos a que terminen
+ * sus dependencias. La tarea que llama vigila los tiempos máximos: un nodo
+ * caducado se marca como terminado sin éxito para liberar a los que
+ * dependen de él, que al ver que falta su bit de éxito no se ejecutan. Los
+ * nodos ordenados con after y la propia init_graph_run() esperan al bit
+ * que pone la tarea al acabar, que un nodo caducado pone más tarde.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "init_graph.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/event_groups.h>
+#include <esp_timer.h>
+
+#define INIT_GRAPH_STACK_SIZE 4096
+#define INIT_GRAPH_POLL_MS 10
+
+// Bits del grupo de eventos (24 en FreeRTOS): terminado (bien, mal o
+// caducado), terminado bien y tarea acabada
+#define FINISHED_BIT(n) (1u << (n))
+#define OK_BIT(n) (1u << ((n) + INIT_GRAPH_MAX_NODES))
+#define DONE_BIT(n) (1u << ((n) + 2 * INIT_GRAPH_MAX_NODES))
+
+typedef struct {
+    const init_node_t* node;
+    uint8_t index;
+    volatile bool ran;          // Se ejecutó run() (sus dependencias terminaron bien)
+    volatile bool ok;
+    volatile int64_t startUs;   // 0 mientras espera a sus dependencias
+    volatile int64_t endUs;
+} node_state_t;
+
+// Se reutiliza en cada init_graph_run()
+static EventGroupHandle_t group = NULL;
+static node_state_t states[INIT_GRAPH_MAX_NODES];
+
+/**
+ * @brief Ejecuta un nodo si todas sus dependencias terminaron bien
+ *
+ * @param st    Estado del nodo
+ * @param depOk Dependencias que terminaron bien
+ */
+static void runNode(node_state_t* st, uint8_t depOk) {
+    const init_node_t* node = st->node;
+    st->startUs = esp_timer_get_time();
+    st->ran = (depOk & node->deps) == node->deps;
+    st->ok = st->ran && node->run();
+    st->endUs = esp_timer_get_time();
+}
+
+#if ENABLE_PARALLEL_INIT
+/**
+ * @brief Tarea de un nodo: espera a sus dependencias, se ejecuta y avisa
+ */
+static void nodeTask(void* arg) {
+    node_state_t* st = (node_state_t*)arg;
+    uint8_t depOk = 0;
+    const EventBits_t wait = st->node->deps | ((EventBits_t)st->node->after << (2 * INIT_GRAPH_MAX_NODES));
+    if (wait) {
+        EventBits_t bits = xEventGroupWaitBits(group, wait, pdFALSE, pdTRUE, portMAX_DELAY);
+        depOk = (uint8_t)(bits >> INIT_GRAPH_MAX_NODES);
+    }
+    runNode(st, depOk);
+    xEventGroupSetBits(group, FINISHED_BIT(st->index) | DONE_BIT(st->index) |
+                              (st->ok ? OK_BIT(st->index) : 0));
+    vTaskDelete(NULL);
+}
+#endif
+
+uint8_t init_graph_run(const init_node_t* nodes, uint8_t count) {
+    if (count > INIT_GRAPH_MAX_NODES) {
+        count = INIT_GRAPH_MAX_NODES;
+    }
+    const int64_t t0 = esp_timer_get_time();
+    uint8_t okMask = 0;
+    uint8_t timedOut = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        states[i] = { &nodes[i], i, false, false, 0, 0 };
+    }
+
+#if ENABLE_PARALLEL_INIT
+    if (group == NULL) {
+        group = xEventGroupCreate();
+    }
+    const EventBits_t all = (EventBits_t)((1u << count) - 1);
+    const EventBits_t allDone = all << (2 * INIT_GRAPH_MAX_NODES);
+    xEventGroupClearBits(group, all | (all << INIT_GRAPH_MAX_NODES) | allDone);
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (xTaskCreatePinnedToCore(nodeTask, nodes[i].name, INIT_GRAPH_STACK_SIZE, &states[i],
+                                    uxTaskPriorityGet(NULL), NULL, nodes[i].core) != pdPASS) {
+            Serial.printf("Arranque: no se pudo crear la tarea de %s\n", nodes[i].name);
+            xEventGroupSetBits(group, FINISHED_BIT(i) | DONE_BIT(i));
+        }
+    }
+
+    // Hasta que acaben todas las tareas: una caducada aún puede estar usando su periférico
+    EventBits_t bits;
+    while (((bits = xEventGroupWaitBits(group, allDone, pdFALSE, pdTRUE,
+                                        pdMS_TO_TICKS(INIT_GRAPH_POLL_MS))) & allDone) != allDone) {
+        const int64_t now = esp_timer_get_time();
+        for (uint8_t i = 0; i < count; i++) {
+            const int64_t start = states[i].startUs;
+            if ((bits & FINISHED_BIT(i)) || start == 0 ||
+                now - start <= (int64_t)nodes[i].timeout_ms * 1000) {
+                continue;
+            }
+            Serial.printf("Arranque: %s supera %u ms, se da por fallido\n",
+                          nodes[i].name, nodes[i].timeout_ms);
+            timedOut |= INIT_DEP(i);
+            xEventGroupSetBits(group, FINISHED_BIT(i));
+        }
+    }
+    // Solo los nodos de este grafo: el grupo conserva los bits de una ejecución anterior más larga
+    okMask = (uint8_t)((bits >> INIT_GRAPH_MAX_NODES) & all) & ~timedOut;
+#else
+    for (uint8_t i = 0; i < count; i++) {
+        runNode(&states[i], okMask);
+        if (states[i].ok) {
+            okMask |= INIT_DEP(i);
+        }
+    }
+#endif
+
+    // Informe: duración de cada nodo, total y suma de los pasos
+    const uint32_t totalMs = (uint32_t)((esp_timer_get_time() - t0) / 1000);
+    uint32_t sumMs = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        const node_state_t* st = &states[i];
+        const char* result;
+        uint32_t ms = 0;
+        if (timedOut & INIT_DEP(i)) {
+            result = "caducado";
+            ms = (uint32_t)((st->endUs - st->startUs) / 1000);
+        } else if (!st->ran) {
+            result = "omitido";
+        } else {
+            result = st->ok ? "ok" : "fallo";
+            ms = (uint32_t)((st->endUs - st->startUs) / 1000);
+        }
+        sumMs += ms;
+        Serial.printf("  %-10s %-8s %lu ms\n", nodes[i].name, result, (unsigned long)ms);
+    }
+    Serial.printf("Arranque: %lu ms en total, %lu ms sumando los pasos\n",
+                  (unsigned long)totalMs, (unsigned long)sumMs);
+    return okMask;
+}
@@ -0,0 +1,244 @@
+/**
+ * @file      lorawan_session.cpp
+ * @brief     Implementación de la sesión LoRaWAN persistente
+ *
+ * NVS (espacio SESSION_NVS_NAMESPACE) guarda:
+ * - "session": direcciones, claves de sesión y el primer límite del contador
+ * - "fcnt":    límite actual del contador de tramas (no existe tras un join)
+ * - "nonce":   límite del devNonce
+ *
+ * Al guardar una sesión nueva se escribe primero "session" y después se
+ * borra "fcnt": un corte entre ambas deja un límite mayor que el de la
+ * sesión, que solo hace saltar el contador.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "lorawan_session.h"
+#include "boot_mode.h"         // boot_mode_cold()
+#include <Preferences.h>
+#include <esp_partition.h>
+#include <rom/crc.h>
+
+// Formato de página de NVS (ESP-IDF): 126 entradas de 32 bytes por página de 4 KB
+#define NVS_PAGE_BYTES 4096
+#define NVS_ENTRIES_PER_PAGE 126
+#define SECONDS_PER_YEAR (365UL * 24UL * 3600UL)
+
+RTC_DATA_ATTR static lorawan_session_stats_t stats;
+
+#if ENABLE_SESSION_PERSISTENCE
+#define STATE_MAGIC 0x5E55104E
+
+/**
+ * @brief Sesión tal y como se guarda en NVS y en memoria RTC
+ */
+typedef struct {
+    uint16_t keysCrc;        // CRC16 de DEVEUI, APPEUI y APPKEY: otras claves, otra sesión
+    uint8_t rxDelay;         // Retardo de RX1 (s) del join accept
+    uint8_t dn2Dr;           // Tasa de RX2
+    uint32_t netid;
+    uint32_t devaddr;
+    uint8_t nwkKey[16];
+    uint8_t artKey[16];
+    uint32_t reservedUp;     // Límite del contador al establecer la sesión
+} session_t;
+
+RTC_DATA_ATTR static uint32_t stateMagic;
+RTC_DATA_ATTR static session_t session;
+RTC_DATA_ATTR static bool sessionValid;
+RTC_DATA_ATTR static uint32_t seqnoUp;
+RTC_DATA_ATTR static uint32_t seqnoDn;
+RTC_DATA_ATTR static uint16_t devNonce;
+RTC_DATA_ATTR static uint32_t reservedUp;      // Copia del límite guardado en NVS
+RTC_DATA_ATTR static uint16_t reservedNonce;   // Copia del límite guardado en NVS
+
+static uint16_t keysCrc(void) {
+    uint16_t crc = crc16_le(0, DEVEUI, sizeof(DEVEUI));
+    crc = crc16_le(crc, APPEUI, sizeof(APPEUI));
+    return crc16_le(crc, APPKEY, sizeof(APPKEY));
+}
+
+/**
+ * @brief Reserva en NVS los siguientes SESSION_FCNT_COMMIT_INTERVAL contadores
+ */
+static void reserveUp(void) {
+    Preferences prefs;
+    if (!prefs.begin(SESSION_NVS_NAMESPACE, false)) {
+        return;
+    }
+    if (prefs.putULong("fcnt", seqnoUp + SESSION_FCNT_COMMIT_INTERVAL)) {
+        reservedUp = seqnoUp + SESSION_FCNT_COMMIT_INTERVAL;
+        stats.nvsWrites++;
+    }
+    prefs.end();
+}
+
+/**
+ * @brief Reserva en NVS los siguientes SESSION_NONCE_COMMIT_INTERVAL devNonce
+ */
+static void reserveNonce(void) {
+    Preferences prefs;
+    if (!prefs.begin(SESSION_NVS_NAMESPACE, false)) {
+        return;
+    }
+    const uint16_t limit = devNonce + SESSION_NONCE_COMMIT_INTERVAL;
+    if (prefs.putUShort("nonce", limit)) {
+        reservedNonce = limit;
+        stats.nvsWrites++;
+    }
+    prefs.end();
+}
+
+/**
+ * @brief Reconstruye la caché RTC desde NVS (arranque en frío)
+ */
+static void load(void) {
+    memset(&stats, 0, sizeof(stats));
+    sessionValid = false;
+    seqnoUp = 0;
+    seqnoDn = 0;
+    reservedUp = 0;
+    // Sin límite guardado se parte del devNonce aleatorio de LMIC_reset()
+    devNonce = LMIC.devNonce;
+
+    Preferences prefs;
+    if (prefs.begin(SESSION_NVS_NAMESPACE, true)) {
+        if (prefs.isKey("nonce")) {
+            devNonce = prefs.getUShort("nonce", 0);
+        }
+        if (prefs.getBytes("session", &session, sizeof(session)) == sizeof(session) &&
+            session.keysCrc == keysCrc()) {
+            sessionValid = true;
+            // Los valores por debajo del límite pueden estar usados: saltar a él
+            seqnoUp = prefs.getULong("fcnt", session.reservedUp);
+        }
+        prefs.end();
+    }
+
+    reserveNonce();
+    if (sessionValid) {
+        reserveUp();
+    }
+}
+
+/**
+ * @brief Estima el desgaste de NVS con SEND_INTERVAL_SECONDS
+ *
+ * NVS escribe cada valor en una entrada nueva y rota por todas sus páginas
+ * (menos una que deja libre), así que cada página se borra una vez cada
+ * (páginas x 126) escrituras.
+ */
+static void estimateEndurance(void) {
+    const esp_partition_t* nvs = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                          ESP_PARTITION_SUBTYPE_DATA_NVS, NULL);
+    const uint32_t pages = (nvs && nvs->size > NVS_PAGE_BYTES) ? nvs->size / NVS_PAGE_BYTES - 1 : 1;
+    stats.writesPerYear = SECONDS_PER_YEAR / SEND_INTERVAL_SECONDS / SESSION_FCNT_COMMIT_INTERVAL;
+    stats.eraseCyclesPerYear = (float)stats.writesPerYear / (pages * NVS_ENTRIES_PER_PAGE);
+    stats.enduranceYears = stats.eraseCyclesPerYear > 0 ? NVS_ERASE_CYCLES / stats.eraseCyclesPerYear : 0;
+}
+#endif
+
+bool lorawan_session_resume(void) {
+#if ENABLE_SESSION_PERSISTENCE
+    if (stateMagic != STATE_MAGIC || boot_mode_cold()) {
+        load();
+        stateMagic = STATE_MAGIC;
+        estimateEndurance();
+        Serial.printf("Sesión LoRaWAN: %s, contador %lu, devNonce %u\n",
+                      sessionValid ? "restaurada de NVS" : "sin sesión",
+                      (unsigned long)seqnoUp, devNonce);
+        Serial.printf("NVS: %lu escrituras/año, %.1f ciclos de borrado/año por página, "
+                      "%.0f años hasta %lu ciclos (%.0f escribiendo en cada trama)\n",
+                      (unsigned long)stats.writesPerYear, stats.eraseCyclesPerYear,
+                      stats.enduranceYears, (unsigned long)NVS_ERASE_CYCLES,
+                      stats.enduranceYears / SESSION_FCNT_COMMIT_INTERVAL);
+    }
+
+    LMIC.devNonce = devNonce;
+    if (!sessionValid) {
+        return false;
+    }
+    LMIC_setSession(session.netid, session.devaddr, session.nwkKey, session.artKey);
+    LMIC.seqnoUp = seqnoUp;
+    LMIC.seqnoDn = seqnoDn;
+    LMIC.rxDelay = session.rxDelay;
+    LMIC.dn2Dr = session.dn2Dr;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void lorawan_session_save(void) {
+#if ENABLE_SESSION_PERSISTENCE
+    session.keysCrc = keysCrc();
+    session.rxDelay = LMIC.rxDelay;
+    session.dn2Dr = LMIC.dn2Dr;
+    session.netid = LMIC.netid;
+    session.devaddr = LMIC.devaddr;
+    memcpy(session.nwkKey, LMIC.nwkKey, sizeof(session.nwkKey));
+    memcpy(session.artKey, LMIC.artKey, sizeof(session.artKey));
+    seqnoUp = LMIC.seqnoUp;
+    seqnoDn = LMIC.seqnoDn;
+    devNonce = LMIC.devNonce;
+    reservedUp = seqnoUp + SESSION_FCNT_COMMIT_INTERVAL;
+    session.reservedUp = reservedUp;
+    sessionValid = true;
+
+    Preferences prefs;
+    if (!prefs.begin(SESSION_NVS_NAMESPACE, false)) {
+        return;
+    }
+    if (prefs.putBytes("session", &session, sizeof(session)) == sizeof(session)) {
+        stats.nvsWrites++;
+        prefs.remove("fcnt");
+    }
+    prefs.end();
+#endif
+}
+
+void lorawan_session_update(void) {
+#if ENABLE_SESSION_PERSISTENCE
+    if (stateMagic != STATE_MAGIC) {
+        return;
+    }
+    devNonce = LMIC.devNonce;
+    const uint16_t noncesLeft = reservedNonce - devNonce;
+    if (noncesLeft == 0 || noncesLeft > SESSION_NONCE_COMMIT_INTERVAL) {
+        reserveNonce();
+    }
+    if (!sessionValid) {
+        return;
+    }
+    seqnoUp = LMIC.seqnoUp;
+    seqnoDn = LMIC.seqnoDn;
+    session.dn2Dr = LMIC.dn2Dr;  // Puede cambiarlo el servidor (RXParamSetupReq)
+    if (seqnoUp >= reservedUp && !(LMIC.opmode & OP_TXRXPEND)) {
+        // Tras EV_TXCOMPLETE: una escritura en NVS con la trama en el aire
+        // detiene la caché de la flash y puede retrasar RX1/RX2. La trama
+        // en curso usó reservedUp - 1 como mucho, y LMIC no construye la
+        // siguiente hasta quedar libre
+        reserveUp();
+    }
+#endif
+}
+
+void lorawan_session_forget(void) {
+#if ENABLE_SESSION_PERSISTENCE
+    sessionValid = false;
+    Preferences prefs;
+    if (prefs.begin(SESSION_NVS_NAMESPACE, false)) {
+        prefs.remove("session");
+        prefs.remove("fcnt");
+        prefs.end();
+    }
+#endif
+}
+
+void lorawan_session_get_stats(lorawan_session_stats_t* out) {
+    *out = stats;
+}
@@ -28,34 +28,101 @@
 #include "loramac.h"      // Funciones LoRaWAN y sensor
 #include "LoRaBoards.h"   // Configuración de hardware y pines
 #include "screen.h"       // Gestión de pantalla
+#include "boot_mode.h"    // Política de arranque según la causa del despertar
+#include "deferred_output.h" // Salida diferida mientras la radio está ocupada
+#include "init_graph.h"   // Arranque de periféricos en paralelo
+#include "pmu_profile.h"  // Perfiles de alimentación del PMU
+#include "gnss_power.h"   // GNSS con arranque en caliente (ENABLE_GNSS_TRACKING)
+#include "sd_logger.h"    // Registro de lecturas en la SD (ENABLE_SD_LOGGER)
+#include "store_forward.h" // Cola en flash de lecturas no enviadas (ENABLE_STORE_FORWARD)
 #include "ttn_decoder_generator.h"  // Generador de decoders TTN
 #include <esp_task_wdt.h> // Watchdog timer para protección contra cuelgues
 
+// Nodos del arranque en paralelo. La radio solo usa SPI y va en el núcleo de
+// LMIC; pantalla y sensores comparten I2C y se ordenan en el núcleo 1 (los
+// sensores se inicializan aunque la pantalla falle).
+enum {
+    INIT_NODE_RADIO = 0,
+    INIT_NODE_DISPLAY,
+    INIT_NODE_SENSORS,
+    INIT_NODE_COUNT
+};
+
+static bool initRadio()
+{
+    setupLMIC();    // Inicializa LMIC y restaura la sesión o inicia el join
+    return true;
+}
+
+static uint32_t splashStartMs = 0;
+
+static bool initScreen()
+{
+    // Inicializar sistema de pantalla (no en despertares por temporizador)
+    if (!boot_mode_headless()) {
+        if (initDisplay()) {
+            splashStartMs = millis();
+        }
+    }
+    return true;
+}
+
+static const init_node_t INIT_NODES[INIT_NODE_COUNT] = {
+    { "radio",    initRadio,    0, 0,                            2000, LMIC_CORE },
+    { "pantalla", initScreen,   0, 0,                            500,  1 },
+    { "sensores", setupSensors, 0, INIT_DEP(INIT_NODE_DISPLAY),  2000, 1 },
+};
+
 /**
  * @brief     Función de configuración inicial de Arduino
  *
  * Inicializa el hardware de la placa, espera un retraso para estabilización
- * y configura la comunicación LoRaWAN.
+ * (salvo en arranques en caliente, ver boot_mode.h) y arranca radio,
+ * pantalla y sensores en paralelo (ver init_graph.h).
  * También configura el Watchdog Timer para protección contra cuelgues.
  */
 void setup()
 {
+    boot_mode_phase(BOOT_PHASE_SETUP);
     setupBoards(false);  // Configura pines y periféricos, mantiene display activo para gestión
+    boot_mode_phase(BOOT_PHASE_BOARDS);
+    sd_logger_begin();   // Antes del muestreo: también registra las muestras de la ventana
+    store_forward_begin(); // Recorre la partición solo en arranques en frío
+    sampleStatsWindow(); // Despertares de solo muestreo vuelven a dormir aquí (ENABLE_WINDOWED_STATS)
     // Retraso necesario para estabilización de alimentación al encender
-    delay(1500);
+    if (!boot_mode_warm()) {
+        delay(1500);
+    }
     Serial.println("Proyecto de Sensor LoRaWAN de Bajo Consumo Iniciando...");
-    setupLMIC();    // Inicializa LMIC y sensor DHT22
 
-    // Generar e imprimir decoder TTN si está habilitado
-    generate_and_print_ttn_decoder();
+    // Durante join y envío solo se necesita la radio: GNSS apagado
+    pmu_profile_apply(PMU_PROFILE_RADIO_ONLY);
+    // Con ENABLE_GNSS_TRACKING el GNSS busca posición en segundo plano desde loop()
+    gnss_power_begin();
+
+    uint8_t initOk = init_graph_run(INIT_NODES, INIT_NODE_COUNT);
+    boot_mode_phase(BOOT_PHASE_LMIC);
+
+    // La pantalla de inicio se ve mientras arrancan radio y sensores; solo se espera lo que falte
+    if (splashStartMs != 0 && (initOk & INIT_DEP(INIT_NODE_DISPLAY))) {
+        uint32_t shownMs = millis() - splashStartMs;
+        if (shownMs < MESSAGE_DURATION_SPLASH) {
+            delay(MESSAGE_DURATION_SPLASH - shownMs);
+        }
+        showInfo("Sistema Iniciado", 3000);
+    }
+
+    // Generar e imprimir decoder TTN si está habilitado (ya impreso en el arranque completo)
+    if (!boot_mode_warm()) {
+        generate_and_print_ttn_decoder();
+    }
 
     // Inicializar watchdog timer (WATCHDOG_TIMEOUT_MINUTES minutos)
     esp_task_wdt_init(WATCHDOG_TIMEOUT_MINUTES * 60, true); // Timeout en segundos, panic on timeout
     esp_task_wdt_add(NULL);       // Agregar tarea actual al WDT
 
-    // Inicializar sistema de pantalla
-    initDisplay();
-    showInfo("Sistema Iniciado", 3000);
+    startLMICTask();  // Con ENABLE_DUAL_CORE, LMIC pasa a su propio núcleo
+    boot_mode_phase(BOOT_PHASE_READY);
 }
 
 /**
@@ -68,7 +135,11 @@ void setup()
 void loop()
 {
     loopLMIC();     // Procesa eventos LoRaWAN y gestiona el ciclo de bajo consumo
-    updateDisplay(); // Gestiona la pantalla y mensajes
+    gnss_power_loop(); // Posición GNSS hasta obtenerla o agotar el presupuesto
+    // Con un solo núcleo, la pantalla nunca durante TX/RX; con dos no interfiere con LMIC
+    if (ENABLE_DUAL_CORE || !deferred_radio_busy()) {
+        updateDisplay(); // Gestiona la pantalla y mensajes
+    }
     esp_task_wdt_reset(); // Alimentar watchdog para indicar actividad
 }
 
@@ -38,6 +38,17 @@
 #include <esp_task_wdt.h>   // Watchdog timer
 #include "../config/config.h"         // Configuración unificada del proyecto
 #include "sensor_interface.h" // Interfaz de sensores
+#include "windowed_stats.h"   // Estadísticas por ventana
+#include "send_scheduler.h"   // Intervalo de envío adaptativo
+#include "pmu_profile.h"      // Perfiles de alimentación del PMU
+#include "pmu_status.h"       // Estado del PMU leído una vez por ciclo
+#include "gnss_power.h"       // Búsqueda GNSS con arranque en caliente
+#include "sd_logger.h"        // Registro de lecturas en la SD
+#include "store_forward.h"    // Cola en flash de lecturas no enviadas
+#include "lorawan_session.h"  // Sesión y contadores persistentes
+#include "boot_mode.h"        // Política de arranque y medida arranque->TX
+#include "deferred_output.h"  // Log y pantalla diferidos durante TX/RX
+#include "spsc_queue.h"       // Cola entre núcleos (ENABLE_DUAL_CORE)
 
 // Declaración forward
 void turnOffDisplay();
@@ -47,6 +58,8 @@ void turnOffDisplay();
 
 // Prototipos de funciones privadas
 void enterDeepSleep();
+void do_send(osjob_t *j);
+static void storeUplink(void);
 
 // ==================== CONFIGURACIÓN LoRaWAN ====================
 // Las claves de activación OTAA ahora están incluidas desde config.h
@@ -78,7 +91,6 @@ static osjob_t sendjob;
 static int spreadFactor = DR_SF7;
 static int joinStatus = EV_JOINING;
 static const unsigned TX_INTERVAL = 30;  // No usado en bajo consumo, pero mantener para compatibilidad
-#define SLEEP_TIME_SECONDS SEND_INTERVAL_SECONDS  // Periodo entre transmisiones
 #define uS_TO_S_FACTOR 1000000ULL
 static String lora_msg = "";
 
@@ -86,6 +98,24 @@ static String lora_msg = "";
 static int joinFailCount = 0;  // Contador de joins fallidos consecutivos
 static bool inJoinBackoff = false;  // Si estamos en período de backoff
 
+// Backoff largo de join: loop() duerme y la tarea de LMIC no toca la radio
+// hasta que vuelve; entonces es ella quien reinicia LMIC y el join
+typedef enum {
+    JOIN_BACKOFF_NONE,      // LMIC funciona con normalidad
+    JOIN_BACKOFF_SLEEPING,  // loop() está en sueño ligero
+    JOIN_BACKOFF_RESTART    // Sueño terminado: reiniciar el join
+} join_backoff_state_t;
+static volatile join_backoff_state_t joinBackoffState = JOIN_BACKOFF_NONE;
+static int joinBackoffSeconds = 0;
+
+// Reenvío de la cola en flash en este despertar
+static uint8_t drainBatches = 0;     // Lotes enviados
+static bool drainInFlight = false;   // El envío en curso es un lote de la cola
+
+// Tiempo en sueño ligero en este despertar: millis() sigue contando durante
+// esp_light_sleep_start(), pero ese tiempo no consume corriente de despierto
+static uint32_t lightSleepMs = 0;
+
 /**
  * @brief Determina el tiempo de backoff basado en el número de fallos consecutivos
  *
@@ -109,6 +139,7 @@ static int getJoinBackoffTime(int failCount) {
  *
  * Duerme por el tiempo especificado pero mantiene la RAM y el estado del programa.
  * Se usa para backoffs largos de join LoRaWAN sin perder el contador de intentos.
+ * Se ejecuta en el contexto de loop(), así que escribe en Serial directamente.
  *
  * @param seconds Tiempo en segundos para dormir
  */
@@ -118,23 +149,71 @@ static void enterLightSleep(int seconds) {
     // Apagar pantalla para ahorrar energía durante el sueño
     turnOffDisplay();
 
-    // Configurar despertar por temporizador
-    esp_sleep_enable_timer_wakeup((uint64_t)seconds * uS_TO_S_FACTOR);
+    // Dormir en tramos de SEND_INTERVAL_SECONDS: al final de cada tramo se
+    // toma la lectura que tocaba y se guarda en la cola en flash
+    while (seconds > 0) {
+        const int chunk = (ENABLE_STORE_FORWARD && seconds > SEND_INTERVAL_SECONDS) ? SEND_INTERVAL_SECONDS : seconds;
+
+        // Configurar despertar por temporizador
+        esp_sleep_enable_timer_wakeup((uint64_t)chunk * uS_TO_S_FACTOR);
 
-    // Entrar en sueño ligero (mantiene estado de RAM)
-    esp_light_sleep_start();
+        // Entrar en sueño ligero (mantiene estado de RAM)
+        const uint32_t sleptFrom = millis();
+        esp_light_sleep_start();
+        lightSleepMs += millis() - sleptFrom;
+        esp_task_wdt_reset();
+        pmu_status_invalidate();  // La RAM se conserva: la lectura de este tramo es nueva
+
+        seconds -= chunk;
+        if (seconds > 0) {
+            storeUplink();
+        }
+    }
 
     // Al despertar, volver a encender la pantalla si es necesario
     Serial.println("Despertando de sueño ligero");
 }
 
+/**
+ * @brief Backoff largo de join en el contexto de loop() vía deferred_call()
+ *
+ * Al terminar deja el reinicio del join a la tarea de LMIC.
+ */
+static void joinBackoffSleep(void) {
+    delay(1000);  // Pequeño delay para mostrar mensaje
+    enterLightSleep(joinBackoffSeconds);
+    joinBackoffState = JOIN_BACKOFF_RESTART;
+}
+
+/**
+ * @brief Coordina el bucle de LMIC con el backoff largo de join (contexto de LMIC)
+ *
+ * Tras el sueño ligero reinicia LMIC y vuelve a intentar el join.
+ *
+ * @return false mientras loop() duerme: no ejecutar LMIC en esta vuelta
+ */
+static bool lmicMayRun(void) {
+    if (joinBackoffState == JOIN_BACKOFF_SLEEPING) {
+        return false;
+    }
+    if (joinBackoffState == JOIN_BACKOFF_RESTART) {
+        joinBackoffState = JOIN_BACKOFF_NONE;
+        deferred_log("Reiniciando LMIC después de backoff");
+        LMIC_reset();
+        lorawan_session_resume();  // Sin sesión: solo recupera el devNonce
+        LMIC_startJoining();
+        os_setTimedCallback(&sendjob, os_getTime() + sec2osticks(5), do_send);
+    }
+    return true;
+}
+
 /**
  * @brief Reinicia el contador de joins fallidos
  */
 static void resetJoinFailCount() {
     joinFailCount = 0;
     inJoinBackoff = false;
-    Serial.println("Contador de joins fallidos reseteado");
+    deferred_log("Contador de joins fallidos reseteado");
 }
 
 // Funciones callback de LMIC
@@ -156,6 +235,228 @@ void os_getDevKey (u1_t *buf)
 
 // ==================== FUNCIONES DE CALLBACK Y UTILIDAD ====================
 
+// Tamaño máximo del payload de un envío
+#define UPLINK_MAX_BYTES (STATS_PAYLOAD_SIZE_BYTES > 8 ? STATS_PAYLOAD_SIZE_BYTES : 8)
+
+/**
+ * @brief Envío preparado: payload y valores para el log
+ */
+typedef struct {
+    uint8_t size;                       /**< Bytes de payload, 0 si no se pudo obtener */
+    uint8_t payload[UPLINK_MAX_BYTES];
+    bool sensorOk;
+    float temperature;
+    float humidity;
+    float battery;
+} uplink_msg_t;
+
+#if ENABLE_DUAL_CORE
+// Envíos preparados por loop() para la tarea de LMIC (solo hay uno en curso)
+static SpscQueue<uplink_msg_t, 2> uplinkQueue;
+#endif
+
+// Último envío puesto en cola, por si el enlace resulta estar caído
+static uplink_msg_t lastUplink;
+
+#if !ENABLE_WINDOWED_STATS
+/**
+ * @brief     Lee los sensores una vez y copia la lectura al registro en SD
+ *
+ * @param data Lectura para el payload y la pantalla
+ * @return    true si algún sensor respondió
+ */
+static bool readSensors(sensor_data_t* data)
+{
+    bool sensorOk = sensors_read_all(data);
+    if (!sensorOk) {
+        sensors_retry_init_all();  // Si no hay datos válidos, intentar reinicializar
+    }
+    sd_logger_append(data);  // Solo copia a memoria RTC; se escribe al dormir
+    return sensorOk;
+}
+#endif
+
+/**
+ * @brief     Lee los sensores, construye el payload y lo muestra en pantalla
+ *
+ * Con ENABLE_DUAL_CORE se ejecuta en el núcleo de loop(), fuera de LMIC.
+ *
+ * @param msg Envío a rellenar
+ */
+static void acquireUplink(uplink_msg_t* msg)
+{
+    // ==================== OBTENER PAYLOAD COMPLETO ====================
+    payload_config_t payload_config = {
+        .buffer = msg->payload,
+        .max_size = sizeof(msg->payload),
+        .written = 0
+    };
+    sensor_data_t sensorData;
+#if ENABLE_WINDOWED_STATS
+    // La muestra de este despertar ya se añadió en sampleStatsWindow()
+    msg->size = stats_window_get_payload(&payload_config);
+#else
+    // Una sola lectura para el payload, la pantalla y la SD
+    bool sensorOk = readSensors(&sensorData);
+    msg->size = sensors_build_payload(&sensorData, &payload_config);
+#endif
+
+    if (msg->size == 0) {
+        Serial.println("Error al obtener payload del sensor");
+        showError("Error payload", 3000);
+        return;
+    }
+
+    // ==================== OBTENER DATOS PARA DISPLAY ====================
+#if ENABLE_WINDOWED_STATS
+    // Mostrar la media de la ventana en lugar de volver a leer los sensores
+    sensorData.temperature = stats_window_temperature()->count ? stats_window_temperature()->mean : SENSOR_ERROR_TEMPERATURE;
+    sensorData.humidity = stats_window_humidity()->count ? stats_window_humidity()->mean : SENSOR_ERROR_HUMIDITY;
+    sensorData.pressure = stats_window_pressure()->count ? stats_window_pressure()->mean : SENSOR_ERROR_PRESSURE;
+    sensorData.distance = stats_window_distance()->count ? stats_window_distance()->mean : SENSOR_ERROR_DISTANCE;
+    sensorData.battery = stats_window_battery()->count ? stats_window_battery()->min : 0.0f;
+    bool sensorOk = stats_window_temperature()->count > 0 || stats_window_humidity()->count > 0 ||
+                    stats_window_pressure()->count > 0 || stats_window_distance()->count > 0;
+#endif
+    msg->sensorOk = sensorOk;
+    msg->temperature = sensorData.temperature;
+    msg->humidity = sensorData.humidity;
+    msg->battery = sensorData.battery;
+
+    // ==================== INTERFAZ DE USUARIO ====================
+    // Mostrar datos en pantalla OLED durante el envío (sin límite de tiempo)
+    if (sensorOk) {
+        showSensorData(msg->temperature, msg->humidity, msg->battery, 0);  // 0 = mostrar hasta que llegue otro mensaje
+    } else {
+        // Mostrar solo batería cuando no hay sensor
+        showWarning("Solo bateria", 0);  // 0 = mostrar hasta que llegue otro mensaje
+    }
+}
+
+/**
+ * @brief     Pone en cola el envío preparado (contexto de LMIC)
+ *
+ * @param msg Envío preparado por acquireUplink()
+ */
+static void submitUplink(const uplink_msg_t* msg)
+{
+    if (msg->size == 0) {
+        // Programar siguiente intento en 10 segundos
+        os_setTimedCallback(&sendjob, os_getTime() + sec2osticks(10), do_send);
+        return;
+    }
+
+    // ==================== ENVÍO LoRaWAN ====================
+    if (boot_mode_mark_tx()) {
+        deferred_call(boot_mode_report_tx);  // Serial solo desde loop()
+    }
+    LMIC_setTxData2(1, (xref2u1_t)msg->payload, msg->size, 0);
+
+    lastUplink = *msg;
+
+    // La transmisión ya ha empezado: el log se emite al cerrar las ventanas RX
+    if (msg->sensorOk) {
+        deferred_log("Enviando: Temp=%.2f C, Hum=%.2f %%, Batt=%.2f V",
+                     msg->temperature, msg->humidity, msg->battery);
+    } else {
+        deferred_log("Enviando datos limitados: Temp=ERROR, Hum=ERROR, Batt=%.2f V", msg->battery);
+    }
+}
+
+#if ENABLE_DUAL_CORE
+/**
+ * @brief     Prepara el envío en loop() y lo pasa a la tarea de LMIC
+ */
+static void requestUplink(void)
+{
+    uplink_msg_t msg;
+    acquireUplink(&msg);
+    uplinkQueue.push(msg);
+}
+#endif
+
+/**
+ * @brief     Lee los sensores y guarda el payload en la cola en flash y la lectura en la SD
+ *
+ * Para lecturas que no pueden enviarse (join fallido o en backoff). No toca
+ * la pantalla. Se ejecuta en el contexto de loop() vía deferred_call().
+ */
+static void storeUplink(void)
+{
+    uint8_t payload[UPLINK_MAX_BYTES];
+    payload_config_t payload_config = {
+        .buffer = payload,
+        .max_size = sizeof(payload),
+        .written = 0
+    };
+#if ENABLE_WINDOWED_STATS
+    uint8_t size = stats_window_get_payload(&payload_config);
+#else
+    // La lectura que no puede salir también queda en la SD
+    sensor_data_t sensorData;
+    readSensors(&sensorData);
+    uint8_t size = sensors_build_payload(&sensorData, &payload_config);
+#endif
+    if (size && store_forward_push(payload, size)) {
+        Serial.printf("Lectura guardada en la cola (%lu pendientes)\n", (unsigned long)store_forward_pending());
+    }
+}
+
+/**
+ * @brief     Envía un lote de la cola en flash (contexto de LMIC)
+ *
+ * Los registros solo salen de la cola en EV_TXCOMPLETE, así que un corte
+ * durante el envío hace que el lote se repita en el siguiente despertar.
+ */
+static void do_drain(osjob_t *j)
+{
+    uint8_t batch[STORE_FORWARD_BATCH_BYTES];
+    uint8_t count;
+    const uint8_t size = store_forward_build_batch(batch, sizeof(batch), &count);
+    if (size == 0 || (LMIC.opmode & OP_TXRXPEND)) {
+        deferred_call(enterDeepSleep);
+        return;
+    }
+    drainInFlight = true;
+    drainBatches++;
+    LMIC_setTxData2(STORE_FORWARD_FPORT, batch, size, STORE_FORWARD_CONFIRMED);
+    deferred_log("Reenviando %u lecturas guardadas (%u bytes, lote %u)", count, size, drainBatches);
+}
+
+/**
+ * @brief     Programa el siguiente lote de la cola si el ciclo de trabajo lo permite
+ *
+ * LMIC retrasa cada envío hasta que la banda queda libre; si la espera supera
+ * STORE_FORWARD_MAX_WAIT_S es más barato dormir y seguir en el siguiente despertar.
+ *
+ * @return    true si se programó un lote (no hay que dormir todavía)
+ */
+static bool scheduleDrain(void)
+{
+    if (store_forward_pending() == 0 || drainBatches >= STORE_FORWARD_MAX_BATCHES) {
+        return false;
+    }
+    const ostime_t now = os_getTime();
+    ostime_t avail = LMIC.globalDutyAvail;
+#if defined(CFG_eu868)
+    // Todos los canales de datos están en BAND_CENTI (ver setupLMIC())
+    if (LMIC.bands[BAND_CENTI].avail - avail > 0) {
+        avail = LMIC.bands[BAND_CENTI].avail;
+    }
+#endif
+    ostime_t wait = avail - now;
+    if (wait < 0) {
+        wait = 0;
+    }
+    if (wait > sec2osticks(STORE_FORWARD_MAX_WAIT_S)) {
+        deferred_log("Cola: %lu lecturas pendientes, la banda no queda libre hasta dentro de %lu s",
+                     (unsigned long)store_forward_pending(), (unsigned long)osticks2ms(wait) / 1000);
+        return false;
+    }
+    os_setTimedCallback(&sendjob, now + wait, do_drain);
+    return true;
+}
+
 /**
  * @brief     Función callback para envío de datos del sensor
  *
@@ -163,6 +464,9 @@ void os_getDevKey (u1_t *buf)
  * que incluye temperatura, humedad y voltaje de batería.
  * Envía los datos vía LoRaWAN y maneja la interfaz de usuario en pantalla.
  *
+ * Con ENABLE_DUAL_CORE la lectura de sensores y la pantalla se piden a
+ * loop() y el envío lo pone en cola la tarea de LMIC al recibir el payload.
+ *
  * Formato de datos (6 bytes):
  * - Bytes 0-1: Temperatura (°C * 100, int16 big-endian)
  * - Bytes 2-3: Humedad (% * 100, uint16 big-endian)
@@ -180,13 +484,13 @@ void do_send(osjob_t *j)
     
     // Verificar si estamos en período de backoff de join
     if (inJoinBackoff) {
-        Serial.println(F("En período de backoff de join, esperando..."));
+        deferred_log("En período de backoff de join, esperando...");
         return;
     }
 
     // Verificar estado de join
     if (joinStatus == EV_JOINING) {
-        Serial.println(F("Aún no unido a la red"));
+        deferred_log("Aún no unido a la red");
         // Reprogramar envío para más tarde
         os_setTimedCallback(&sendjob, os_getTime() + sec2osticks(TX_INTERVAL), do_send);
         return;
@@ -194,60 +498,19 @@ void do_send(osjob_t *j)
 
     // Verificar si hay una transmisión/recepción pendiente
     if (LMIC.opmode & OP_TXRXPEND) {
-        Serial.println(F("Transmisión pendiente, esperando..."));
+        deferred_log("Transmisión pendiente, esperando...");
         return;
     }
 
-    Serial.println(F("Preparando datos del sensor para envío..."));
+    deferred_log("Preparando datos del sensor para envío...");
 
-    // ==================== OBTENER PAYLOAD COMPLETO ====================
-    uint8_t payload[8];  // Buffer para el payload
-    payload_config_t payload_config = {
-        .buffer = payload,
-        .max_size = sizeof(payload),
-        .written = 0
-    };
-    uint8_t payloadSize = sensors_get_payload(&payload_config);
-
-    if (payloadSize == 0) {
-        Serial.println("Error al obtener payload del sensor");
-        showError("Error payload", 3000);
-        // Programar siguiente intento en 10 segundos
-        os_setTimedCallback(&sendjob, os_getTime() + sec2osticks(10), do_send);
-        return;
-    }
-
-    // ==================== OBTENER DATOS PARA DISPLAY ====================
-    sensor_data_t sensorData;
-    bool sensorOk = sensors_read_all(&sensorData);
-    float temperatura = sensorData.temperature;
-    float humedad = sensorData.humidity;
-    float presion = sensorData.pressure;
-    float bateria = sensorData.battery;
-
-    // ==================== INTERFAZ DE USUARIO ====================
-    // Mostrar datos en pantalla OLED durante el envío (sin límite de tiempo)
-    if (sensorOk) {
-        showSensorData(temperatura, humedad, bateria, 0);  // 0 = mostrar hasta que llegue otro mensaje
-    } else {
-        // Mostrar solo batería cuando no hay sensor
-        showWarning("Solo bateria", 0);  // 0 = mostrar hasta que llegue otro mensaje
-    }
-
-    // ==================== ENVÍO LoRaWAN ====================
-    LMIC_setTxData2(1, payload, payloadSize, 0);
-
-    if (sensorOk) {
-        #ifdef USE_SENSOR_DHT22
-        Serial.printf("Enviando: Temp=%.2f C, Hum=%.2f %%, Batt=%.2f V\n",
-                     temperatura, humedad, bateria);
-        #else
-        Serial.printf("Enviando: Temp=%.2f C, Hum=%.2f %%, Batt=%.2f V\n",
-                     temperatura, humedad, bateria);
-        #endif
-    } else {
-        Serial.printf("Enviando datos limitados: Temp=ERROR, Hum=ERROR, Batt=%.2f V\n", bateria);
-    }
+#if ENABLE_DUAL_CORE
+    deferred_call(requestUplink);
+#else
+    uplink_msg_t msg;
+    acquireUplink(&msg);
+    submitUplink(&msg);
+#endif
 
     // Nota: No se programa el siguiente envío aquí - se hará después del TX completo en onEvent
 }
@@ -269,16 +532,17 @@ void onEvent (ev_t ev)
     // Resetear watchdog para evitar reinicio durante operaciones LoRaWAN
     esp_task_wdt_reset();
     
-    Serial.print(os_getTime());
-    Serial.print(": ");
+    // Los eventos pueden llegar con la radio ocupada: log y pantalla van por la
+    // cola diferida para no retrasar el sondeo de LMIC ni las ventanas RX
+    const unsigned long now = os_getTime();
 
     switch (ev) {
         case EV_TXCOMPLETE:
-            Serial.println(F("Transmisión completada (incluyendo RX windows)"));
+            deferred_log("%lu: Transmisión completada (incluyendo RX windows)", now);
 
             // Verificar si se recibió ACK
             if (LMIC.txrxFlags & TXRX_ACK) {
-                Serial.println(F("ACK recibido de gateway"));
+                deferred_log("ACK recibido de gateway");
                 lora_msg = "ACK recibido.";
             }
 
@@ -287,32 +551,47 @@ void onEvent (ev_t ev)
 
             // Verificar datos downlink
             if (LMIC.dataLen) {
-                Serial.print(F("Datos recibidos: "));
-                Serial.print(LMIC.dataLen);
-                Serial.println(F(" bytes"));
+                deferred_log("Datos recibidos: %u bytes", LMIC.dataLen);
                 // Aquí se podrían procesar comandos downlink
             }
 
             // Feedback visual de éxito
-            showSuccess("Datos enviados!", 5000);
+            deferred_status(STATUS_DATA_SENT, 5000);
+
+            // ==================== REENVÍO DE LA COLA EN FLASH ====================
+            if (drainInFlight) {
+                drainInFlight = false;
+                if (!STORE_FORWARD_CONFIRMED || (LMIC.txrxFlags & TXRX_ACK)) {
+                    store_forward_commit();
+                } else {
+                    // Sin ACK el lote sigue en la cola; no insistir en este despertar
+                    deferred_log("Lote sin ACK, se reintentará en el siguiente despertar");
+                    drainBatches = STORE_FORWARD_MAX_BATCHES;
+                }
+            }
+            // El enlace funciona: aprovechar para vaciar la cola antes de dormir
+            if (scheduleDrain()) {
+                break;
+            }
 
             // ==================== TRANSICIÓN A SUEÑO PROFUNDO ====================
-            enterDeepSleep();
+            // Después de emitir lo pendiente, en el contexto de la pantalla
+            deferred_call(enterDeepSleep);
             break;
 
         case EV_JOINING:
-            Serial.println(F("Iniciando proceso de join..."));
+            deferred_log("%lu: Iniciando proceso de join...", now);
             lora_msg = "Uniéndose OTAA....";
             joinStatus = EV_JOINING;
 
             // Mostrar estado en pantalla por 3 segundos
-            showInfo("uniendose OTAA", 3000);
+            deferred_status(STATUS_JOINING, 3000);
             break;
 
         case EV_JOIN_FAILED:
         {
             joinFailCount++;
-            Serial.printf("Join fallido #%d - aplicando backoff\n", joinFailCount);
+            deferred_log("%lu: Join fallido #%d - aplicando backoff", now, joinFailCount);
             lora_msg = "Unión OTAA fallida";
 
             int backoffSeconds = getJoinBackoffTime(joinFailCount);
@@ -321,38 +600,40 @@ void onEvent (ev_t ev)
             // Mostrar información del backoff en pantalla
             char backoffMsg[32];
             sprintf(backoffMsg, "Reintento en %d min", backoffSeconds / 60);
-            showWarning(backoffMsg, 3000);
+            deferred_show(MSG_WARNING, backoffMsg, 3000);
 
-            Serial.printf("Esperando %d segundos antes del próximo intento de join\n", backoffSeconds);
+            deferred_log("Esperando %d segundos antes del próximo intento de join", backoffSeconds);
+
+            // La lectura de este intervalo no puede salir: guardarla en la cola en flash
+            deferred_call(storeUplink);
 
             // Si es un backoff moderado, usar callback normal
             if (backoffSeconds <= 300) {
                 os_setTimedCallback(&sendjob, os_getTime() + sec2osticks(backoffSeconds), do_send);
             } else {
-                // Para backoffs largos, dormir ligero y luego reiniciar join
-                delay(1000);  // Pequeño delay para mostrar mensaje
-                enterLightSleep(backoffSeconds);
-
-                // Al despertar, reiniciar LMIC y volver a intentar join
-                Serial.println("Reiniciando LMIC después de backoff");
-                LMIC_reset();
-                LMIC_startJoining();
-                os_setTimedCallback(&sendjob, os_getTime() + sec2osticks(5), do_send);
+                // Para backoffs largos, loop() duerme ligero (como enterDeepSleep)
+                // y al despertar lmicMayRun() reinicia el join
+                joinBackoffSeconds = backoffSeconds;
+                joinBackoffState = JOIN_BACKOFF_SLEEPING;
+                deferred_call(joinBackoffSleep);
             }
             break;
         }
 
         case EV_JOINED:
-            Serial.println(F("Unión exitosa a la red LoRaWAN"));
+            deferred_log("%lu: Unión exitosa a la red LoRaWAN", now);
             lora_msg = "Unido!";
             joinStatus = EV_JOINED;
 
             // Resetear contador de fallos al conectar exitosamente
             resetJoinFailCount();
 
+            // Guardar la sesión para no repetir el join en los siguientes despertares
+            lorawan_session_save();
+
             // Mostrar mensaje de conexión exitosa durante 5 segundos
             // La pantalla se apagará automáticamente al expirar el mensaje
-            showSuccess("connected", 5000);
+            deferred_status(STATUS_CONNECTED, 5000);
 
             // Programar el primer envío con delay para dar tiempo a ver el mensaje
             os_setTimedCallback(&sendjob, os_getTime() + sec2osticks(6), do_send);
@@ -362,19 +643,25 @@ void onEvent (ev_t ev)
             break;
 
         case EV_RXCOMPLETE:
-            Serial.println(F("Recepción completada"));
+            deferred_log("%lu: Recepción completada", now);
             break;
 
         case EV_LINK_DEAD:
-            Serial.println(F("Enlace perdido"));
+            deferred_log("%lu: Enlace perdido", now);
+            // La red ya no responde a esta sesión: el siguiente arranque hará join
+            lorawan_session_forget();
+            // El último envío probablemente no llegó: guardarlo para reenviarlo
+            if (lastUplink.size && !drainInFlight) {
+                store_forward_push(lastUplink.payload, lastUplink.size);
+            }
             break;
 
         case EV_LINK_ALIVE:
-            Serial.println(F("Enlace recuperado"));
+            deferred_log("%lu: Enlace recuperado", now);
             break;
 
         default:
-            Serial.println(F("Evento desconocido"));
+            deferred_log("%lu: Evento desconocido", now);
             break;
     }
 }
@@ -382,34 +669,47 @@ void onEvent (ev_t ev)
 /**
  * @brief     Entrada en modo sueño profundo
  *
- * Configura el temporizador ESP32 para despertar después del intervalo definido
- * y apaga la pantalla para maximizar el ahorro de energía.
+ * Configura el temporizador ESP32 para despertar después del intervalo que
+ * calcula el planificador energético (send_scheduler.cpp) y apaga la pantalla para maximizar el ahorro de energía.
  * NO apaga completamente el PMU para permitir el despertar por temporizador.
  *
  * @note      El dispositivo se reiniciará completamente al despertar
  * @warning   Toda la memoria RAM se pierde durante el sueño profundo
  */
 void enterDeepSleep() {
-    Serial.println("Entrando en sueño profundo por " + String(SLEEP_TIME_SECONDS) + " segundos...");
+    // Contadores de la última trama a memoria RTC y, si tocaba, la reserva en
+    // NVS aplazada hasta EV_TXCOMPLETE (con dos núcleos la tarea de LMIC
+    // puede no haber llegado a hacerlo)
+    lorawan_session_update();
+    // Terminar la búsqueda GNSS en curso dentro de su presupuesto (raíl apagado, VBACKUP no).
+    // Antes de registrar el ciclo: puede alargarlo hasta GNSS_COLD_FIX_BUDGET_MS
+    gnss_power_finish();
+#if ENABLE_WINDOWED_STATS
+    // Resumen enviado: empezar ventana nueva y despertar en el siguiente muestreo
+    stats_window_reset();
+    const uint64_t sleepSeconds = STATS_SAMPLE_INTERVAL_SECONDS;
+#else
+    // Registrar la energía de este ciclo (sin el sueño ligero del backoff de
+    // join) y ajustar el intervalo al presupuesto
+    scheduler_record_cycle(millis() - lightSleepMs);
+    const uint64_t sleepSeconds = scheduler_next_interval_seconds();
+#endif
+    // Escribir en la SD los bloques completos del registro; el resto sigue en memoria RTC
+    sd_logger_flush();
+    // Emitir lo pendiente de la cola diferida antes de perder la RAM
+    deferred_drain();
+    Serial.println("Entrando en sueño profundo por " + String((uint32_t)sleepSeconds) + " segundos...");
     // Apagar pantalla para ahorrar energía
     turnOffDisplayCompletely();
 
     // Configurar despertar por temporizador (RTC interno del ESP32)
-    esp_sleep_enable_timer_wakeup(SLEEP_TIME_SECONDS * uS_TO_S_FACTOR);
-
-    // NO apagar PMU completamente para evitar problemas de despertar
-    // disablePeripherals();  // Comentado para permitir despertar
-
-    // Solo apagar mediciones del PMU pero mantener alimentación
-    if (PMU) {
-        PMU->setChargingLedMode(XPOWERS_CHG_LED_OFF);
-        PMU->disableSystemVoltageMeasure();
-        PMU->disableVbusVoltageMeasure();
-        PMU->disableBattVoltageMeasure();
-        PMU->disableTemperatureMeasure();
-        PMU->disableBattDetection();
-        // NO apagar las salidas de alimentación del PMU
-    }
+    esp_sleep_enable_timer_wakeup(sleepSeconds * uS_TO_S_FACTOR);
+    boot_mode_mark_healthy();  // El siguiente despertar puede arrancar en caliente
+
+    // Apagar medidas, LED, IRQ y raíles de periféricos del PMU escribiendo solo
+    // los registros que cambian. El raíl del ESP32 no forma parte del perfil,
+    // así que el despertar por temporizador no se ve afectado.
+    pmu_profile_apply(PMU_PROFILE_DEEP_SLEEP);
 
     // Entrar en sueño profundo (reinicio completo al despertar)
     esp_deep_sleep_start();
@@ -418,16 +718,61 @@ void enterDeepSleep() {
 // ==================== FUNCIONES PÚBLICAS ====================
 
 /**
- * @brief     Inicializa LMIC, sensor DHT22 y configura LoRaWAN OTAA
+ * @brief     Toma una muestra para la ventana de estadísticas
+ *
+ * Lee los sensores y acumula la lectura en la ventana guardada en memoria RTC.
+ * Si la ventana aún no está completa, vuelve a sueño profundo sin tocar la
+ * radio ni la pantalla; solo retorna cuando toca enviar el resumen.
+ *
+ * @note      Debe llamarse en setup() antes de setupLMIC()
+ */
+void sampleStatsWindow(void)
+{
+#if ENABLE_WINDOWED_STATS
+    if (esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_TIMER) {
+        // Arranque en frío o por botón: la memoria RTC no contiene una ventana válida
+        stats_window_reset();
+    }
+
+    // Muestreo sin radio: LoRa y GNSS apagados mientras se leen los sensores
+    pmu_profile_apply(PMU_PROFILE_SENSING);
+
+    sensors_init_all();
+    sensor_data_t data;
+    sensors_read_all(&data);
+    stats_window_add_sample(&data);
+    sd_logger_append(&data);
+
+    Serial.printf("Ventana de estadísticas: %u muestras\n", stats_window_sample_count());
+
+    if (stats_window_is_due()) {
+        pmu_profile_apply(PMU_PROFILE_ACTIVE);
+        return;  // Continuar con join y envío del resumen
+    }
+
+    // Despertar de solo muestreo: sin radio, directamente a dormir
+    sd_logger_flush();
+    turnOffDisplayCompletely();
+    pmu_profile_apply(PMU_PROFILE_DEEP_SLEEP);
+    esp_sleep_enable_timer_wakeup((uint64_t)STATS_SAMPLE_INTERVAL_SECONDS * uS_TO_S_FACTOR);
+    boot_mode_mark_healthy();
+    esp_deep_sleep_start();
+#endif
+}
+
+/**
+ * @brief     Inicializa LMIC y configura LoRaWAN OTAA
  *
  * Esta función configura:
  * - Pines del módulo LoRa (TCXO si aplica)
  * - Sistema operativo LMIC
- * - Sensor DHT22 con verificación de conexión
  * - Sesión LoRaWAN con claves OTAA
  * - Canales TTN para Europa (868MHz)
  * - Parámetros de enlace y tasa de datos
- * - Inicia el proceso de join
+ * - Restaura la sesión guardada o, si no la hay, inicia el proceso de join
+ *
+ * Solo usa el bus SPI de la radio: puede ejecutarse a la vez que la
+ * inicialización de la pantalla y los sensores (ver init_graph.h).
  *
  * @note      Debe llamarse una vez en setup() de Arduino
  * @warning   Asegúrate de actualizar las claves LoRaWAN antes de usar
@@ -443,20 +788,13 @@ void setupLMIC(void)
     // Inicializar el sistema operativo de LMIC
     os_init();
 
-    // ==================== CONFIGURACIÓN DEL SENSOR ====================
-    // Inicializar sensor usando la interfaz unificada
-    if (!sensors_init_all()) {
-        Serial.println("ADVERTENCIA: Sensor no disponible, el dispositivo continuará funcionando y enviará datos de error");
-        showWarning("Sensor no disponible", 5000);
-        // No entramos en bucle infinito - el dispositivo debe continuar funcionando
-    } else {
-        showInfo("Sensor OK", 3000);
-    }
-
     // ==================== CONFIGURACIÓN LoRaWAN ====================
     // Reiniciar estado MAC - descarta sesiones y transferencias pendientes
     LMIC_reset();
 
+    // Recuperar la sesión guardada (antes de los canales: LMIC_setSession() los reinicia)
+    const bool resumed = lorawan_session_resume();
+
     // Configurar tolerancia de error de reloj (1% máximo)
     LMIC_setClockError(MAX_CLOCK_ERROR * 1 / 100);
 
@@ -475,12 +813,22 @@ void setupLMIC(void)
     // Deshabilitar validación de enlace (link check) para simplificar
     LMIC_setLinkCheckMode(0);
 
-    // Configurar downlink RX2 with SF9 (estándar TTN)
-    LMIC.dn2Dr = DR_SF9;
+    // Configurar downlink RX2 with SF9 (estándar TTN); una sesión restaurada trae la suya
+    if (!resumed) {
+        LMIC.dn2Dr = DR_SF9;
+    }
 
     // Configurar spread factor y potencia de transmisión (aumentada para mejor alcance)
     LMIC_setDrTxpow(spreadFactor, TX_POWER_DBM);
 
+    if (resumed) {
+        // Sesión restaurada: enviar directamente, sin join
+        Serial.println("Sesión LoRaWAN restaurada, sin join");
+        joinStatus = EV_JOINED;
+        os_setCallback(&sendjob, do_send);
+        return;
+    }
+
     Serial.println("Iniciando proceso de join LoRaWAN...");
     // Iniciar el proceso de joining a la red
     LMIC_startJoining();
@@ -489,6 +837,30 @@ void setupLMIC(void)
     // do_send(&sendjob);
 }
 
+/**
+ * @brief     Inicializa los sensores y los enciende por adelantado
+ *
+ * Muestra en pantalla si hay sensor disponible, así que debe ejecutarse con
+ * la pantalla ya inicializada.
+ *
+ * @return    true si al menos un sensor está disponible
+ */
+bool setupSensors(void)
+{
+    // Inicializar sensor usando la interfaz unificada
+    if (!sensors_init_all()) {
+        Serial.println("ADVERTENCIA: Sensor no disponible, el dispositivo continuará funcionando y enviará datos de error");
+        showWarning("Sensor no disponible", 5000);
+        // No entramos en bucle infinito - el dispositivo debe continuar funcionando
+        return false;
+    }
+    showStatus(STATUS_SENSOR_OK, 3000);
+
+    // La estabilización del sensor transcurre durante el join
+    sensors_warm_up_all();
+    return true;
+}
+
 /**
  * @brief     Bucle principal para procesar eventos LoRaWAN
  *
@@ -499,7 +871,51 @@ void setupLMIC(void)
  */
 void loopLMIC(void)
 {
-    os_runloop_once();  // Procesar eventos LMIC pendientes
+#if !ENABLE_DUAL_CORE
+    if (lmicMayRun()) {
+        os_runloop_once();  // Procesar eventos LMIC pendientes
+        lorawan_session_update();  // Contadores a memoria RTC (y a NVS cada bloque)
+    }
+#endif
+    deferred_drain();   // Emitir log y pantalla retenidos si la radio ya está libre
+}
+
+#if ENABLE_DUAL_CORE
+/**
+ * @brief     Tarea de LMIC: bucle de eventos y sondeo de la radio
+ *
+ * Solo ejecuta LMIC y pone en cola los envíos que prepara loop(); el log,
+ * la pantalla y los sensores van por las colas al otro núcleo.
+ */
+static void lmicTask(void *arg)
+{
+    esp_task_wdt_add(NULL);
+    for (;;) {
+        if (lmicMayRun()) {
+            os_runloop_once();
+            lorawan_session_update();  // Contadores a memoria RTC (y a NVS cada bloque)
+
+            uplink_msg_t msg;
+            if (uplinkQueue.pop(msg)) {
+                submitUplink(&msg);
+            }
+        }
+
+        esp_task_wdt_reset();
+        vTaskDelay(1);  // Ceder el núcleo a la tarea inactiva (1 tick = 1 ms)
+    }
+}
+#endif
+
+/**
+ * @brief     Arranca la tarea de LMIC en LMIC_CORE (solo con ENABLE_DUAL_CORE)
+ */
+void startLMICTask(void)
+{
+#if ENABLE_DUAL_CORE
+    xTaskCreatePinnedToCore(lmicTask, "lmic", LMIC_TASK_STACK_SIZE, NULL,
+                            LMIC_TASK_PRIORITY, NULL, LMIC_CORE);
+#endif
 }
 
 // Función de utilidad para leer registro (si es necesario)
@@ -0,0 +1,244 @@
+/**
+ * @file      pmu_profile.cpp
+ * @brief     Implementación de los perfiles de alimentación del PMU
+ *
+ * Cada chip tiene una tabla de registros gestionados, ordenada por dirección.
+ * La copia cacheada se carga con lecturas en ráfaga de los tramos contiguos;
+ * las escrituras se hacen registro a registro porque el AXP192 no
+ * autoincrementa la dirección al escribir.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "pmu_profile.h"
+#include "LoRaBoards.h"        // PMU
+
+// Máximo de registros gestionados por chip (AXP192)
+#define PMU_PROFILE_MAX_REGS 9
+
+/**
+ * @brief Bits que controla cada perfil en un registro y su valor objetivo
+ *
+ * Los bits fuera de la máscara conservan el valor actual del registro.
+ * Columnas: ACTIVE, SENSING, RADIO_ONLY, DEEP_SLEEP.
+ */
+typedef struct {
+    uint8_t reg;
+    uint8_t mask[PMU_PROFILE_COUNT];
+    uint8_t value[PMU_PROFILE_COUNT];
+} pmu_register_rule_t;
+
+#ifdef HAS_PMU
+// El contador de culombios del AXP192 integra el ADC de corriente de batería
+// (bit6 de ADC_EN1): si se usa, ese ADC sigue encendido en sueño profundo o
+// la carga consumida mientras se duerme no se contaría
+#define AXP192_ADC_EN1_SLEEP (ENABLE_COULOMB_COUNTING ? 0x40 : 0x00)
+
+static const pmu_register_rule_t AXP192_RULES[] = {
+    // Raíles: bit0 DC1 (OLED), bit2 LDO2 (LoRa), bit3 LDO3 (GNSS). DC3 (ESP32) no se toca
+    {XPOWERS_AXP192_LDO23_DC123_EXT_CTL, {0x0D, 0x0C, 0x0C, 0x0D}, {0x0D, 0x00, 0x04, 0x00}},
+    // bit6 detección de batería, bits 5:3 LED de carga (0x08 = control manual, apagado)
+    {XPOWERS_AXP192_OFF_CTL,             {0x40, 0x40, 0x40, 0x78}, {0x40, 0x40, 0x40, 0x08}},
+    // Interrupciones: solo se enmascaran para dormir
+    {XPOWERS_AXP192_INTEN1,              {0x00, 0x00, 0x00, 0xFF}, {0x00, 0x00, 0x00, 0x00}},
+    {XPOWERS_AXP192_INTEN2,              {0x00, 0x00, 0x00, 0xFF}, {0x00, 0x00, 0x00, 0x00}},
+    {XPOWERS_AXP192_INTEN3,              {0x00, 0x00, 0x00, 0xFF}, {0x00, 0x00, 0x00, 0x00}},
+    {XPOWERS_AXP192_INTEN4,              {0x00, 0x00, 0x00, 0xFF}, {0x00, 0x00, 0x00, 0x00}},
+    {XPOWERS_AXP192_INTEN5,              {0x00, 0x00, 0x00, 0xFF}, {0x00, 0x00, 0x00, 0x00}},
+    // ADC: bits 7:6 V/I de batería, bits 3:2 V/I de VBUS, bit1 tensión APS
+    {XPOWERS_AXP192_ADC_EN1,             {0xCE, 0xCE, 0xCE, 0xCE}, {0xCE, 0xC0, 0xC0, AXP192_ADC_EN1_SLEEP}},
+    // ADC: bit7 temperatura interna
+    {XPOWERS_AXP192_ADC_EN2,             {0x80, 0x80, 0x80, 0x80}, {0x80, 0x00, 0x00, 0x00}},
+};
+
+static const pmu_register_rule_t AXP2101_RULES[] = {
+    // ADC: bit0 batería, bit2 VBUS, bit3 sistema, bit4 temperatura
+    {XPOWERS_AXP2101_ADC_CHANNEL_CTRL,   {0x1D, 0x1D, 0x1D, 0x1D}, {0x1D, 0x01, 0x01, 0x00}},
+    // Interrupciones: solo se enmascaran para dormir
+    {XPOWERS_AXP2101_INTEN1,             {0x00, 0x00, 0x00, 0xFF}, {0x00, 0x00, 0x00, 0x00}},
+    {XPOWERS_AXP2101_INTEN2,             {0x00, 0x00, 0x00, 0xFF}, {0x00, 0x00, 0x00, 0x00}},
+    {XPOWERS_AXP2101_INTEN3,             {0x00, 0x00, 0x00, 0xFF}, {0x00, 0x00, 0x00, 0x00}},
+    // bit0 detección de batería
+    {XPOWERS_AXP2101_BAT_DET_CTRL,       {0x01, 0x01, 0x01, 0x01}, {0x01, 0x01, 0x01, 0x00}},
+    // LED de carga: control manual apagado (0x05) al dormir
+    {XPOWERS_AXP2101_CHGLED_SET_CTRL,    {0x00, 0x00, 0x00, 0x37}, {0x00, 0x00, 0x00, 0x05}},
+    // Raíles: bit0 ALDO1, bit1 ALDO2 (LoRa), bit2 ALDO3 (GNSS), bits 5:4 BLDO1/2. DCDC1 (ESP32) no se toca
+    {XPOWERS_AXP2101_LDO_ONOFF_CTRL0,    {0x06, 0x06, 0x06, 0x37}, {0x06, 0x00, 0x02, 0x00}},
+};
+
+#define RULE_COUNT(rules) (sizeof(rules) / sizeof(rules[0]))
+
+static const char* const PROFILE_NAMES[PMU_PROFILE_COUNT] = {
+    "activo", "sensores", "solo radio", "sueño profundo"
+};
+
+// Copia de los registros gestionados, válida durante este arranque
+static uint8_t cache[PMU_PROFILE_MAX_REGS];
+static bool cacheValid = false;
+static pmu_profile_t current = PMU_PROFILE_ACTIVE;
+
+// Estado activo guardado antes de dormir, para restaurarlo al despertar
+RTC_DATA_ATTR static uint8_t saved[PMU_PROFILE_MAX_REGS];
+RTC_DATA_ATTR static bool savedValid = false;
+RTC_DATA_ATTR static uint8_t savedChip = XPOWERS_UNDEFINED;
+
+/**
+ * @brief Tabla de reglas del PMU detectado
+ */
+static const pmu_register_rule_t* rules_for_pmu(uint8_t* count) {
+    switch (PMU->getChipModel()) {
+        case XPOWERS_AXP192:
+            *count = RULE_COUNT(AXP192_RULES);
+            return AXP192_RULES;
+        case XPOWERS_AXP2101:
+            *count = RULE_COUNT(AXP2101_RULES);
+            return AXP2101_RULES;
+        default:
+            *count = 0;
+            return NULL;
+    }
+}
+
+static int reg_read(uint8_t reg, uint8_t* buf, uint8_t len) {
+    if (PMU->getChipModel() == XPOWERS_AXP192) {
+        return static_cast<XPowersAXP192*>(PMU)->readRegister(reg, buf, len);
+    }
+    return static_cast<XPowersAXP2101*>(PMU)->readRegister(reg, buf, len);
+}
+
+static int reg_write(uint8_t reg, uint8_t val) {
+    if (PMU->getChipModel() == XPOWERS_AXP192) {
+        return static_cast<XPowersAXP192*>(PMU)->writeRegister(reg, val);
+    }
+    return static_cast<XPowersAXP2101*>(PMU)->writeRegister(reg, val);
+}
+
+/**
+ * @brief Carga la caché con una lectura en ráfaga por cada tramo de direcciones contiguas
+ */
+static bool load_cache(const pmu_register_rule_t* rules, uint8_t count) {
+    uint8_t i = 0;
+    while (i < count) {
+        uint8_t run = 1;
+        while (i + run < count && rules[i + run].reg == rules[i].reg + run) {
+            run++;
+        }
+        if (reg_read(rules[i].reg, &cache[i], run) != 0) {
+            return false;
+        }
+        i += run;
+    }
+    cacheValid = true;
+    return true;
+}
+
+/**
+ * @brief Escribe los registros cuyo valor objetivo difiere de la caché
+ * @return Registros escritos, -1 si falla el I2C
+ */
+static int write_targets(const pmu_register_rule_t* rules, uint8_t count, const uint8_t* target) {
+    int written = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (target[i] == cache[i]) {
+            continue;
+        }
+        if (reg_write(rules[i].reg, target[i]) != 0) {
+            cacheValid = false;
+            return -1;
+        }
+        cache[i] = target[i];
+        written++;
+    }
+    return written;
+}
+
+/**
+ * @brief Reglas del PMU con la caché cargada, o NULL si no es posible
+ */
+static const pmu_register_rule_t* prepare(uint8_t* count) {
+    if (!PMU) {
+        return NULL;
+    }
+    const pmu_register_rule_t* rules = rules_for_pmu(count);
+    if (!rules || (!cacheValid && !load_cache(rules, *count))) {
+        return NULL;
+    }
+    return rules;
+}
+#endif
+
+int pmu_profile_apply(pmu_profile_t profile) {
+#ifdef HAS_PMU
+    uint8_t count;
+    const pmu_register_rule_t* rules = prepare(&count);
+    if (!rules || profile >= PMU_PROFILE_COUNT) {
+        return -1;
+    }
+
+    if (current == PMU_PROFILE_ACTIVE && profile != PMU_PROFILE_ACTIVE) {
+        memcpy(saved, cache, count);
+        savedChip = PMU->getChipModel();
+        savedValid = true;
+    }
+
+    uint8_t target[PMU_PROFILE_MAX_REGS];
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t mask = rules[i].mask[profile];
+        target[i] = (cache[i] & ~mask) | (rules[i].value[profile] & mask);
+    }
+
+    int written = write_targets(rules, count, target);
+    if (written >= 0) {
+        current = profile;
+        Serial.printf("PMU: perfil %s (%d registros escritos)\n", PROFILE_NAMES[profile], written);
+    }
+    return written;
+#else
+    (void)profile;
+    return -1;
+#endif
+}
+
+int pmu_profile_restore(void) {
+#ifdef HAS_PMU
+    if (!PMU) {
+        return -1;
+    }
+    if (!savedValid || savedChip != PMU->getChipModel()) {
+        // Arranque en frío: no hay estado previo que recuperar
+        return pmu_profile_apply(PMU_PROFILE_ACTIVE);
+    }
+
+    uint8_t count;
+    const pmu_register_rule_t* rules = prepare(&count);
+    if (!rules) {
+        return -1;
+    }
+
+    int written = write_targets(rules, count, saved);
+    if (written >= 0) {
+        current = PMU_PROFILE_ACTIVE;
+        Serial.printf("PMU: estado restaurado (%d registros escritos)\n", written);
+    }
+    return written;
+#else
+    return -1;
+#endif
+}
+
+void pmu_profile_invalidate(void) {
+#ifdef HAS_PMU
+    cacheValid = false;
+#endif
+}
+
+pmu_profile_t pmu_profile_current(void) {
+#ifdef HAS_PMU
+    return current;
+#else
+    return PMU_PROFILE_ACTIVE;
+#endif
+}
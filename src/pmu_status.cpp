@@ -0,0 +1,31 @@
+/**
+ * @file      pmu_status.cpp
+ * @brief     Implementación de la copia por ciclo del estado del PMU
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "pmu_status.h"
+#include "LoRaBoards.h"        // PMU
+
+// Copia del estado, válida hasta el siguiente despertar
+static XPowersStatusSnapshot_t snapshot;
+static bool snapshotValid = false;
+
+const XPowersStatusSnapshot_t* pmu_status(void) {
+#ifdef HAS_PMU
+    if (!snapshotValid && PMU) {
+        snapshotValid = PMU->getStatusSnapshot(snapshot);
+    }
+    return snapshotValid ? &snapshot : NULL;
+#else
+    return NULL;
+#endif
+}
+
+void pmu_status_invalidate(void) {
+    snapshotValid = false;
+}
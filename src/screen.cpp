@@ -12,22 +12,204 @@
 
 #include "screen.h"
 #include "LoRaBoards.h"
+#include "boot_mode.h"
+#include "status_bitmaps.h"
 #include "../config/config.h"  // Configuración del proyecto
 
 // Declaraciones forward
 void turnOffDisplay();
 void turnOffDisplayCompletely();
 
+// Longitud máxima del texto de un mensaje (sin contar el terminador)
+#define SCREEN_MESSAGE_MAX_LEN 63
+
+/**
+ * @brief Tramo de currentMessage que ocupa una línea de pantalla
+ */
+typedef struct {
+    uint8_t start;
+    uint8_t len;
+} TextLine;
+
 // Variables para controlar el estado del mensaje actual
-static String currentMessage = "";
+static char currentMessage[SCREEN_MESSAGE_MAX_LEN + 1] = "";
+static TextLine lines[SCREEN_TEXT_MAX_LINES];
+static uint8_t lineCount = 0;
+static const uint8_t* layoutFont = nullptr;  // Fuente con la que se calculó el reparto (nullptr = sin calcular)
+
+// Tipo y texto de los mensajes fijos, en el orden de StatusMessage
+static const ScreenMessageType STATUS_TYPES[STATUS_MESSAGE_COUNT] = {
+#define STATUS_MESSAGE(id, type, text) type,
+#include "status_messages.def"
+#undef STATUS_MESSAGE
+};
+
+static const char* const STATUS_TEXTS[STATUS_MESSAGE_COUNT] = {
+#define STATUS_MESSAGE(id, type, text) text,
+#include "status_messages.def"
+#undef STATUS_MESSAGE
+};
+
+static const char* const SCREEN_TYPE_LABELS[] = {SCREEN_TYPE_LABEL_STRINGS};
+
 static ScreenMessageType currentType = MSG_INFO;
+static const status_bitmap_t* currentBitmap = nullptr;  // Mensaje fijo que se está dibujando
 static uint32_t messageStartTime = 0;
 static uint32_t messageDuration = 0;
 static bool displayActive = false;
 
+/**
+ * @brief Devuelve el bus I2C compartido a su velocidad tras hablar con la pantalla
+ */
+static void releaseDisplayBus() {
+#if defined(ARDUINO_ARCH_ESP32)
+    u8x8_esp32_hw_i2c_release();
+#endif
+}
+
+#if !DISPLAY_PAGE_BUFFER
+/**
+ * @brief Envía el buffer a la pantalla
+ *
+ * Con U8G2_WITH_DIRTY_TILES solo se transfieren los tiles 8x8 modificados
+ * desde el último envío (p. ej. 8 bytes para los indicadores de actividad
+ * en lugar de 1 KB); sin la opción se envía el buffer completo.
+ */
+static void flushDisplay() {
+#ifdef U8G2_WITH_DIRTY_TILES
+    u8g2->updateDirty();
+#else
+    u8g2->sendBuffer();
+#endif
+    releaseDisplayBus();
+}
+#endif
+
+#if DISPLAY_CAPTURE
+// Medidas de los fotogramas enviados
+static ScreenStats stats;
+static uint32_t frameStart = 0;
+static u8x8_msg_cb nextByteCb = nullptr;
+
+/**
+ * @brief Cuenta los bytes que el backend envía a la pantalla y delega en él
+ */
+static uint8_t countingByteCb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    if (msg == U8X8_MSG_BYTE_SEND) {
+        stats.lastBytes += arg_int;
+    }
+    return nextByteCb(u8x8, msg, arg_int, arg_ptr);
+}
+
+/**
+ * @brief Empieza la medida de un fotograma
+ */
+static void captureBegin() {
+    // beginDisplay() puede crear la pantalla más tarde: el contador se engancha aquí
+    u8x8_t* u8x8 = u8g2->getU8x8();
+    if (u8x8->byte_cb != countingByteCb) {
+        nextByteCb = u8x8->byte_cb;
+        u8x8->byte_cb = countingByteCb;
+    }
+    stats.lastBytes = 0;
+    frameStart = micros();
+}
+
+/**
+ * @brief Cierra la medida del fotograma y lo vuelca por Serial
+ *
+ * El volcado PBM (P1, 128x64) se puede guardar desde el monitor serie y
+ * compararse con una imagen de referencia. Con buffer por páginas solo queda
+ * en RAM la última franja, así que no se vuelca.
+ */
+static void captureEnd() {
+    stats.lastMicros = micros() - frameStart;
+    stats.frames++;
+    stats.totalMicros += stats.lastMicros;
+    stats.totalBytes += stats.lastBytes;
+
+    Serial.printf("Pantalla: fotograma %lu, %lu us, %lu bytes I2C\n",
+                  (unsigned long)stats.frames, (unsigned long)stats.lastMicros,
+                  (unsigned long)stats.lastBytes);
+#if !DISPLAY_PAGE_BUFFER
+    u8g2->writeBufferPBM(Serial);
+#endif
+}
+#endif
+
+/**
+ * @brief Dibuja un fotograma completo y lo envía a la pantalla
+ *
+ * Con buffer completo se dibuja una vez y se envía con flushDisplay(). Con
+ * DISPLAY_PAGE_BUFFER la función de dibujo se repite para cada franja de
+ * 8 o 16 filas en el bucle firstPage()/nextPage(); las primitivas recortan lo
+ * que cae fuera de la franja y cada franja se envía al terminarla.
+ *
+ * @param draw Función que dibuja el contenido, nullptr para un fotograma en blanco
+ */
+static void drawFrame(void (*draw)(void)) {
+#if DISPLAY_CAPTURE
+    captureBegin();
+#endif
+#if DISPLAY_PAGE_BUFFER
+    u8g2->firstPage();
+    do {
+        if (draw) {
+            draw();
+        }
+    } while (u8g2->nextPage());
+    releaseDisplayBus();
+#else
+    u8g2->clearBuffer();
+    if (draw) {
+        draw();
+    }
+    flushDisplay();
+#endif
+#if DISPLAY_CAPTURE
+    captureEnd();
+#endif
+}
+
+/**
+ * @brief Comprueba si el mensaje puede mostrarse, encendiendo el panel si hace falta
+ *
+ * En un arranque sin pantalla (despertar por temporizador) el OLED no se ha
+ * inicializado: solo los errores lo encienden, sin pantalla de bienvenida.
+ *
+ * @param type Tipo del mensaje que se quiere mostrar
+ * @return true si la pantalla está lista para dibujar
+ */
+static bool ensureDisplay(ScreenMessageType type) {
+    if (u8g2) {
+        return true;
+    }
+    if (!boot_mode_headless() || type != MSG_ERROR) {
+        return false;
+    }
+#ifdef DISPLAY_MODEL
+    if (beginDisplay()) {
+        Serial.println("Pantalla encendida bajo demanda para mostrar un error");
+        displayActive = true;
+        return true;
+    }
+#endif
+    return false;
+}
+
+/**
+ * @brief Pantalla de bienvenida
+ */
+static void drawSplash() {
+    u8g2->drawStr(0, 20, "MediaLab LoRaWAN");
+    u8g2->drawStr(0, 40, "Bajo Consumo V.1.1");
+}
+
 /**
  * @brief Inicializa la pantalla OLED U8g2
  *
+ * Solo dibuja la pantalla de inicio; la espera la hace quien llama.
+ *
  * @return true si la inicialización es exitosa, false en caso contrario
  */
 bool initDisplay() {
@@ -43,13 +225,10 @@ bool initDisplay() {
         Serial.println("Display no disponible");
         return false;
     }
-    u8g2->begin();
-    u8g2->clearBuffer();
-    u8g2->setFont(u8g2_font_ncenB08_tr);
-    u8g2->drawStr(0, 20, "MediaLab LoRaWAN");
-    u8g2->drawStr(0, 40, "Bajo Consumo V.1.1");
-    u8g2->sendBuffer();
-    delay(2000);
+    // beginDisplay() ya envió la secuencia de inicialización; solo hay que despertar el panel
+    u8g2->setPowerSave(0);
+    u8g2->setFont(SCREEN_FONT);
+    drawFrame(drawSplash);
 
     displayActive = true;
     return true;
@@ -78,12 +257,109 @@ void updateDisplay() {
 }
 
 /**
- * @brief Renderiza un mensaje en la pantalla según su tipo
+ * @brief Reparte currentMessage en líneas según el ancho real de los glifos
  *
- * @param type Tipo de mensaje
- * @param text Texto del mensaje
+ * Recorre el texto una sola vez sumando el avance de cada glifo de la fuente
+ * activa; corta en el último espacio que cabe en el ancho de la pantalla o,
+ * si una palabra no cabe entera, en el último carácter que cabe. Las líneas
+ * se guardan como (inicio, longitud) sobre el propio buffer, sin copias.
  */
-static void renderMessage(ScreenMessageType type, const String& text) {
+static void layoutMessage(const uint8_t* font) {
+    u8g2_t* g = u8g2->getU8g2();
+    const u8g2_uint_t maxWidth = u8g2->getDisplayWidth();
+    uint8_t pos = 0;
+
+    lineCount = 0;
+    while (currentMessage[pos] != '\0' && lineCount < SCREEN_TEXT_MAX_LINES) {
+        // Los espacios al inicio de línea no se dibujan
+        while (currentMessage[pos] == ' ') {
+            pos++;
+        }
+        if (currentMessage[pos] == '\0') {
+            break;
+        }
+
+        uint8_t start = pos;
+        uint8_t end = pos;
+        uint8_t lastSpace = 0;
+        u8g2_uint_t width = 0;
+
+        while (currentMessage[end] != '\0' && currentMessage[end] != '\n') {
+            int8_t advance = u8g2_GetGlyphWidth(g, (uint8_t)currentMessage[end]);
+            if (width + advance > maxWidth && end > start) {
+                break;
+            }
+            width += advance;
+            if (currentMessage[end] == ' ') {
+                lastSpace = end;
+            }
+            end++;
+        }
+
+        uint8_t next = end;
+        if (currentMessage[end] == '\n') {
+            next = end + 1;
+        } else if (currentMessage[end] != '\0' && currentMessage[end] != ' ' && lastSpace > start) {
+            // La palabra no cabe: se pasa entera a la línea siguiente
+            end = lastSpace;
+            next = lastSpace + 1;
+        }
+
+        while (end > start && currentMessage[end - 1] == ' ') {
+            end--;
+        }
+        lines[lineCount].start = start;
+        lines[lineCount].len = end - start;
+        lineCount++;
+        pos = next;
+    }
+    layoutFont = font;
+}
+
+/**
+ * @brief Dibuja la cabecera y las líneas ya repartidas del mensaje actual
+ */
+static void drawMessage() {
+    // Mostrar tipo de mensaje en la parte superior
+    u8g2->drawStr(0, SCREEN_HEADER_Y, SCREEN_TYPE_LABELS[currentType]);
+
+    // Cada línea se dibuja terminándola en su sitio y restaurando el carácter
+    u8g2_uint_t yPos = SCREEN_TEXT_FIRST_Y;
+    for (uint8_t i = 0; i < lineCount; i++) {
+        char* line = &currentMessage[lines[i].start];
+        char saved = line[lines[i].len];
+        line[lines[i].len] = '\0';
+        u8g2->drawStr(0, yPos, line);
+        line[lines[i].len] = saved;
+        yPos += SCREEN_TEXT_LINE_STEP;
+    }
+
+    // Los indicadores de actividad se muestran en turnOffDisplay(), no aquí
+}
+
+/**
+ * @brief Copia las filas del mensaje fijo actual (recortadas a la página en curso)
+ */
+static void drawStatusBitmap() {
+    u8g2->blitTileRows(0, currentBitmap->tile_rows, currentBitmap->tiles);
+}
+
+/**
+ * @brief Indicadores de actividad: 4 píxeles en patrón de "cuadrado" en la esquina superior derecha
+ */
+static void drawIndicators() {
+    u8g2->drawPixel(125, 1);
+    u8g2->drawPixel(126, 1);
+    u8g2->drawPixel(125, 2);
+    u8g2->drawPixel(126, 2);
+}
+
+/**
+ * @brief Renderiza el mensaje actual en la pantalla según su tipo
+ *
+ * El reparto en líneas se reutiliza mientras no cambien el texto ni la fuente.
+ */
+static void renderMessage() {
     if (!ENABLE_DISPLAY) {
         return;
     }
@@ -92,53 +368,40 @@ static void renderMessage(ScreenMessageType type, const String& text) {
         return;
     }
 
-    u8g2->clearBuffer();
-    u8g2->setFont(u8g2_font_ncenB08_tr);
+    u8g2->setFont(SCREEN_FONT);
+    if (layoutFont != SCREEN_FONT) {
+        layoutMessage(SCREEN_FONT);
+    }
+    drawFrame(drawMessage);
+}
 
-    // Mostrar tipo de mensaje en la parte superior
-    const char* typeStr = "";
-    switch (type) {
-        case MSG_INFO: typeStr = "[INFO]"; break;
-        case MSG_WARNING: typeStr = "[WARN]"; break;
-        case MSG_ERROR: typeStr = "[ERROR]"; break;
-        case MSG_SUCCESS: typeStr = "[OK]"; break;
-        case MSG_SENSOR_DATA: typeStr = "[SENSOR]"; break;
-        case MSG_STATUS: typeStr = "[STATUS]"; break;
-    }
-
-    u8g2->drawStr(0, 10, typeStr);
-
-    // Mostrar el texto del mensaje
-    // Dividir en líneas si es necesario
-    String textCopy = text;
-    int maxCharsPerLine = 16; // Aproximadamente para fuente ncenB08
-    int yPos = 25;
-
-    while (textCopy.length() > 0 && yPos < 60) {
-        String line;
-        if (textCopy.length() <= maxCharsPerLine) {
-            line = textCopy;
-            textCopy = "";
-        } else {
-            // Buscar un espacio para cortar la línea
-            int cutPos = maxCharsPerLine;
-            while (cutPos > 0 && textCopy.charAt(cutPos) != ' ') {
-                cutPos--;
-            }
-            if (cutPos == 0) cutPos = maxCharsPerLine;
+/**
+ * @brief Registra un mensaje como actual y prepara la pantalla para dibujarlo
+ *
+ * @return false si el mensaje no debe mostrarse (pantalla deshabilitada o ausente)
+ */
+static bool beginMessage(ScreenMessageType type, const char* text, uint32_t duration) {
+    if (!ENABLE_DISPLAY) {
+        return false;
+    }
 
-            line = textCopy.substring(0, cutPos);
-            textCopy = textCopy.substring(cutPos);
-            textCopy.trim(); // Remover espacio inicial
-        }
+    Serial.printf("DEBUG: Showing message: '%s' for %lu ms\n", text, (unsigned long)duration);
 
-        u8g2->drawStr(0, yPos, line.c_str());
-        yPos += 12;
+    if (!ensureDisplay(type)) {
+        return false;
     }
 
-    // Los indicadores de actividad se muestran en turnOffDisplay(), no aquí
+    // Solo se recalcula el reparto en líneas si el texto cambia
+    if (strncmp(currentMessage, text, SCREEN_MESSAGE_MAX_LEN) != 0) {
+        strlcpy(currentMessage, text, sizeof(currentMessage));
+        layoutFont = nullptr;
+    }
+    currentType = type;
+    messageStartTime = millis();
+    messageDuration = duration;
 
-    u8g2->sendBuffer();
+    turnOnDisplay();
+    return true;
 }
 
 /**
@@ -148,24 +411,38 @@ static void renderMessage(ScreenMessageType type, const String& text) {
  * @param text Texto del mensaje
  * @param duration Duración en milisegundos (0 = mostrar hasta que llegue otro mensaje)
  */
-void showMessage(ScreenMessageType type, const String& text, uint32_t duration) {
-    if (!ENABLE_DISPLAY) {
-        return;
+void showMessage(ScreenMessageType type, const char* text, uint32_t duration) {
+    if (beginMessage(type, text, duration)) {
+        renderMessage();
     }
+}
 
-    Serial.print("DEBUG: Showing message: '");
-    Serial.print(text);
-    Serial.print("' for ");
-    Serial.print(duration);
-    Serial.println("ms");
+/**
+ * @brief Muestra un mensaje fijo copiando su imagen prerenderizada al buffer
+ *
+ * Si el mensaje no se generó o se generó para otro ancho de pantalla, se
+ * dibuja con la fuente igual que showMessage().
+ *
+ * @param id Mensaje de status_messages.def
+ * @param duration Duración en milisegundos (0 = mostrar hasta que llegue otro mensaje)
+ */
+void showStatus(StatusMessage id, uint32_t duration) {
+    if (id >= STATUS_MESSAGE_COUNT) {
+        return;
+    }
+    ScreenMessageType type = STATUS_TYPES[id];
+    if (!beginMessage(type, STATUS_TEXTS[id], duration)) {
+        return;
+    }
 
-    currentMessage = text;
-    currentType = type;
-    messageStartTime = millis();
-    messageDuration = duration;
+    const status_bitmap_t* bitmap = &STATUS_BITMAPS[id];
+    if (!bitmap->tiles || bitmap->tile_width != u8g2->getBufferTileWidth()) {
+        renderMessage();
+        return;
+    }
 
-    turnOnDisplay();
-    renderMessage(type, text);
+    currentBitmap = bitmap;
+    drawFrame(drawStatusBitmap);
 }
 
 /**
@@ -174,7 +451,7 @@ void showMessage(ScreenMessageType type, const String& text, uint32_t duration)
  * @param text Texto del mensaje
  * @param duration Duración en milisegundos (por defecto MESSAGE_DURATION_SUCCESS)
  */
-void showInfo(const String& text, uint32_t duration) {
+void showInfo(const char* text, uint32_t duration) {
     if (duration == 0) duration = MESSAGE_DURATION_SUCCESS;
     showMessage(MSG_INFO, text, duration);
 }
@@ -185,7 +462,7 @@ void showInfo(const String& text, uint32_t duration) {
  * @param text Texto del mensaje
  * @param duration Duración en milisegundos (por defecto MESSAGE_DURATION_ERROR)
  */
-void showWarning(const String& text, uint32_t duration) {
+void showWarning(const char* text, uint32_t duration) {
     if (duration == 0) duration = MESSAGE_DURATION_ERROR;
     showMessage(MSG_WARNING, text, duration);
 }
@@ -196,7 +473,7 @@ void showWarning(const String& text, uint32_t duration) {
  * @param text Texto del mensaje
  * @param duration Duración en milisegundos (por defecto MESSAGE_DURATION_ERROR)
  */
-void showError(const String& text, uint32_t duration) {
+void showError(const char* text, uint32_t duration) {
     if (duration == 0) duration = MESSAGE_DURATION_ERROR;
     showMessage(MSG_ERROR, text, duration);
 }
@@ -207,7 +484,7 @@ void showError(const String& text, uint32_t duration) {
  * @param text Texto del mensaje
  * @param duration Duración en milisegundos (por defecto MESSAGE_DURATION_SUCCESS)
  */
-void showSuccess(const String& text, uint32_t duration) {
+void showSuccess(const char* text, uint32_t duration) {
     if (duration == 0) duration = MESSAGE_DURATION_SUCCESS;
     showMessage(MSG_SUCCESS, text, duration);
 }
@@ -227,7 +504,7 @@ void showSensorData(float temp, float hum, float battery, uint32_t duration) {
         showMessage(MSG_ERROR, "Sensor ERROR!", duration);
     } else {
         // Datos válidos del sensor
-        sprintf(buffer, "T:%.1fC H:%.1f%% B:%.2fV", temp, hum, battery);
+        snprintf(buffer, sizeof(buffer), "T:%.1fC H:%.1f%% B:%.2fV", temp, hum, battery);
         showMessage(MSG_SENSOR_DATA, buffer, duration);
     }
 }
@@ -241,10 +518,11 @@ void clearDisplay() {
     }
 
     if (u8g2) {
-        u8g2->clearBuffer();
-        u8g2->sendBuffer();
+        drawFrame(nullptr);
     }
-    currentMessage = "";
+    currentMessage[0] = '\0';
+    lineCount = 0;
+    layoutFont = nullptr;
     messageDuration = 0;
 }
 
@@ -258,23 +536,15 @@ void turnOffDisplay() {
     }
 
     if (u8g2) {
-        u8g2->clearBuffer();
-
         if (SHOW_ACTIVITY_INDICATORS) {
-            // Indicadores de actividad: 4 píxeles en patrón de "cuadrado"
-            // Esquina superior derecha
-            u8g2->drawPixel(125, 1);
-            u8g2->drawPixel(126, 1);
-            u8g2->drawPixel(125, 2);
-            u8g2->drawPixel(126, 2);
-
-            u8g2->sendBuffer();
+            drawFrame(drawIndicators);
 
             // NO apagamos completamente la pantalla para mantener los indicadores visibles
             // u8g2->setPowerSave(1);  // Comentado para mantener indicadores
         } else {
-            u8g2->sendBuffer();
+            drawFrame(nullptr);
             u8g2->setPowerSave(1);  // Apagar completamente si no hay indicadores
+            releaseDisplayBus();
         }
     }
     displayActive = false;
@@ -289,13 +559,24 @@ void turnOffDisplayCompletely() {
     }
 
     if (u8g2) {
-        u8g2->clearBuffer();
-        u8g2->sendBuffer();
+        drawFrame(nullptr);
         u8g2->setPowerSave(1);  // Apagar completamente la pantalla
+        releaseDisplayBus();
     }
     displayActive = false;
 }
 
+/**
+ * @brief Copia las medidas de los fotogramas enviados
+ */
+void getDisplayStats(ScreenStats* out) {
+#if DISPLAY_CAPTURE
+    *out = stats;
+#else
+    memset(out, 0, sizeof(*out));
+#endif
+}
+
 /**
  * @brief Enciende la pantalla si está apagada
  */
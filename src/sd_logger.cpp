@@ -0,0 +1,328 @@
+/**
+ * @file      sd_logger.cpp
+ * @brief     Implementación del registro binario en la tarjeta SD
+ *
+ * El buffer, el archivo actual y la secuencia viven en memoria RTC. Solo en
+ * un arranque en frío se reconstruyen a partir de la última entrada del
+ * índice y del tamaño de su archivo.
+ *
+ * Un vaciado escribe los bytes que llevan el archivo hasta el último límite
+ * de bloque alcanzable, de modo que tras un sd_logger_sync() el siguiente
+ * vaciado vuelve a dejar el archivo alineado.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "sd_logger.h"
+#include "LoRaBoards.h"        // SD
+#include "boot_mode.h"         // boot_mode_cold()
+#include <time.h>
+
+#if defined(HAS_SDCARD) && ENABLE_SD_LOGGER
+#define SD_LOGGER_ACTIVE 1
+#else
+#define SD_LOGGER_ACTIVE 0
+#endif
+
+#define RECORD_BYTES sizeof(sd_log_record_t)
+
+/**
+ * @brief Entrada del índice: una por archivo, en orden de creación
+ */
+typedef struct {
+    uint32_t file;           // Número del archivo (LOGnnnnn.BIN)
+    uint32_t firstSequence;  // Secuencia de su primer registro
+    uint32_t firstTimestamp; // Hora de su primer registro
+} index_entry_t;
+
+RTC_DATA_ATTR static sd_logger_stats_t stats;
+
+#if SD_LOGGER_ACTIVE
+static_assert(SD_LOG_BLOCK_BYTES % sizeof(sd_log_record_t) == 0,
+              "sd_log_record_t debe dividir el bloque: revisa sensor_data_t");
+static_assert(SD_LOG_MAX_FILE_BYTES % SD_LOG_BLOCK_BYTES == 0,
+              "SD_LOG_MAX_FILE_BYTES debe ser múltiplo del bloque");
+static_assert(SD_LOG_BUFFER_BYTES >= SD_LOG_BLOCK_BYTES + sizeof(sd_log_record_t),
+              "SD_LOG_BUFFER_BYTES debe admitir un bloque completo y un registro más");
+
+#define STATE_MAGIC 0x5D106A11
+
+RTC_DATA_ATTR static uint32_t stateMagic;
+RTC_DATA_ATTR static uint32_t fileNumber;     // Archivo actual (0 = ninguno todavía)
+RTC_DATA_ATTR static uint32_t fileBytes;      // Bytes del archivo actual en la SD
+RTC_DATA_ATTR static uint32_t nextSequence;
+RTC_DATA_ATTR static uint16_t pending;        // Bytes del buffer sin escribir
+RTC_DATA_ATTR static uint8_t buffer[SD_LOG_BUFFER_BYTES];
+
+static bool ready = false;
+
+static const char INDEX_PATH[] = SD_LOG_DIR "/INDEX.BIN";
+
+static void logPath(uint32_t file, char* path, size_t size) {
+    snprintf(path, size, SD_LOG_DIR "/LOG%05lu.BIN", (unsigned long)file);
+}
+
+/**
+ * @brief Tamaño de un archivo de registro (0 si no existe)
+ */
+static uint32_t logSize(uint32_t file) {
+    char path[32];
+    logPath(file, path, sizeof(path));
+    File f = SD.open(path, FILE_READ);
+    if (!f) {
+        return 0;
+    }
+    uint32_t size = f.size();
+    f.close();
+    return size;
+}
+
+/**
+ * @brief Lee la entrada n del índice (la primera es 0)
+ */
+static bool readIndexEntry(File& index, uint32_t n, index_entry_t* entry) {
+    return index.seek(n * sizeof(index_entry_t)) &&
+           index.read((uint8_t*)entry, sizeof(*entry)) == sizeof(*entry);
+}
+
+/**
+ * @brief Reconstruye el estado desde la última entrada del índice
+ */
+static void recover(void) {
+    fileNumber = 0;
+    fileBytes = 0;
+    nextSequence = 0;
+    pending = 0;
+    memset(&stats, 0, sizeof(stats));
+
+    File index = SD.open(INDEX_PATH, FILE_READ);
+    if (!index) {
+        return;
+    }
+    index_entry_t last;
+    const uint32_t entries = index.size() / sizeof(index_entry_t);
+    bool found = entries > 0 && readIndexEntry(index, entries - 1, &last);
+    index.close();
+    if (!found) {
+        return;
+    }
+
+    fileNumber = last.file;
+    fileBytes = logSize(fileNumber);
+    nextSequence = last.firstSequence + fileBytes / RECORD_BYTES;
+    if (fileBytes % RECORD_BYTES) {
+        // Último registro cortado por un apagado: seguir en un archivo nuevo
+        fileBytes = SD_LOG_MAX_FILE_BYTES;
+    }
+}
+
+/**
+ * @brief Empieza un archivo nuevo y lo anota en el índice
+ */
+static bool startFile(const sd_log_record_t* first) {
+    index_entry_t entry = { fileNumber + 1, first->sequence, first->timestamp };
+    File index = SD.open(INDEX_PATH, FILE_APPEND);
+    if (!index) {
+        return false;
+    }
+    size_t written = index.write((const uint8_t*)&entry, sizeof(entry));
+    index.close();
+    if (written != sizeof(entry)) {
+        return false;
+    }
+    stats.bytesWritten += written;
+    fileNumber = entry.file;
+    fileBytes = 0;
+    return true;
+}
+
+/**
+ * @brief Escribe los primeros len bytes del buffer, rotando si hace falta
+ * @return Bytes escritos
+ */
+static size_t writeOut(size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        if (fileNumber == 0 || fileBytes >= SD_LOG_MAX_FILE_BYTES) {
+            if (!startFile((const sd_log_record_t*)&buffer[done])) {
+                break;
+            }
+        }
+        size_t chunk = len - done;
+        if (chunk > SD_LOG_MAX_FILE_BYTES - fileBytes) {
+            chunk = SD_LOG_MAX_FILE_BYTES - fileBytes;
+        }
+
+        char path[32];
+        logPath(fileNumber, path, sizeof(path));
+        File f = SD.open(path, FILE_APPEND);
+        if (!f) {
+            break;
+        }
+        size_t written = f.write(&buffer[done], chunk);
+        f.close();
+        stats.flushes++;
+        stats.bytesWritten += written;
+        // Solo cuentan los registros completos; el resto se reescribe después
+        const size_t torn = written % RECORD_BYTES;
+        written -= torn;
+        fileBytes += written;
+        done += written;
+        if (torn) {
+            // Registro cortado al final del archivo: los siguientes irían
+            // desalineados detrás de él, así que se sigue en un archivo nuevo
+            fileBytes = SD_LOG_MAX_FILE_BYTES;
+        }
+        if (written != chunk) {
+            break;
+        }
+    }
+    if (done) {
+        memmove(buffer, &buffer[done], pending - done);
+        pending -= done;
+    }
+    return done;
+}
+
+/**
+ * @brief Bytes pendientes que llevan el archivo hasta el último límite de bloque
+ */
+static size_t alignedPending(void) {
+    // Tras una rotación el archivo nuevo empieza en 0
+    const uint32_t base = fileBytes >= SD_LOG_MAX_FILE_BYTES ? 0 : fileBytes;
+    const uint32_t end = base + pending;
+    const uint32_t blockEnd = end - end % SD_LOG_BLOCK_BYTES;
+    return blockEnd > base ? blockEnd - base : 0;
+}
+#endif
+
+bool sd_logger_begin(void) {
+#if SD_LOGGER_ACTIVE
+    if (SD.cardSize() == 0) {
+        Serial.println("Registro SD: sin tarjeta");
+        return false;
+    }
+    if (stateMagic != STATE_MAGIC || boot_mode_cold()) {
+        if (!SD.exists(SD_LOG_DIR)) {
+            SD.mkdir(SD_LOG_DIR);
+        }
+        recover();
+        stateMagic = STATE_MAGIC;
+        Serial.printf("Registro SD: archivo %lu, %lu bytes, siguiente registro %lu\n",
+                      (unsigned long)fileNumber, (unsigned long)fileBytes, (unsigned long)nextSequence);
+    }
+    ready = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool sd_logger_append(const sensor_data_t* data) {
+#if SD_LOGGER_ACTIVE
+    if (!ready) {
+        return false;
+    }
+    if (pending + RECORD_BYTES > sizeof(buffer)) {
+        writeOut(alignedPending());
+    }
+    if (pending + RECORD_BYTES > sizeof(buffer)) {
+        stats.dropped++;
+        return false;
+    }
+    sd_log_record_t record;
+    record.timestamp = (uint32_t)time(NULL);
+    record.sequence = nextSequence++;
+    record.data = *data;
+    memcpy(&buffer[pending], &record, RECORD_BYTES);
+    pending += RECORD_BYTES;
+    stats.records++;
+    return true;
+#else
+    (void)data;
+    return false;
+#endif
+}
+
+size_t sd_logger_flush(void) {
+#if SD_LOGGER_ACTIVE
+    if (!ready || pending < SD_LOG_FLUSH_THRESHOLD_BYTES) {
+        return 0;
+    }
+    size_t written = writeOut(alignedPending());
+    if (written) {
+        Serial.printf("Registro SD: %u bytes escritos, %u pendientes (escritos/registrados: %lu/%lu bytes)\n",
+                      (unsigned)written, pending, (unsigned long)stats.bytesWritten,
+                      (unsigned long)(stats.records * RECORD_BYTES));
+    }
+    return written;
+#else
+    return 0;
+#endif
+}
+
+size_t sd_logger_sync(void) {
+#if SD_LOGGER_ACTIVE
+    return ready ? writeOut(pending) : 0;
+#else
+    return 0;
+#endif
+}
+
+size_t sd_logger_read_tail(sd_log_record_t* out, size_t max) {
+#if SD_LOGGER_ACTIVE
+    if (!ready || max == 0) {
+        return 0;
+    }
+    // Se rellena desde el final de out hacia el principio
+    size_t slot = max;
+
+    // Registros todavía en el buffer
+    for (size_t n = pending / RECORD_BYTES; n > 0 && slot > 0; n--) {
+        memcpy(&out[--slot], &buffer[(n - 1) * RECORD_BYTES], RECORD_BYTES);
+    }
+
+    // Archivos del más reciente al más antiguo, según el índice
+    File index = SD.open(INDEX_PATH, FILE_READ);
+    if (index) {
+        uint32_t entry = index.size() / sizeof(index_entry_t);
+        index_entry_t e;
+        while (slot > 0 && entry > 0 && readIndexEntry(index, --entry, &e)) {
+            char path[32];
+            logPath(e.file, path, sizeof(path));
+            File f = SD.open(path, FILE_READ);
+            if (!f) {
+                continue;
+            }
+            uint32_t records = f.size() / RECORD_BYTES;
+            uint32_t count = records < slot ? records : slot;
+            slot -= count;
+            if (!f.seek((records - count) * RECORD_BYTES) ||
+                f.read((uint8_t*)&out[slot], count * RECORD_BYTES) != count * RECORD_BYTES) {
+                slot += count;
+                f.close();
+                break;
+            }
+            f.close();
+        }
+        index.close();
+    }
+
+    const size_t got = max - slot;
+    if (slot > 0) {
+        memmove(out, &out[slot], got * RECORD_BYTES);
+    }
+    return got;
+#else
+    (void)out;
+    (void)max;
+    return 0;
+#endif
+}
+
+void sd_logger_get_stats(sd_logger_stats_t* out) {
+    *out = stats;
+}
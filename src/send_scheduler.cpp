@@ -0,0 +1,104 @@
+/**
+ * @file      send_scheduler.cpp
+ * @brief     Implementación del planificador adaptativo del intervalo de envío
+ *
+ * Presupuesto energético: la carga por encima de BATTERY_RESERVE_PERCENT debe
+ * cubrir BATTERY_TARGET_AUTONOMY_DAYS. Eso fija una corriente media permitida;
+ * restando el consumo en sueño queda el margen para los ciclos despiertos,
+ * y de ahí el intervalo mínimo entre ciclos.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "send_scheduler.h"
+#include "battery_soc.h"
+#include "solar.h"
+
+// Peso de cada ciclo nuevo en la media móvil de energía por ciclo
+#define CYCLE_ENERGY_EMA_WEIGHT 0.25f
+
+// Estimación inicial del tiempo despierto por ciclo (join + sensor + TX + RX)
+#define CYCLE_AWAKE_MS_DEFAULT 12000
+
+// Energía media por ciclo en mAh, conservada entre despertares (0 = sin medir)
+RTC_DATA_ATTR static float cycleEnergyMah = 0.0f;
+
+/**
+ * @brief Convierte un tiempo despierto en carga consumida (mAh)
+ */
+static float awake_ms_to_mah(uint32_t awake_ms) {
+    return (awake_ms / 3600000.0f) * BATTERY_AWAKE_CURRENT_MA;
+}
+
+void scheduler_record_cycle(uint32_t awake_ms) {
+    float mah = awake_ms_to_mah(awake_ms);
+    if (cycleEnergyMah <= 0.0f) {
+        cycleEnergyMah = mah;
+    } else {
+        cycleEnergyMah += (mah - cycleEnergyMah) * CYCLE_ENERGY_EMA_WEIGHT;
+    }
+}
+
+float scheduler_cycle_energy_mah(void) {
+    return cycleEnergyMah > 0.0f ? cycleEnergyMah : awake_ms_to_mah(CYCLE_AWAKE_MS_DEFAULT);
+}
+
+uint32_t scheduler_compute_interval(uint8_t soc_percent, bool harvesting) {
+    // Sin medida de batería no hay presupuesto que calcular: intervalo nominal
+    if (soc_percent == BATTERY_SOC_UNKNOWN) {
+        return SEND_INTERVAL_SECONDS;
+    }
+
+    // Con cosecha solar y batería sana se muestrea al ritmo máximo
+    if (harvesting && soc_percent >= BATTERY_LOW_THRESHOLD) {
+        return SEND_INTERVAL_MIN_SECONDS;
+    }
+
+    float interval = SEND_INTERVAL_SECONDS;
+
+    // Corriente media permitida para agotar la reserva útil en el tiempo objetivo
+    float usableMah = (soc_percent - BATTERY_RESERVE_PERCENT) / 100.0f * BATTERY_CAPACITY_MAH;
+    float allowedMa = usableMah / (BATTERY_TARGET_AUTONOMY_DAYS * 24.0f);
+    float budgetMa = allowedMa - SLEEP_CURRENT_UA / 1000.0f;
+
+    if (usableMah <= 0.0f || budgetMa <= 0.0f) {
+        return SEND_INTERVAL_MAX_SECONDS;
+    }
+
+    // Intervalo con el que la energía de los ciclos despiertos cabe en el margen
+    float budgetInterval = scheduler_cycle_energy_mah() * 3600.0f / budgetMa;
+    if (budgetInterval > interval) {
+        interval = budgetInterval;
+    }
+
+    // Por debajo del umbral de batería baja, espaciar al menos al doble
+    if (soc_percent < BATTERY_LOW_THRESHOLD && interval < 2.0f * SEND_INTERVAL_SECONDS) {
+        interval = 2.0f * SEND_INTERVAL_SECONDS;
+    }
+
+    if (interval < SEND_INTERVAL_MIN_SECONDS) interval = SEND_INTERVAL_MIN_SECONDS;
+    if (interval > SEND_INTERVAL_MAX_SECONDS) interval = SEND_INTERVAL_MAX_SECONDS;
+    return (uint32_t)interval;
+}
+
+uint32_t scheduler_next_interval_seconds(void) {
+    if (!ENABLE_ADAPTIVE_INTERVAL) {
+        return SEND_INTERVAL_SECONDS;
+    }
+
+    uint8_t soc = battery_soc_estimate();
+    bool harvesting = ENABLE_SOLAR_CHARGING && isSolarChargingBattery();
+    uint32_t interval = scheduler_compute_interval(soc, harvesting);
+
+    if (soc == BATTERY_SOC_UNKNOWN) {
+        Serial.printf("Planificador: batería sin medida -> %lu s\n", (unsigned long)interval);
+    } else {
+        Serial.printf("Planificador: SoC %u%%, solar %s, %.3f mAh/ciclo -> %lu s\n",
+                      soc, harvesting ? "si" : "no", scheduler_cycle_energy_mah(),
+                      (unsigned long)interval);
+    }
+    return interval;
+}
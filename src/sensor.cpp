@@ -50,6 +50,18 @@ bool sensors_init_all(void) {
     return any_success;
 }
 
+/**
+ * @brief Enciende por adelantado los sensores que necesitan estabilizarse
+ */
+void sensors_warm_up_all(void) {
+#ifdef ENABLE_SENSOR_DHT22
+    sensor_dht22_warm_up();
+#endif
+#ifdef ENABLE_SENSOR_DHT11
+    sensor_dht11_warm_up();
+#endif
+}
+
 /**
  * @brief Verifica si al menos un sensor está disponible
  * @return true si algún sensor está operativo
@@ -225,6 +237,22 @@ uint8_t sensors_get_payload(payload_config_t* config) {
     if (!sensor_ok) {
         // Si no hay datos válidos, intentar reinicializar
         sensors_retry_init_all();
+    }
+
+    return sensors_build_payload(&data, config);
+}
+
+/**
+ * @brief Construye el payload a partir de una lectura ya hecha
+ * @param input Lectura de sensors_read_all()
+ * @param config Configuración del payload
+ * @return Número de bytes escritos
+ */
+uint8_t sensors_build_payload(const sensor_data_t* input, payload_config_t* config) {
+    if (!input || !config || config->max_size < PAYLOAD_SIZE_BYTES) return 0;
+
+    sensor_data_t data = *input;
+    if (!data.valid) {
         // Usar datos de error
         data.temperature = SENSOR_ERROR_TEMPERATURE;
         data.humidity = SENSOR_ERROR_HUMIDITY;
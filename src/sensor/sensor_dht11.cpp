@@ -11,13 +11,17 @@ static DHT dht(DHT_PIN, DHT11);
 
 // Estado del sensor
 static bool sensor_available = false;
+static bool powered = false;
+static uint32_t powerOnMs = 0;   // millis() del último encendido
 
 /**
  * @brief Controla la alimentación del sensor DHT11
  * @param power_on true para encender, false para apagar
  */
 static void dht_power_control(bool power_on) {
+    powered = power_on;
     if (power_on) {
+        powerOnMs = millis();
         pinMode(DHT_POWER_PIN, OUTPUT);
         digitalWrite(DHT_POWER_PIN, HIGH);
         Serial.println("DHT11: Alimentación ON");
@@ -34,6 +38,7 @@ static void dht_power_control(bool power_on) {
 bool sensor_dht11_init(void) {
     pinMode(DHT_POWER_PIN, OUTPUT);
     digitalWrite(DHT_POWER_PIN, LOW);
+    powered = false;
     dht.begin();
     Serial.println("Sensor DHT11 inicializado.");
     sensor_available = true;
@@ -56,14 +61,22 @@ bool sensor_dht11_retry_init(void) {
     return sensor_dht11_init();
 }
 
+/**
+ * @brief Enciende el sensor por adelantado para que la lectura no espere
+ */
+void sensor_dht11_warm_up(void) {
+    if (sensor_available && !powered) dht_power_control(true);
+}
+
 /**
  * @brief Lee todos los datos del sensor DHT11
  */
 bool sensor_dht11_read_all(sensor_data_t* data) {
     if (!sensor_available || !data) return false;
 
-    dht_power_control(true);
-    delay(DHT_POWER_ON_DELAY_MS);
+    if (!powered) dht_power_control(true);
+    uint32_t elapsed = millis() - powerOnMs;
+    if (elapsed < DHT_POWER_ON_DELAY_MS) delay(DHT_POWER_ON_DELAY_MS - elapsed);
 
     data->temperature = dht.readTemperature();
     data->humidity = dht.readHumidity();
@@ -11,13 +11,17 @@ static DHT dht(DHT_PIN, DHT_TYPE);
 
 // Estado del sensor
 static bool sensor_available = false;
+static bool powered = false;
+static uint32_t powerOnMs = 0;   // millis() del último encendido
 
 /**
  * @brief Controla la alimentación del sensor DHT22
  * @param power_on true para encender, false para apagar
  */
 static void dht_power_control(bool power_on) {
+    powered = power_on;
     if (power_on) {
+        powerOnMs = millis();
         // Encender sensor
         pinMode(DHT_POWER_PIN, OUTPUT);
         digitalWrite(DHT_POWER_PIN, HIGH);
@@ -37,6 +41,7 @@ bool sensor_dht22_init(void) {
     // Configurar pin de alimentación
     pinMode(DHT_POWER_PIN, OUTPUT);
     digitalWrite(DHT_POWER_PIN, LOW);  // Empezar apagado
+    powered = false;
 
     // Inicializar objeto DHT (no requiere alimentación aún)
     dht.begin();
@@ -65,6 +70,15 @@ bool sensor_dht22_retry_init(void) {
     return sensor_dht22_init();
 }
 
+/**
+ * @brief Enciende el sensor por adelantado para que la lectura no espere
+ */
+void sensor_dht22_warm_up(void) {
+    if (sensor_available && !powered) {
+        dht_power_control(true);
+    }
+}
+
 /**
  * @brief Lee todos los datos del sensor DHT22 con gestión de energía
  */
@@ -73,12 +87,18 @@ bool sensor_dht22_read_all(sensor_data_t* data) {
         return false;
     }
 
-    // Encender el sensor
-    dht_power_control(true);
+    // Encender el sensor (si no se encendió ya con sensor_dht22_warm_up())
+    if (!powered) {
+        dht_power_control(true);
+    }
 
-    // Esperar a que se estabilice
-    Serial.printf("DHT22: Esperando %d ms para estabilización...\n", DHT_POWER_ON_DELAY_MS);
-    delay(DHT_POWER_ON_DELAY_MS);
+    // Esperar a que se estabilice: solo lo que falte desde el encendido
+    uint32_t elapsed = millis() - powerOnMs;
+    if (elapsed < DHT_POWER_ON_DELAY_MS) {
+        Serial.printf("DHT22: Esperando %lu ms para estabilización...\n",
+                      (unsigned long)(DHT_POWER_ON_DELAY_MS - elapsed));
+        delay(DHT_POWER_ON_DELAY_MS - elapsed);
+    }
 
     // Leer datos del sensor
     data->temperature = dht.readTemperature();
@@ -1,23 +1,17 @@
 #include <XPowersLib.h>
 #include <Arduino.h>
-
-// Declaración externa para funciones de carga solar
-extern XPowersLibInterface *PMU;
+#include "pmu_status.h"  // Estado del PMU leído una vez por ciclo
 
 /**
  * @brief Verifica si la placa solar está cargando la batería
  * @return true si hay entrada VBUS y la batería está cargándose
  */
 bool isSolarChargingBattery() {
-    if (!PMU) return false;  // Verificar que PMU esté inicializado
-    
-    // Verifica si hay entrada VBUS (placa solar conectada y generando voltaje)
-    if (!PMU->isVbusIn()) {
-        return false;  // No hay entrada solar
-    }
-    
-    // Verifica si la batería está cargándose
-    return PMU->isCharging();
+    const XPowersStatusSnapshot_t* status = pmu_status();
+    if (!status) return false;  // Sin PMU o sin respuesta por I2C
+
+    // Entrada VBUS (placa solar conectada y generando voltaje) y batería cargándose
+    return status->vbusIn && status->charging;
 }
 
 /**
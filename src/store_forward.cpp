@@ -0,0 +1,305 @@
+/**
+ * @file      store_forward.cpp
+ * @brief     Implementación de la cola persistente en flash
+ *
+ * Cada hueco de 32 bytes es un registro o está borrado (todo 0xFF). La cabeza
+ * es el hueco siguiente al registro de mayor secuencia; la cola, el registro
+ * pendiente de menor secuencia. En un arranque en frío se recorren todos los
+ * huecos para deducirlas; tras un despertar se usan las copias en memoria
+ * RTC, que solo cambian a la vez que la propia flash.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "store_forward.h"
+#include "boot_mode.h"         // boot_mode_cold()
+#include <esp_partition.h>
+#include <esp_timer.h>
+#include <rom/crc.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <time.h>
+
+#define SECTOR_BYTES 4096
+
+// Estado de un registro: borrado = pendiente, cualquier otro valor = enviado
+#define SLOT_PENDING 0xFF
+#define SLOT_SENT 0x00
+
+// Registros como máximo en un lote (payloads de 1 byte en un lote de 222 bytes)
+#define MAX_BATCH_RECORDS 36
+
+/**
+ * @brief Registro tal y como se guarda en la flash
+ */
+typedef struct {
+    uint32_t sequence;       // 0xFFFFFFFF = hueco borrado
+    uint32_t timestamp;      // Hora del reloj RTC (s)
+    uint8_t len;
+    uint8_t state;           // SLOT_PENDING hasta que se envía; fuera del CRC
+    uint8_t payload[STORE_FORWARD_MAX_PAYLOAD];
+    uint16_t crc;            // CRC16 de sequence, timestamp, len y payload
+} slot_t;
+
+static_assert(sizeof(slot_t) == 32, "slot_t debe ocupar 32 bytes");
+static_assert(SECTOR_BYTES % sizeof(slot_t) == 0, "slot_t debe dividir el sector");
+
+#define SLOTS_PER_SECTOR (SECTOR_BYTES / sizeof(slot_t))
+#define STATE_MAGIC 0x5F0A7D21
+
+static const esp_partition_t* partition = NULL;
+static SemaphoreHandle_t lock = NULL;
+static uint32_t slotCount = 0;
+
+// Huecos del último lote, pendientes de store_forward_commit()
+static uint16_t batchSlots[MAX_BATCH_RECORDS];
+static uint8_t batchCount = 0;
+
+RTC_DATA_ATTR static uint32_t stateMagic;
+RTC_DATA_ATTR static uint32_t head;          // Próximo hueco a escribir
+RTC_DATA_ATTR static uint32_t tail;          // Registro pendiente más antiguo (== head si no hay)
+RTC_DATA_ATTR static uint32_t nextSequence;
+RTC_DATA_ATTR static store_forward_stats_t stats;
+
+static uint16_t slotCrc(const slot_t* s) {
+    uint16_t crc = crc16_le(0, (const uint8_t*)s, offsetof(slot_t, state));
+    return crc16_le(crc, s->payload, sizeof(s->payload));
+}
+
+static bool readSlot(uint32_t index, slot_t* s) {
+    return esp_partition_read(partition, index * sizeof(slot_t), s, sizeof(*s)) == ESP_OK;
+}
+
+static bool isValid(const slot_t* s) {
+    return s->sequence != 0xFFFFFFFF && s->len <= STORE_FORWARD_MAX_PAYLOAD && s->crc == slotCrc(s);
+}
+
+static bool isErased(const slot_t* s) {
+    const uint8_t* p = (const uint8_t*)s;
+    for (size_t i = 0; i < sizeof(*s); i++) {
+        if (p[i] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint32_t nextSlot(uint32_t index) {
+    return index + 1 == slotCount ? 0 : index + 1;
+}
+
+/**
+ * @brief Avanza la cola desde 'from' hasta el siguiente registro pendiente
+ */
+static void advanceTail(uint32_t from) {
+    slot_t s;
+    tail = from;
+    while (tail != head && readSlot(tail, &s) && !(isValid(&s) && s.state == SLOT_PENDING)) {
+        tail = nextSlot(tail);
+    }
+}
+
+/**
+ * @brief Reconstruye cabeza, cola y pendientes recorriendo la partición
+ */
+static void scan(void) {
+    slot_t s;
+    bool any = false;
+    uint32_t maxSeq = 0, maxIndex = 0;
+    uint32_t minPendingSeq = 0, minPendingIndex = 0;
+    uint32_t pending = 0;
+
+    for (uint32_t i = 0; i < slotCount; i++) {
+        if (!readSlot(i, &s) || !isValid(&s)) {
+            continue;
+        }
+        if (!any || s.sequence > maxSeq) {
+            maxSeq = s.sequence;
+            maxIndex = i;
+        }
+        if (s.state == SLOT_PENDING) {
+            if (pending == 0 || s.sequence < minPendingSeq) {
+                minPendingSeq = s.sequence;
+                minPendingIndex = i;
+            }
+            pending++;
+        }
+        any = true;
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    stats.capacity = slotCount;
+    stats.pending = pending;
+    nextSequence = any ? maxSeq + 1 : 0;
+    head = any ? nextSlot(maxIndex) : 0;
+    // Un registro a medias tras un corte no se puede reescribir sin borrar:
+    // saltarlo (el sector se borrará en la siguiente vuelta)
+    while (head % SLOTS_PER_SECTOR != 0 && readSlot(head, &s) && !isErased(&s)) {
+        head = nextSlot(head);
+    }
+    tail = pending ? minPendingIndex : head;
+}
+
+bool store_forward_begin(void) {
+    if (!ENABLE_STORE_FORWARD) {
+        return false;
+    }
+    if (partition == NULL) {
+        partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                             (esp_partition_subtype_t)STORE_FORWARD_PARTITION_SUBTYPE,
+                                             STORE_FORWARD_PARTITION);
+        if (partition == NULL) {
+            Serial.println("Cola de envíos: falta la partición " STORE_FORWARD_PARTITION " (ver partitions.csv)");
+            return false;
+        }
+        slotCount = (partition->size / SECTOR_BYTES) * SLOTS_PER_SECTOR;
+        lock = xSemaphoreCreateMutex();
+    }
+
+    if (stateMagic != STATE_MAGIC || boot_mode_cold()) {
+        const int64_t start = esp_timer_get_time();
+        scan();
+        stateMagic = STATE_MAGIC;
+        Serial.printf("Cola de envíos: %lu pendientes de %lu (recorrida en %lu ms)\n",
+                      (unsigned long)stats.pending, (unsigned long)slotCount,
+                      (unsigned long)((esp_timer_get_time() - start) / 1000));
+    }
+    return true;
+}
+
+bool store_forward_push(const uint8_t* payload, uint8_t len) {
+    if (partition == NULL || len == 0 || len > STORE_FORWARD_MAX_PAYLOAD) {
+        return false;
+    }
+    xSemaphoreTake(lock, portMAX_DELAY);
+
+    if (head % SLOTS_PER_SECTOR == 0) {
+        // Entrar en un sector lo borra: los pendientes que queden en él se pierden
+        const uint32_t first = head, last = head + SLOTS_PER_SECTOR;
+        uint32_t lost = 0;
+        slot_t s;
+        for (uint32_t i = first; i < last && stats.pending; i++) {
+            if (readSlot(i, &s) && isValid(&s) && s.state == SLOT_PENDING) {
+                lost++;
+            }
+        }
+        if (esp_partition_erase_range(partition, first * sizeof(slot_t), SECTOR_BYTES) != ESP_OK) {
+            xSemaphoreGive(lock);
+            return false;
+        }
+        stats.erases++;
+        if (lost) {
+            stats.dropped += lost;
+            stats.pending -= lost;
+            advanceTail(last == slotCount ? 0 : last);
+        }
+    }
+
+    slot_t s;
+    memset(&s, 0xFF, sizeof(s));
+    s.sequence = nextSequence;
+    s.timestamp = (uint32_t)time(NULL);
+    s.len = len;
+    memset(s.payload, 0, sizeof(s.payload));
+    memcpy(s.payload, payload, len);
+    s.crc = slotCrc(&s);
+
+    bool ok = esp_partition_write(partition, head * sizeof(slot_t), &s, sizeof(s)) == ESP_OK;
+    nextSequence++;
+    if (stats.pending == 0) {
+        tail = head;
+    }
+    head = nextSlot(head);
+    if (ok) {
+        stats.pending++;
+        stats.stored++;
+    } else if (stats.pending == 0) {
+        tail = head;
+    }
+    xSemaphoreGive(lock);
+    return ok;
+}
+
+uint32_t store_forward_pending(void) {
+    return partition ? stats.pending : 0;
+}
+
+uint8_t store_forward_build_batch(uint8_t* buf, uint8_t max_size, uint8_t* count) {
+    *count = 0;
+    batchCount = 0;
+    if (partition == NULL || max_size < 1) {
+        return 0;
+    }
+    xSemaphoreTake(lock, portMAX_DELAY);
+
+    const time_t now = time(NULL);
+    uint8_t size = 1;
+    slot_t s;
+    for (uint32_t i = tail; i != head && batchCount < MAX_BATCH_RECORDS; i = nextSlot(i)) {
+        if (!readSlot(i, &s) || !isValid(&s) || s.state != SLOT_PENDING) {
+            continue;
+        }
+        if (size + 5 + s.len > max_size) {
+            break;
+        }
+        // Sin hora válida (reloj reiniciado tras un arranque en frío) la antigüedad se desconoce
+        uint32_t age = now >= (time_t)s.timestamp ? (uint32_t)(now - s.timestamp) / 60 : 0xFFFF;
+        if (age > 0xFFFF) {
+            age = 0xFFFF;
+        }
+        buf[size++] = (uint8_t)(s.sequence >> 8);
+        buf[size++] = (uint8_t)s.sequence;
+        buf[size++] = (uint8_t)(age >> 8);
+        buf[size++] = (uint8_t)age;
+        buf[size++] = s.len;
+        memcpy(&buf[size], s.payload, s.len);
+        size += s.len;
+        batchSlots[batchCount++] = (uint16_t)i;
+    }
+    xSemaphoreGive(lock);
+
+    if (batchCount == 0) {
+        return 0;
+    }
+    buf[0] = batchCount;
+    *count = batchCount;
+    return size;
+}
+
+void store_forward_commit(void) {
+    if (partition == NULL || batchCount == 0) {
+        return;
+    }
+    xSemaphoreTake(lock, portMAX_DELAY);
+    const uint8_t sent = SLOT_SENT;
+    uint32_t last = tail;
+    bool committed = false;
+    for (uint8_t i = 0; i < batchCount; i++) {
+        // Un sector borrado entre el lote y la confirmación ya descontó sus registros
+        slot_t s;
+        if (!readSlot(batchSlots[i], &s) || !isValid(&s) || s.state != SLOT_PENDING) {
+            continue;
+        }
+        esp_partition_write(partition, batchSlots[i] * sizeof(slot_t) + offsetof(slot_t, state),
+                            &sent, sizeof(sent));
+        stats.pending--;
+        stats.sent++;
+        last = batchSlots[i];
+        committed = true;
+    }
+    batchCount = 0;
+    if (stats.pending == 0) {
+        tail = head;
+    } else if (committed) {
+        advanceTail(nextSlot(last));
+    }
+    xSemaphoreGive(lock);
+}
+
+void store_forward_get_stats(store_forward_stats_t* out) {
+    *out = stats;
+    out->capacity = slotCount;
+}
@@ -45,6 +45,24 @@ static void print_decoder_header() {
     Serial.println(F("  var bytes = input.bytes;"));
     Serial.println(F("  var offset = 0;"));
     Serial.println(F(""));
+    if (ENABLE_STORE_FORWARD) {
+        Serial.println(F("  // Lote de lecturas guardadas en la cola en flash (ver store_forward.h)"));
+        Serial.printf("  if (input.fPort === %d) {\n", STORE_FORWARD_FPORT);
+        Serial.println(F("    var stored = [];"));
+        Serial.println(F("    var p = 1;"));
+        Serial.println(F("    for (var i = 0; i < bytes[0]; i++) {"));
+        Serial.println(F("      var len = bytes[p + 4];"));
+        Serial.println(F("      var r = decodeUplink({ fPort: 1, bytes: bytes.slice(p + 5, p + 5 + len) }).data;"));
+        Serial.println(F("      r.sequence = (bytes[p] << 8) | bytes[p + 1];"));
+        Serial.println(F("      var age = (bytes[p + 2] << 8) | bytes[p + 3];"));
+        Serial.println(F("      if (age !== 0xFFFF) r.age_minutes = age;"));
+        Serial.println(F("      stored.push(r);"));
+        Serial.println(F("      p += 5 + len;"));
+        Serial.println(F("    }"));
+        Serial.println(F("    return { data: { stored: stored } };"));
+        Serial.println(F("  }"));
+        Serial.println(F(""));
+    }
 }
 
 /**
@@ -90,6 +108,28 @@ static void print_battery_decoder() {
     Serial.println(F(""));
 }
 
+/**
+ * @brief Imprime el código para decodificar el resumen estadístico de la ventana
+ *
+ * Cada campo activo ocupa 8 bytes: min, max, media y desviación (int16/uint16).
+ */
+static void print_stats_decoder() {
+    Serial.println(F("  // Resumen de ventana: nº de muestras y min/max/media/desviación por campo"));
+    Serial.println(F("  function s16(i) { var v = (bytes[i] << 8) | bytes[i + 1]; return v > 32767 ? v - 65536 : v; }"));
+    Serial.println(F("  function u16(i) { return (bytes[i] << 8) | bytes[i + 1]; }"));
+    Serial.println(F("  function summary(rd, scale) {"));
+    Serial.println(F("    var r = { min: rd(offset) / scale, max: rd(offset + 2) / scale,"));
+    Serial.println(F("              mean: rd(offset + 4) / scale, stddev: rd(offset + 6) / scale };"));
+    Serial.println(F("    offset += 8;"));
+    Serial.println(F("    return r;"));
+    Serial.println(F("  }"));
+    Serial.println(F("  data.samples = bytes[offset++];"));
+    if (SYSTEM_HAS_TEMPERATURE) Serial.println(F("  data.temperature = summary(s16, 100.0);"));
+    if (SYSTEM_HAS_HUMIDITY) Serial.println(F("  data.humidity = summary(s16, 100.0);"));
+    if (SYSTEM_HAS_PRESSURE) Serial.println(F("  data.pressure = summary(u16, 10.0);"));
+    if (SYSTEM_HAS_DISTANCE) Serial.println(F("  data.distance = summary(u16, 100.0);"));
+}
+
 /**
  * @brief Imprime el footer del decoder TTN
  */
@@ -148,7 +188,7 @@ static void print_configuration_info() {
     Serial.println(F(""));
 
     // Calcular tamaño del payload
-    uint8_t payload_size = PAYLOAD_SIZE_BYTES;
+    uint8_t payload_size = ENABLE_WINDOWED_STATS ? STATS_PAYLOAD_SIZE_BYTES : PAYLOAD_SIZE_BYTES;
     Serial.printf("Tamaño del payload: %d bytes\r\n", payload_size);
 
     // Información sobre qué campos están incluidos
@@ -177,6 +217,13 @@ void generate_and_print_ttn_decoder() {
     print_configuration_info();
     print_decoder_header();
 
+    if (ENABLE_WINDOWED_STATS) {
+        print_stats_decoder();
+        print_battery_decoder();
+        print_decoder_footer();
+        return;
+    }
+
     // Generar el código de decodificación según los sensores activos
     if (SYSTEM_HAS_TEMPERATURE) {
         print_temperature_decoder();
@@ -0,0 +1,182 @@
+/**
+ * @file      windowed_stats.cpp
+ * @brief     Implementación de las estadísticas por ventana (Welford)
+ *
+ * El estado de la ventana se guarda en memoria RTC (RTC_DATA_ATTR), que se
+ * conserva durante el sueño profundo y se reinicia en un arranque en frío.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include "../config/config.h"  // Configuración unificada del proyecto
+#include "windowed_stats.h"
+#include <math.h>
+
+// ============================================================================
+// ACUMULADOR DE UN CAMPO
+// ============================================================================
+
+void stats_accumulator_reset(stats_accumulator_t* acc) {
+    if (!acc) return;
+    acc->count = 0;
+    acc->min = 0.0f;
+    acc->max = 0.0f;
+    acc->mean = 0.0f;
+    acc->m2 = 0.0f;
+}
+
+void stats_accumulator_add(stats_accumulator_t* acc, float value) {
+    if (!acc || isnan(value) || acc->count == UINT16_MAX) return;
+
+    if (acc->count == 0) {
+        acc->min = value;
+        acc->max = value;
+    } else {
+        if (value < acc->min) acc->min = value;
+        if (value > acc->max) acc->max = value;
+    }
+
+    // Actualización de Welford: numéricamente estable y sin guardar la serie
+    acc->count++;
+    float delta = value - acc->mean;
+    acc->mean += delta / acc->count;
+    acc->m2 += delta * (value - acc->mean);
+}
+
+float stats_accumulator_stddev(const stats_accumulator_t* acc) {
+    if (!acc || acc->count < 2) return 0.0f;
+    return sqrtf(acc->m2 / acc->count);
+}
+
+// ============================================================================
+// VENTANA DE ESTADÍSTICAS (MEMORIA RTC)
+// ============================================================================
+
+typedef struct {
+    uint16_t samples;
+    stats_accumulator_t temperature;
+    stats_accumulator_t humidity;
+    stats_accumulator_t pressure;
+    stats_accumulator_t distance;
+    stats_accumulator_t battery;
+} stats_window_t;
+
+// Se conserva entre despertares de sueño profundo; a cero en arranque en frío
+RTC_DATA_ATTR static stats_window_t window;
+
+void stats_window_reset(void) {
+    window.samples = 0;
+    stats_accumulator_reset(&window.temperature);
+    stats_accumulator_reset(&window.humidity);
+    stats_accumulator_reset(&window.pressure);
+    stats_accumulator_reset(&window.distance);
+    stats_accumulator_reset(&window.battery);
+}
+
+void stats_window_add_sample(const sensor_data_t* data) {
+    if (!data) return;
+
+    if (window.samples < UINT16_MAX) {
+        window.samples++;
+    }
+
+    // Solo se acumulan los campos con lectura válida
+    if (data->temperature != SENSOR_ERROR_TEMPERATURE) {
+        stats_accumulator_add(&window.temperature, data->temperature);
+    }
+    if (data->humidity != SENSOR_ERROR_HUMIDITY) {
+        stats_accumulator_add(&window.humidity, data->humidity);
+    }
+    if (data->pressure != SENSOR_ERROR_PRESSURE) {
+        stats_accumulator_add(&window.pressure, data->pressure);
+    }
+    if (data->distance != SENSOR_ERROR_DISTANCE) {
+        stats_accumulator_add(&window.distance, data->distance);
+    }
+    if (data->battery > 0.0f) {
+        stats_accumulator_add(&window.battery, data->battery);
+    }
+}
+
+uint16_t stats_window_sample_count(void) {
+    return window.samples;
+}
+
+bool stats_window_is_due(void) {
+    uint16_t samples_per_window = SEND_INTERVAL_SECONDS / STATS_SAMPLE_INTERVAL_SECONDS;
+    if (samples_per_window == 0) samples_per_window = 1;
+    return window.samples >= samples_per_window;
+}
+
+const stats_accumulator_t* stats_window_temperature(void) { return &window.temperature; }
+const stats_accumulator_t* stats_window_humidity(void)    { return &window.humidity; }
+const stats_accumulator_t* stats_window_pressure(void)    { return &window.pressure; }
+const stats_accumulator_t* stats_window_distance(void)    { return &window.distance; }
+const stats_accumulator_t* stats_window_battery(void)     { return &window.battery; }
+
+/**
+ * @brief Escribe un valor de 16 bits big-endian en el buffer
+ */
+static void put_u16(payload_config_t* config, uint8_t* offset, uint16_t value) {
+    config->buffer[(*offset)++] = value >> 8;
+    config->buffer[(*offset)++] = value & 0xFF;
+}
+
+/**
+ * @brief Escribe min/max/media/desviación de un campo con la escala indicada
+ *
+ * Si el campo no tiene muestras válidas se envía el valor de error en los
+ * cuatro huecos, igual que hace el payload normal con lecturas fallidas.
+ */
+static void put_summary(payload_config_t* config, uint8_t* offset,
+                        const stats_accumulator_t* acc, float scale,
+                        float error_value, bool is_signed) {
+    float values[4];
+    if (acc->count == 0) {
+        values[0] = values[1] = values[2] = values[3] = error_value;
+    } else {
+        values[0] = acc->min;
+        values[1] = acc->max;
+        values[2] = acc->mean;
+        values[3] = stats_accumulator_stddev(acc);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        if (is_signed) {
+            put_u16(config, offset, (uint16_t)(int16_t)(values[i] * scale));
+        } else {
+            put_u16(config, offset, (uint16_t)(values[i] * scale));
+        }
+    }
+}
+
+uint8_t stats_window_get_payload(payload_config_t* config) {
+    if (!config || config->max_size < STATS_PAYLOAD_SIZE_BYTES) return 0;
+
+    uint8_t offset = 0;
+
+    config->buffer[offset++] = window.samples > 0xFF ? 0xFF : (uint8_t)window.samples;
+
+    // Mismas escalas que sensors_get_payload()
+    if (SYSTEM_HAS_TEMPERATURE) {
+        put_summary(config, &offset, &window.temperature, 100.0f, SENSOR_ERROR_TEMPERATURE, true);
+    }
+    if (SYSTEM_HAS_HUMIDITY) {
+        put_summary(config, &offset, &window.humidity, 100.0f, SENSOR_ERROR_HUMIDITY, true);
+    }
+    if (SYSTEM_HAS_PRESSURE) {
+        put_summary(config, &offset, &window.pressure, 10.0f, SENSOR_ERROR_PRESSURE, false);
+    }
+    if (SYSTEM_HAS_DISTANCE) {
+        put_summary(config, &offset, &window.distance, 100.0f, SENSOR_ERROR_DISTANCE, false);
+    }
+
+    // Batería: el mínimo de la ventana es el dato relevante para autonomía
+    float battery = window.battery.count ? window.battery.min : 0.0f;
+    put_u16(config, &offset, (uint16_t)(battery * 100));
+
+    config->written = offset;
+    return offset;
+}
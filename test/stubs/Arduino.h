@@ -0,0 +1,129 @@
+/**
+ * @file      Arduino.h
+ * @brief     Sustituto mínimo de Arduino.h para las pruebas en el host
+ *
+ * Solo declara lo que usan los módulos que se compilan con [env:native]:
+ * atributos de sección vacíos, un reloj simulado (millis(), micros() y
+ * delay() avanzan host_clock_us en lugar de esperar) y un Serial que
+ * escribe en stdout solo si host_serial_echo es true.
+ *
+ * No define ARDUINO: las bibliotecas (U8g2, XPowersLib) se compilan en su
+ * variante genérica para C/C++.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <sched.h>
+
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define IRAM_ATTR
+#define PROGMEM
+#define F(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+
+// Mismas definiciones que XPowersCommon.tpp para que no choquen
+#define _BV(b)                          (1ULL << (uint64_t)(b))
+#define LOW                 0x0
+#define HIGH                0x1
+#define INPUT               0x01
+#define OUTPUT              0x03
+#define DEC                 10
+#define HEX                 16
+
+#ifndef constrain
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#endif
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+// newlib (ESP32) tiene strlcpy; glibc solo desde la 2.38
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+inline size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t len = strlen(src);
+    if (size > 0) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+// ============================================================================
+// RELOJ SIMULADO
+// ============================================================================
+
+inline uint64_t host_clock_us = 0;
+
+inline unsigned long millis(void) { return (unsigned long)(host_clock_us / 1000); }
+inline unsigned long micros(void) { return (unsigned long)host_clock_us; }
+inline void delay(unsigned long ms) { host_clock_us += (uint64_t)ms * 1000; }
+inline void delayMicroseconds(unsigned int us) { host_clock_us += us; }
+inline void yield(void) {}
+
+// FreeRTOS: en el PC solo cede la CPU al otro hilo, sin mover el reloj simulado
+inline void vTaskDelay(uint32_t ticks) { (void)ticks; sched_yield(); }
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+
+// ============================================================================
+// SERIAL
+// ============================================================================
+
+inline bool host_serial_echo = false;
+
+class HostSerial {
+public:
+    size_t bytes = 0;   // Bytes escritos desde el inicio de la prueba
+
+    int printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, fmt);
+        char buf[256];
+        int n = vsnprintf(buf, sizeof(buf), fmt, args);
+        va_end(args);
+        write(buf);
+        return n;
+    }
+    size_t print(const char* s) { return write(s); }
+    size_t print(char c) { char s[2] = {c, 0}; return write(s); }
+    size_t print(int v) { return printf("%d", v); }
+    size_t print(unsigned v) { return printf("%u", v); }
+    size_t print(long v) { return printf("%ld", v); }
+    size_t print(unsigned long v) { return printf("%lu", v); }
+    size_t print(double v, int digits = 2) { return printf("%.*f", digits, v); }
+    size_t print(int v, int base) { return base == HEX ? printf("%X", v) : print(v); }
+    template <typename T> size_t println(T v) { return print(v) + println(); }
+    size_t println(double v, int digits) { return print(v, digits) + println(); }
+    size_t println(int v, int base) { return print(v, base) + println(); }
+    size_t println(void) { return write("\n"); }
+    void flush(void) { fflush(stdout); }
+    operator bool() const { return true; }
+
+private:
+    size_t write(const char* s) {
+        size_t n = strlen(s);
+        bytes += n;
+        if (host_serial_echo) fputs(s, stdout);
+        return n;
+    }
+};
+
+inline HostSerial Serial;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,59 @@
+/**
+ * @file      LoRaBoards.h
+ * @brief     Sustituto de include/LoRaBoards.h para las pruebas en el host
+ *
+ * Mismas declaraciones que la placa real, sin WiFi ni bus I2C; la SD es
+ * la tarjeta en memoria de stubs/SD.h. Cada prueba define las funciones
+ * que usa el módulo probado (por ejemplo readBatteryVoltage()) y, si lo
+ * necesita, apunta PMU a un XPowersAXP192 conectado al simulador de
+ * pmu_sim.h o u8g2 a una pantalla sobre display_sim.h.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "../../config/hardware_config.h"
+
+#ifdef HAS_SDCARD
+#include <SD.h>
+#endif
+
+#ifdef HAS_PMU
+#include <XPowersLib.h>
+#endif
+
+enum {
+    POWERMANAGE_ONLINE  = _BV(0),
+    DISPLAY_ONLINE      = _BV(1),
+    RADIO_ONLINE        = _BV(2),
+    GPS_ONLINE          = _BV(3),
+    PSRAM_ONLINE        = _BV(4),
+    SDCARD_ONLINE       = _BV(5),
+    AXDL345_ONLINE      = _BV(6),
+    BME280_ONLINE       = _BV(7),
+    BMP280_ONLINE       = _BV(8),
+    BME680_ONLINE       = _BV(9),
+    QMC6310_ONLINE      = _BV(10),
+    QMI8658_ONLINE      = _BV(11),
+    PCF8563_ONLINE      = _BV(12),
+    OSC32768_ONLINE      = _BV(13),
+};
+
+#ifdef HAS_PMU
+inline XPowersLibInterface *PMU = NULL;
+#endif
+
+// Solo si la prueba ya incluyó U8g2 (display_sim.h); el resto no depende de la biblioteca
+#if defined(DISPLAY_MODEL) && defined(U8G2LIB_HH)
+inline DISPLAY_MODEL *u8g2 = NULL;
+bool beginDisplay();
+#endif
+
+inline uint32_t deviceOnline = 0;
+
+float readBatteryVoltage();
+uint8_t batteryPercentFromVoltage(float voltage);
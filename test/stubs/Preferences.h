@@ -0,0 +1,109 @@
+/**
+ * @file      Preferences.h
+ * @brief     Sustituto de Preferences (NVS) para las pruebas en el host
+ *
+ * Guarda los pares clave/valor de cada espacio de nombres en memoria y
+ * cuenta las escrituras que llegan a la flash. Como NVS, escribir el mismo
+ * valor que ya hay no cuenta, y begin() en solo lectura falla si el espacio
+ * de nombres no existe. entries cuenta las entradas de 32 bytes que ocupa
+ * cada escritura (un valor numérico, una; un blob, cabecera, datos e
+ * índice), que es lo que gasta las páginas de NVS.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <vector>
+
+class Preferences {
+public:
+    typedef std::map<std::string, std::vector<uint8_t>> Namespace;
+
+    static inline std::map<std::string, Namespace> store;  // Contenido de la partición NVS
+    static inline uint32_t writes = 0;                      // Entradas escritas o borradas
+    static inline uint64_t entries = 0;                     // Entradas de 32 bytes escritas
+
+    static void reset(void) {
+        store.clear();
+        writes = 0;
+        entries = 0;
+    }
+
+    bool begin(const char* name, bool readOnly = false) {
+        if (readOnly && store.find(name) == store.end()) {
+            return false;
+        }
+        ns = &store[name];
+        this->readOnly = readOnly;
+        return true;
+    }
+    void end(void) { ns = NULL; }
+
+    bool clear(void) {
+        if (!ns || readOnly) return false;
+        writes += ns->size();
+        ns->clear();
+        return true;
+    }
+    bool remove(const char* key) {
+        if (!ns || readOnly || !ns->erase(key)) return false;
+        writes++;
+        return true;
+    }
+    bool isKey(const char* key) { return ns && ns->count(key); }
+
+    size_t putUChar(const char* key, uint8_t v) { return put(key, &v, sizeof(v)); }
+    size_t putUShort(const char* key, uint16_t v) { return put(key, &v, sizeof(v)); }
+    size_t putULong(const char* key, uint32_t v) { return put(key, &v, sizeof(v)); }
+    size_t putBytes(const char* key, const void* v, size_t len) { return put(key, v, len, 2 + (len + 31) / 32); }
+
+    uint8_t getUChar(const char* key, uint8_t def = 0) { return get(key, def); }
+    uint16_t getUShort(const char* key, uint16_t def = 0) { return get(key, def); }
+    uint32_t getULong(const char* key, uint32_t def = 0) { return get(key, def); }
+    size_t getBytesLength(const char* key) {
+        auto it = find(key);
+        return it ? it->size() : 0;
+    }
+    size_t getBytes(const char* key, void* buf, size_t maxLen) {
+        auto it = find(key);
+        if (!it || it->size() > maxLen) return 0;
+        memcpy(buf, it->data(), it->size());
+        return it->size();
+    }
+
+private:
+    Namespace* ns = NULL;
+    bool readOnly = false;
+
+    const std::vector<uint8_t>* find(const char* key) {
+        if (!ns) return NULL;
+        auto it = ns->find(key);
+        return it == ns->end() ? NULL : &it->second;
+    }
+
+    size_t put(const char* key, const void* v, size_t len, uint32_t nvsEntries = 1) {
+        if (!ns || readOnly) return 0;
+        std::vector<uint8_t> data((const uint8_t*)v, (const uint8_t*)v + len);
+        std::vector<uint8_t>& slot = (*ns)[key];
+        if (slot != data) {
+            slot = data;
+            writes++;
+            entries += nvsEntries;
+        }
+        return len;
+    }
+
+    template <typename T> T get(const char* key, T def) {
+        auto it = find(key);
+        if (!it || it->size() != sizeof(T)) return def;
+        T v;
+        memcpy(&v, it->data(), sizeof(T));
+        return v;
+    }
+};
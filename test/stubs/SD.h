@@ -0,0 +1,118 @@
+/**
+ * @file      SD.h
+ * @brief     Sustituto de SD.h para las pruebas en el host: tarjeta en memoria
+ *
+ * Cada archivo es un vector de bytes. La tarjeta cuenta aperturas y bytes
+ * escritos, y writeBudget limita los bytes que aceptan las escrituras
+ * siguientes (tarjeta llena o corte de alimentación a mitad de escritura):
+ * write() devuelve menos bytes de los pedidos, como la biblioteca real.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+class File {
+public:
+    File() {}
+    explicit File(std::vector<uint8_t>* data) : data(data) {}
+
+    explicit operator bool() const { return data != NULL; }
+    size_t size(void) const { return data ? data->size() : 0; }
+    size_t position(void) const { return pos; }
+    bool seek(uint32_t p) {
+        if (!data || p > data->size()) {
+            return false;
+        }
+        pos = p;
+        return true;
+    }
+    size_t read(uint8_t* buf, size_t len) {
+        if (!data || pos >= data->size()) {
+            return 0;
+        }
+        size_t n = len < data->size() - pos ? len : data->size() - pos;
+        memcpy(buf, data->data() + pos, n);
+        pos += n;
+        return n;
+    }
+    size_t write(const uint8_t* buf, size_t len);
+    void close(void) { data = NULL; }
+
+private:
+    std::vector<uint8_t>* data = NULL;
+    size_t pos = 0;
+};
+
+class HostSD {
+public:
+    std::map<std::string, std::vector<uint8_t>> files;
+    std::set<std::string> dirs;
+    bool present = true;
+    uint32_t opens = 0;
+    uint64_t bytesWritten = 0;
+    int64_t writeBudget = -1;   // Bytes que aún se pueden escribir (-1: sin límite)
+
+    void reset(void) {
+        files.clear();
+        dirs.clear();
+        present = true;
+        opens = 0;
+        bytesWritten = 0;
+        writeBudget = -1;
+    }
+
+    uint64_t cardSize(void) { return present ? 4ULL << 30 : 0; }
+    bool exists(const char* path) { return files.count(path) || dirs.count(path); }
+    bool mkdir(const char* path) { return dirs.insert(path).second; }
+    bool remove(const char* path) { return files.erase(path) > 0; }
+
+    File open(const char* path, const char* mode = FILE_READ) {
+        if (!present) {
+            return File();
+        }
+        opens++;
+        auto it = files.find(path);
+        if (mode[0] == 'r') {
+            return it == files.end() ? File() : File(&it->second);
+        }
+        std::vector<uint8_t>& data = files[path];
+        if (mode[0] == 'w') {
+            data.clear();
+        }
+        File f(&data);
+        f.seek(data.size());
+        return f;
+    }
+};
+
+inline HostSD SD;
+
+inline size_t File::write(const uint8_t* buf, size_t len) {
+    if (!data) {
+        return 0;
+    }
+    if (SD.writeBudget >= 0 && (int64_t)len > SD.writeBudget) {
+        len = (size_t)SD.writeBudget;
+    }
+    if (SD.writeBudget >= 0) {
+        SD.writeBudget -= len;
+    }
+    // Solo se anexa: sd_logger y writeFile() no reescriben en medio
+    data->insert(data->end(), buf, buf + len);
+    pos = data->size();
+    SD.bytesWritten += len;
+    return len;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file      Wire.h
+ * @brief     Sustituto de Wire.h para las pruebas en el host: bus I2C simulado
+ *
+ * Cada bus responde (endTransmission() == 0) en las direcciones marcadas
+ * en devices y cuenta las transacciones. Una transacción solo con la
+ * dirección avanza el reloj simulado lo que tarda a 100 kHz.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#define TWOWIRE_SIM_ADDRESS_US 100  // START + dirección + ACK + STOP a 100 kHz
+
+class TwoWire {
+public:
+    uint32_t devices[4] = {};   // Bit n: responde la dirección n
+    uint32_t transactions = 0;
+
+    void attach(uint8_t addr) { devices[addr >> 5] |= 1UL << (addr & 31); }
+    void detach(uint8_t addr) { devices[addr >> 5] &= ~(1UL << (addr & 31)); }
+    void reset(void) {
+        memset(devices, 0, sizeof(devices));
+        transactions = 0;
+    }
+
+    void beginTransmission(uint8_t addr) { current = addr; }
+    uint8_t endTransmission(bool stop = true) {
+        (void)stop;
+        transactions++;
+        host_clock_us += TWOWIRE_SIM_ADDRESS_US;
+        return (current < 128 && (devices[current >> 5] & (1UL << (current & 31)))) ? 0 : 2;  // 2: NACK de dirección
+    }
+
+private:
+    uint8_t current = 0;
+};
+
+inline TwoWire Wire;
+inline TwoWire Wire1;
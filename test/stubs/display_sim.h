@@ -0,0 +1,113 @@
+/**
+ * @file      display_sim.h
+ * @brief     Pantalla SSD1306 simulada para las pruebas en el host
+ *
+ * Sin ARDUINO, U8x8lib.cpp no define el backend I2C ni el de GPIO que usan
+ * las clases *_HW_I2C (DISPLAY_MODEL). Aquí se definen como un backend nulo
+ * que solo cuenta transacciones y bytes, y display_sim_attach() engancha
+ * el callback del controlador para copiar cada DRAW_TILE en una RAM de
+ * pantalla simulada. Así se puede comparar lo que ve la pantalla con el
+ * buffer de U8g2 y guardar fotogramas en PBM con u8x8_capture.c.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <string.h>
+#include <string>
+#include <U8g2lib.h>
+
+#define DISPLAY_SIM_TILE_WIDTH 16
+#define DISPLAY_SIM_TILE_HEIGHT 8
+
+struct DisplaySim {
+    uint8_t ram[DISPLAY_SIM_TILE_HEIGHT * DISPLAY_SIM_TILE_WIDTH * 8];  // Misma disposición que el buffer _F
+    uint32_t transactions;  // START_TRANSFER del backend de bytes
+    uint32_t bytes;         // Bytes enviados (comandos y datos)
+    uint32_t tiles;         // Tiles 8x8 recibidos por DRAW_TILE
+
+    void reset(void) {
+        memset(this, 0, sizeof(*this));
+    }
+
+    void clearCounters(void) {
+        transactions = bytes = tiles = 0;
+    }
+
+    /**
+     * @brief Tiempo de bus (µs) de lo contado: 9 bits por byte más dirección y START/STOP
+     */
+    double busMicros(uint32_t hz) const {
+        return (transactions * (2 + 9) + bytes * 9.0) * 1e6 / hz;
+    }
+};
+
+inline DisplaySim display_sim;
+
+extern "C" uint8_t u8x8_byte_arduino_hw_i2c(u8x8_t*, uint8_t msg, uint8_t arg_int, void*) {
+    if (msg == U8X8_MSG_BYTE_START_TRANSFER) {
+        display_sim.transactions++;
+    } else if (msg == U8X8_MSG_BYTE_SEND) {
+        display_sim.bytes += arg_int;
+    }
+    return 1;
+}
+
+extern "C" uint8_t u8x8_gpio_and_delay_arduino(u8x8_t*, uint8_t, uint8_t, void*) {
+    return 1;
+}
+
+inline u8x8_msg_cb display_sim_driver = nullptr;
+
+/**
+ * @brief Copia cada DRAW_TILE en la RAM simulada y delega en el controlador real
+ */
+inline uint8_t display_sim_display_cb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    if (msg == U8X8_MSG_DISPLAY_DRAW_TILE) {
+        const u8x8_tile_t* tile = (const u8x8_tile_t*)arg_ptr;
+        uint8_t x = tile->x_pos;
+        for (uint8_t r = 0; r < arg_int; r++) {
+            for (uint8_t i = 0; i < tile->cnt && x < DISPLAY_SIM_TILE_WIDTH; i++, x++) {
+                memcpy(&display_sim.ram[(tile->y_pos * DISPLAY_SIM_TILE_WIDTH + x) * 8], tile->tile_ptr + i * 8, 8);
+                display_sim.tiles++;
+            }
+        }
+    }
+    return display_sim_driver(u8x8, msg, arg_int, arg_ptr);
+}
+
+/**
+ * @brief Inicializa la pantalla sobre el simulador con la RAM en blanco
+ */
+inline void display_sim_attach(U8G2& display) {
+    u8x8_t* u8x8 = display.getU8x8();
+    if (u8x8->display_cb != display_sim_display_cb) {
+        display_sim_driver = u8x8->display_cb;
+        u8x8->display_cb = display_sim_display_cb;
+    }
+    display_sim.reset();
+    display.begin();
+    display_sim.clearCounters();
+}
+
+/**
+ * @brief true si la RAM simulada coincide con el buffer completo de U8g2
+ */
+inline bool display_sim_matches(U8G2& display) {
+    return memcmp(display_sim.ram, display.getBufferPtr(), sizeof(display_sim.ram)) == 0;
+}
+
+/**
+ * @brief Fotograma visible (RAM simulada) como PBM P1 de 128x64
+ */
+inline std::string display_sim_pbm(void) {
+    static std::string out;
+    out.clear();
+    u8x8_capture_write_pbm_pre(DISPLAY_SIM_TILE_WIDTH, DISPLAY_SIM_TILE_HEIGHT, [](const char* s) { out += s; });
+    u8x8_capture_write_pbm_buffer(display_sim.ram, DISPLAY_SIM_TILE_WIDTH, DISPLAY_SIM_TILE_HEIGHT,
+                                  u8x8_capture_get_pixel_1, [](const char* s) { out += s; });
+    return out;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file      esp_partition.h
+ * @brief     Sustituto de esp_partition.h para las pruebas en el host: flash en RAM
+ *
+ * Las particiones que la prueba crea con host_partition_add() empiezan
+ * borradas (0xFF). Como en la flash NOR, escribir solo puede pasar bits de
+ * 1 a 0 y borrar pone a 0xFF un sector entero. host_flash_write_budget
+ * simula un corte de alimentación: la escritura que lo agota programa solo
+ * los bytes que quedan y devuelve error, y las siguientes no escriben nada
+ * hasta que la prueba lo vuelve a poner a -1.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_SIZE 0x104
+
+#define HOST_FLASH_SECTOR_BYTES 4096
+
+typedef enum {
+    ESP_PARTITION_TYPE_APP = 0x00,
+    ESP_PARTITION_TYPE_DATA = 0x01,
+} esp_partition_type_t;
+
+typedef enum {
+    ESP_PARTITION_SUBTYPE_DATA_OTA = 0x00,
+    ESP_PARTITION_SUBTYPE_DATA_PHY = 0x01,
+    ESP_PARTITION_SUBTYPE_DATA_NVS = 0x02,
+    ESP_PARTITION_SUBTYPE_ANY = 0xff,
+} esp_partition_subtype_t;
+
+typedef struct {
+    esp_partition_type_t type;
+    esp_partition_subtype_t subtype;
+    uint32_t address;
+    uint32_t size;
+    char label[17];
+    bool encrypted;
+} esp_partition_t;
+
+struct host_partition_t {
+    esp_partition_t info;
+    std::vector<uint8_t> data;
+    uint32_t erases = 0;        // Sectores borrados
+    uint32_t bytesWritten = 0;
+};
+
+inline std::map<std::string, host_partition_t> host_partitions;
+inline int64_t host_flash_write_budget = -1;  // Bytes que aún se programan (-1: sin límite)
+
+inline host_partition_t& host_partition_add(const char* label, esp_partition_type_t type, int subtype,
+                                            uint32_t size) {
+    host_partition_t& p = host_partitions[label];
+    p.info = {};
+    p.info.type = type;
+    p.info.subtype = (esp_partition_subtype_t)subtype;
+    p.info.size = size;
+    strlcpy(p.info.label, label, sizeof(p.info.label));
+    p.data.assign(size, 0xFF);
+    p.erases = 0;
+    p.bytesWritten = 0;
+    return p;
+}
+
+inline host_partition_t* host_partition_of(const esp_partition_t* part) {
+    return part ? &host_partitions.at(part->label) : NULL;
+}
+
+inline const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                       const char* label) {
+    for (auto& it : host_partitions) {
+        const esp_partition_t& info = it.second.info;
+        if (info.type == type && (subtype == ESP_PARTITION_SUBTYPE_ANY || info.subtype == subtype) &&
+            (label == NULL || it.first == label)) {
+            return &info;
+        }
+    }
+    return NULL;
+}
+
+inline esp_err_t esp_partition_read(const esp_partition_t* part, size_t offset, void* dst, size_t size) {
+    host_partition_t* p = host_partition_of(part);
+    if (!p || offset + size > p->data.size()) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memcpy(dst, p->data.data() + offset, size);
+    return ESP_OK;
+}
+
+inline esp_err_t esp_partition_write(const esp_partition_t* part, size_t offset, const void* src, size_t size) {
+    host_partition_t* p = host_partition_of(part);
+    if (!p || offset + size > p->data.size()) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    const uint8_t* s = (const uint8_t*)src;
+    for (size_t i = 0; i < size; i++) {
+        if (host_flash_write_budget == 0) {
+            return ESP_FAIL;
+        }
+        if (host_flash_write_budget > 0) {
+            host_flash_write_budget--;
+        }
+        p->data[offset + i] &= s[i];
+        p->bytesWritten++;
+    }
+    return ESP_OK;
+}
+
+inline esp_err_t esp_partition_erase_range(const esp_partition_t* part, size_t offset, size_t size) {
+    host_partition_t* p = host_partition_of(part);
+    if (!p || offset % HOST_FLASH_SECTOR_BYTES || size % HOST_FLASH_SECTOR_BYTES ||
+        offset + size > p->data.size()) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (host_flash_write_budget == 0) {
+        return ESP_FAIL;
+    }
+    memset(p->data.data() + offset, 0xFF, size);
+    p->erases += size / HOST_FLASH_SECTOR_BYTES;
+    return ESP_OK;
+}
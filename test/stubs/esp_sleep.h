@@ -0,0 +1,32 @@
+/**
+ * @file      esp_sleep.h
+ * @brief     Sustituto de esp_sleep.h para las pruebas en el host
+ *
+ * Solo la causa del despertar: la prueba la fija en host_wakeup_cause para
+ * simular un arranque en frío (ESP_SLEEP_WAKEUP_UNDEFINED, memoria RTC
+ * perdida) o un despertar del sueño profundo (ESP_SLEEP_WAKEUP_TIMER).
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+typedef enum {
+    ESP_SLEEP_WAKEUP_UNDEFINED = 0,
+    ESP_SLEEP_WAKEUP_ALL,
+    ESP_SLEEP_WAKEUP_EXT0,
+    ESP_SLEEP_WAKEUP_EXT1,
+    ESP_SLEEP_WAKEUP_TIMER,
+    ESP_SLEEP_WAKEUP_TOUCHPAD,
+    ESP_SLEEP_WAKEUP_ULP,
+    ESP_SLEEP_WAKEUP_GPIO,
+    ESP_SLEEP_WAKEUP_UART,
+} esp_sleep_wakeup_cause_t;
+
+inline esp_sleep_wakeup_cause_t host_wakeup_cause = ESP_SLEEP_WAKEUP_UNDEFINED;
+
+inline esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause(void) {
+    return host_wakeup_cause;
+}
@@ -0,0 +1,16 @@
+/**
+ * @file      esp_timer.h
+ * @brief     Sustituto de esp_timer.h para las pruebas en el host: reloj simulado
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+inline int64_t esp_timer_get_time(void) {
+    return (int64_t)host_clock_us;
+}
@@ -0,0 +1,26 @@
+/**
+ * @file      FreeRTOS.h
+ * @brief     Sustituto de freertos/FreeRTOS.h para las pruebas en el host
+ *
+ * Solo los tipos y constantes que necesitan los módulos para compilar;
+ * las tareas y los grupos de eventos están en task.h y event_groups.h.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))  // Tick de 1 ms, como CONFIG_FREERTOS_HZ=1000
@@ -0,0 +1,75 @@
+/**
+ * @file      event_groups.h
+ * @brief     Sustituto de freertos/event_groups.h para las pruebas en el host
+ *
+ * Grupos de eventos sobre las tareas de task.h: una espera que no se
+ * cumple bloquea la tarea hasta que otra pone los bits o vence el plazo
+ * en el reloj simulado. Poner bits no cede el turno (misma prioridad).
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include "task.h"
+
+typedef uint32_t EventBits_t;
+
+struct host_event_group_t {
+    EventBits_t bits = 0;
+};
+
+typedef host_event_group_t* EventGroupHandle_t;
+
+inline EventGroupHandle_t xEventGroupCreate(void) {
+    return new host_event_group_t();
+}
+
+inline EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits) {
+    std::lock_guard<std::mutex> lock(host_sched_mutex);
+    group->bits |= bits;
+    return group->bits;
+}
+
+inline EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits) {
+    std::lock_guard<std::mutex> lock(host_sched_mutex);
+    const EventBits_t before = group->bits;
+    group->bits &= ~bits;
+    return before;
+}
+
+inline EventBits_t xEventGroupGetBits(EventGroupHandle_t group) {
+    std::lock_guard<std::mutex> lock(host_sched_mutex);
+    return group->bits;
+}
+
+inline EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit,
+                                       BaseType_t waitForAll, TickType_t ticks) {
+    // Se evalúa con host_sched_mutex tomado (desde host_task_schedule() o aquí)
+    auto met = [group, bits, waitForAll] {
+        const EventBits_t set = group->bits & bits;
+        return waitForAll ? set == bits : set != 0;
+    };
+    {
+        std::lock_guard<std::mutex> lock(host_sched_mutex);
+        if (met() || ticks == 0) {
+            const EventBits_t value = group->bits;
+            if (clearOnExit && met()) {
+                group->bits &= ~bits;
+            }
+            return value;
+        }
+    }
+    const uint64_t deadline = ticks == portMAX_DELAY ? HOST_NO_DEADLINE
+                                                     : host_clock_us + (uint64_t)ticks * 1000;
+    host_task_block(deadline, met);
+
+    std::lock_guard<std::mutex> lock(host_sched_mutex);
+    const EventBits_t value = group->bits;
+    if (clearOnExit && met()) {
+        group->bits &= ~bits;
+    }
+    return value;
+}
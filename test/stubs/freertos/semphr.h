@@ -0,0 +1,36 @@
+/**
+ * @file      semphr.h
+ * @brief     Sustituto de freertos/semphr.h para las pruebas en el host
+ *
+ * Mutex sin efecto (pruebas de un solo hilo) que cuenta tomas y
+ * liberaciones para comprobar que cada camino libera lo que toma.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+struct host_semaphore_t {
+    int32_t held = 0;
+};
+
+typedef host_semaphore_t* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return new host_semaphore_t();
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+    (void)ticks;
+    sem->held++;
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    sem->held--;
+    return pdTRUE;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file      task.h
+ * @brief     Sustituto de freertos/task.h para las pruebas en el host: tareas en tiempo simulado
+ *
+ * Cada tarea es un hilo, pero solo corre una a la vez: la que está en
+ * marcha sigue hasta que se bloquea (host_task_busy_ms(), una espera en un
+ * grupo de eventos o vTaskDelete()). Entonces pasa el turno a la siguiente
+ * tarea lista, por orden de creación; si todas esperan, el reloj simulado
+ * (host_clock_us) salta al primer plazo que vence. Así varias tareas que
+ * "ocupan" su periférico a la vez avanzan el reloj lo que la más larga, no
+ * la suma, y el resultado no depende del planificador del PC.
+ *
+ * El hilo que llama por primera vez pasa a ser una tarea más. Núcleo y
+ * prioridad se ignoran.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include "FreeRTOS.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef void (*TaskFunction_t)(void*);
+typedef struct host_task_t* TaskHandle_t;
+
+#define HOST_NO_DEADLINE UINT64_MAX
+
+struct host_task_t {
+    const char* name;
+    uint64_t deadlineUs = HOST_NO_DEADLINE;  // Plazo de la espera en curso
+    std::function<bool()> ready;             // Condición de la espera en curso (vacía: solo plazo)
+};
+
+// Salida de la tarea con vTaskDelete(NULL): deshace la pila hasta host_task_entry()
+struct host_task_exit {};
+
+inline std::mutex host_sched_mutex;
+inline std::condition_variable host_sched_cv;
+inline std::vector<host_task_t*> host_tasks;    // Tareas vivas, por orden de creación
+inline host_task_t* host_running = nullptr;
+inline thread_local host_task_t* host_self = nullptr;
+
+/**
+ * @brief Tarea del hilo que llama; el primer hilo que entra queda registrado en marcha
+ */
+inline host_task_t* host_task_current(void) {
+    if (!host_self) {
+        host_self = new host_task_t{"main"};
+        host_tasks.push_back(host_self);
+        if (!host_running) {
+            host_running = host_self;
+        }
+    }
+    return host_self;
+}
+
+/**
+ * @brief Elige la siguiente tarea lista, avanzando el reloj si todas esperan (con el mutex tomado)
+ */
+inline void host_task_schedule(size_t from) {
+    for (;;) {
+        uint64_t next = HOST_NO_DEADLINE;
+        for (size_t k = 0; k < host_tasks.size(); k++) {
+            host_task_t* t = host_tasks[(from + k) % host_tasks.size()];
+            if ((t->ready && t->ready()) || host_clock_us >= t->deadlineUs) {
+                host_running = t;
+                host_sched_cv.notify_all();
+                return;
+            }
+            if (t->deadlineUs < next) {
+                next = t->deadlineUs;
+            }
+        }
+        if (next == HOST_NO_DEADLINE) {
+            fprintf(stderr, "freertos/task.h: todas las tareas esperan sin plazo\n");
+            abort();
+        }
+        host_clock_us = next;
+    }
+}
+
+/**
+ * @brief Bloquea la tarea actual hasta que se cumple ready() o vence el plazo
+ *
+ * @return true si se cumplió la condición, false si venció el plazo
+ */
+inline bool host_task_block(uint64_t deadlineUs, std::function<bool()> ready = nullptr) {
+    std::unique_lock<std::mutex> lock(host_sched_mutex);
+    host_task_t* me = host_task_current();
+    me->deadlineUs = deadlineUs;
+    me->ready = ready;
+    size_t index = 0;
+    while (host_tasks[index] != me) {
+        index++;
+    }
+    host_task_schedule(index + 1);  // Las demás primero: turno rotatorio
+    host_sched_cv.wait(lock, [me] { return host_running == me; });
+    me->deadlineUs = HOST_NO_DEADLINE;
+    me->ready = nullptr;
+    return !ready || ready();
+}
+
+/**
+ * @brief La tarea actual ocupa su periférico durante ms milisegundos simulados
+ */
+inline void host_task_busy_ms(uint32_t ms) {
+    host_task_block(host_clock_us + (uint64_t)ms * 1000);
+}
+
+inline void host_task_entry(host_task_t* self, TaskFunction_t fn, void* arg) {
+    {
+        std::unique_lock<std::mutex> lock(host_sched_mutex);
+        host_self = self;
+        host_sched_cv.wait(lock, [self] { return host_running == self; });
+    }
+    try {
+        fn(arg);
+    } catch (const host_task_exit&) {
+    }
+}
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                                          UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+    (void)stack;
+    (void)priority;
+    (void)core;
+    host_task_t* t;
+    {
+        std::lock_guard<std::mutex> lock(host_sched_mutex);
+        host_task_current();
+        t = new host_task_t{name};
+        t->ready = [] { return true; };  // Lista para correr en cuanto le toque
+        host_tasks.push_back(t);
+    }
+    if (handle) {
+        *handle = t;
+    }
+    std::thread(host_task_entry, t, fn, arg).detach();
+    return pdPASS;
+}
+
+inline UBaseType_t uxTaskPriorityGet(TaskHandle_t task) {
+    (void)task;
+    return 1;
+}
+
+/**
+ * @brief Solo vTaskDelete(NULL): la tarea termina y pasa el turno
+ */
+inline void vTaskDelete(TaskHandle_t task) {
+    (void)task;
+    {
+        std::lock_guard<std::mutex> lock(host_sched_mutex);
+        host_task_t* me = host_task_current();
+        size_t index = 0;
+        while (host_tasks[index] != me) {
+            index++;
+        }
+        host_tasks.erase(host_tasks.begin() + index);
+        delete me;
+        host_self = nullptr;
+        host_task_schedule(index);
+    }
+    throw host_task_exit();
+}
@@ -0,0 +1,183 @@
+"""
+Genera test/stubs/host_font.h: una fuente ASCII 5x7 codificada en el
+formato de fuente de U8g2 para las pruebas en el host.
+
+La copia de U8g2 de lib/ no trae los datos de fuentes (u8g2_fonts.c), así
+que las pruebas enlazan esta fuente con el nombre de SCREEN_FONT
+(u8g2_font_ncenB08_tr). Las imágenes de referencia de test/ usan por tanto
+esta fuente y no la del firmware: validan el layout y detectan cambios, no
+el aspecto final.
+
+Uso: python test/stubs/gen_host_font.py
+"""
+
+import os
+
+# Fuente 5x7 clásica, una columna por byte, bit 0 arriba (0x20 a 0x7E)
+GLYPHS_5X7 = [
+    (0x00, 0x00, 0x00, 0x00, 0x00), (0x00, 0x00, 0x5F, 0x00, 0x00), (0x00, 0x07, 0x00, 0x07, 0x00),
+    (0x14, 0x7F, 0x14, 0x7F, 0x14), (0x24, 0x2A, 0x7F, 0x2A, 0x12), (0x23, 0x13, 0x08, 0x64, 0x62),
+    (0x36, 0x49, 0x56, 0x20, 0x50), (0x00, 0x05, 0x03, 0x00, 0x00), (0x00, 0x1C, 0x22, 0x41, 0x00),
+    (0x00, 0x41, 0x22, 0x1C, 0x00), (0x2A, 0x1C, 0x7F, 0x1C, 0x2A), (0x08, 0x08, 0x3E, 0x08, 0x08),
+    (0x00, 0x50, 0x30, 0x00, 0x00), (0x08, 0x08, 0x08, 0x08, 0x08), (0x00, 0x60, 0x60, 0x00, 0x00),
+    (0x20, 0x10, 0x08, 0x04, 0x02), (0x3E, 0x51, 0x49, 0x45, 0x3E), (0x00, 0x42, 0x7F, 0x40, 0x00),
+    (0x72, 0x49, 0x49, 0x49, 0x46), (0x21, 0x41, 0x49, 0x4D, 0x33), (0x18, 0x14, 0x12, 0x7F, 0x10),
+    (0x27, 0x45, 0x45, 0x45, 0x39), (0x3C, 0x4A, 0x49, 0x49, 0x31), (0x41, 0x21, 0x11, 0x09, 0x07),
+    (0x36, 0x49, 0x49, 0x49, 0x36), (0x46, 0x49, 0x49, 0x29, 0x1E), (0x00, 0x36, 0x36, 0x00, 0x00),
+    (0x00, 0x56, 0x36, 0x00, 0x00), (0x08, 0x14, 0x22, 0x41, 0x00), (0x14, 0x14, 0x14, 0x14, 0x14),
+    (0x00, 0x41, 0x22, 0x14, 0x08), (0x02, 0x01, 0x59, 0x09, 0x06), (0x3E, 0x41, 0x5D, 0x59, 0x4E),
+    (0x7C, 0x12, 0x11, 0x12, 0x7C), (0x7F, 0x49, 0x49, 0x49, 0x36), (0x3E, 0x41, 0x41, 0x41, 0x22),
+    (0x7F, 0x41, 0x41, 0x41, 0x3E), (0x7F, 0x49, 0x49, 0x49, 0x41), (0x7F, 0x09, 0x09, 0x09, 0x01),
+    (0x3E, 0x41, 0x41, 0x51, 0x73), (0x7F, 0x08, 0x08, 0x08, 0x7F), (0x00, 0x41, 0x7F, 0x41, 0x00),
+    (0x20, 0x40, 0x41, 0x3F, 0x01), (0x7F, 0x08, 0x14, 0x22, 0x41), (0x7F, 0x40, 0x40, 0x40, 0x40),
+    (0x7F, 0x02, 0x1C, 0x02, 0x7F), (0x7F, 0x04, 0x08, 0x10, 0x7F), (0x3E, 0x41, 0x41, 0x41, 0x3E),
+    (0x7F, 0x09, 0x09, 0x09, 0x06), (0x3E, 0x41, 0x51, 0x21, 0x5E), (0x7F, 0x09, 0x19, 0x29, 0x46),
+    (0x26, 0x49, 0x49, 0x49, 0x32), (0x03, 0x01, 0x7F, 0x01, 0x03), (0x3F, 0x40, 0x40, 0x40, 0x3F),
+    (0x1F, 0x20, 0x40, 0x20, 0x1F), (0x3F, 0x40, 0x38, 0x40, 0x3F), (0x63, 0x14, 0x08, 0x14, 0x63),
+    (0x03, 0x04, 0x78, 0x04, 0x03), (0x61, 0x59, 0x49, 0x4D, 0x43), (0x00, 0x7F, 0x41, 0x41, 0x41),
+    (0x02, 0x04, 0x08, 0x10, 0x20), (0x00, 0x41, 0x41, 0x41, 0x7F), (0x04, 0x02, 0x01, 0x02, 0x04),
+    (0x40, 0x40, 0x40, 0x40, 0x40), (0x00, 0x03, 0x07, 0x08, 0x00), (0x20, 0x54, 0x54, 0x78, 0x40),
+    (0x7F, 0x28, 0x44, 0x44, 0x38), (0x38, 0x44, 0x44, 0x44, 0x28), (0x38, 0x44, 0x44, 0x28, 0x7F),
+    (0x38, 0x54, 0x54, 0x54, 0x18), (0x00, 0x08, 0x7E, 0x09, 0x02), (0x0C, 0x52, 0x52, 0x52, 0x3E),
+    (0x7F, 0x08, 0x04, 0x04, 0x78), (0x00, 0x44, 0x7D, 0x40, 0x00), (0x20, 0x40, 0x40, 0x3D, 0x00),
+    (0x7F, 0x10, 0x28, 0x44, 0x00), (0x00, 0x41, 0x7F, 0x40, 0x00), (0x7C, 0x04, 0x78, 0x04, 0x78),
+    (0x7C, 0x08, 0x04, 0x04, 0x78), (0x38, 0x44, 0x44, 0x44, 0x38), (0x7C, 0x14, 0x14, 0x14, 0x08),
+    (0x08, 0x14, 0x14, 0x18, 0x7C), (0x7C, 0x08, 0x04, 0x04, 0x08), (0x48, 0x54, 0x54, 0x54, 0x24),
+    (0x04, 0x04, 0x3F, 0x44, 0x24), (0x3C, 0x40, 0x40, 0x20, 0x7C), (0x1C, 0x20, 0x40, 0x20, 0x1C),
+    (0x3C, 0x40, 0x30, 0x40, 0x3C), (0x44, 0x28, 0x10, 0x28, 0x44), (0x0C, 0x50, 0x50, 0x50, 0x3C),
+    (0x44, 0x64, 0x54, 0x4C, 0x44), (0x00, 0x08, 0x36, 0x41, 0x00), (0x00, 0x00, 0x7F, 0x00, 0x00),
+    (0x00, 0x41, 0x36, 0x08, 0x00), (0x02, 0x01, 0x02, 0x04, 0x02),
+]
+
+WIDTH = 5
+HEIGHT = 7
+ADVANCE = 6
+
+# Anchos de campo del flujo de bits de cada glifo (ver u8g2_font_decode_glyph())
+BITS_0 = 4
+BITS_1 = 4
+BITS_W = 4
+BITS_H = 4
+BITS_X = 2
+BITS_Y = 2
+BITS_DX = 4
+
+HEADER_SIZE = 23  # U8G2_FONT_DATA_STRUCT_SIZE
+
+
+class BitWriter:
+    """Escribe campos LSB primero, como los lee u8g2_font_decode_get_unsigned_bits()"""
+
+    def __init__(self):
+        self.data = bytearray()
+        self.pos = 0
+
+    def put(self, value, bits):
+        for i in range(bits):
+            if self.pos == 0:
+                self.data.append(0)
+            if value >> i & 1:
+                self.data[-1] |= 1 << self.pos
+            self.pos = (self.pos + 1) % 8
+
+    def put_signed(self, value, bits):
+        self.put(value + (1 << (bits - 1)), bits)
+
+
+def runs(columns):
+    """Pares (ceros, unos) recorriendo el glifo por filas"""
+    pixels = [columns[x] >> y & 1 for y in range(HEIGHT) for x in range(WIDTH)]
+    pairs = []
+    i = 0
+    max0 = (1 << BITS_0) - 1
+    max1 = (1 << BITS_1) - 1
+    while i < len(pixels):
+        zeros = 0
+        while i < len(pixels) and pixels[i] == 0 and zeros < max0:
+            zeros += 1
+            i += 1
+        ones = 0
+        if zeros < max0 or i == len(pixels) or pixels[i] == 1:
+            while i < len(pixels) and pixels[i] == 1 and ones < max1:
+                ones += 1
+                i += 1
+        pairs.append((zeros, ones))
+    return pairs
+
+
+def encode_glyph(code, columns):
+    bits = BitWriter()
+    blank = not any(columns)
+    bits.put(0 if blank else WIDTH, BITS_W)
+    bits.put(0 if blank else HEIGHT, BITS_H)
+    bits.put_signed(0, BITS_X)
+    bits.put_signed(0, BITS_Y)
+    bits.put_signed(ADVANCE, BITS_DX)
+    if not blank:
+        for zeros, ones in runs(columns):
+            bits.put(zeros, BITS_0)
+            bits.put(ones, BITS_1)
+            bits.put(0, 1)  # Sin repetición
+    return bytes([code, len(bits.data) + 2]) + bytes(bits.data)
+
+
+def build_font():
+    glyphs = bytearray()
+    start_a_upper = start_a_lower = 0
+    for i, columns in enumerate(GLYPHS_5X7):
+        code = 0x20 + i
+        if code == ord("A"):
+            start_a_upper = len(glyphs)
+        if code == ord("a"):
+            start_a_lower = len(glyphs)
+        glyphs += encode_glyph(code, columns)
+    glyphs += b"\x00\x00"  # Fin de la tabla ASCII
+    start_unicode = len(glyphs)
+    glyphs += bytes([0x00, 0x04, 0xFF, 0xFF])  # Tabla de búsqueda Unicode vacía
+    glyphs += b"\x00\x00"
+
+    header = bytes([
+        len(GLYPHS_5X7), 0, BITS_0, BITS_1, BITS_W, BITS_H, BITS_X, BITS_Y, BITS_DX,
+        WIDTH, HEIGHT, 0, 0,
+        HEIGHT, 0, HEIGHT, 0,
+        start_a_upper >> 8, start_a_upper & 0xFF,
+        start_a_lower >> 8, start_a_lower & 0xFF,
+        start_unicode >> 8, start_unicode & 0xFF,
+    ])
+    assert len(header) == HEADER_SIZE
+    return header + glyphs
+
+
+def main():
+    font = build_font()
+    lines = []
+    for i in range(0, len(font), 16):
+        lines.append("    " + ", ".join("0x%02X" % b for b in font[i:i + 16]) + ",")
+    out = os.path.join(os.path.dirname(os.path.abspath(__file__)), "host_font.h")
+    with open(out, "w") as f:
+        f.write("""/**
+ * @file      host_font.h
+ * @brief     Fuente ASCII 5x7 en formato U8g2 para las pruebas en el host
+ *
+ * Generado por test/stubs/gen_host_font.py: no editar. La copia de U8g2 de
+ * lib/ no incluye datos de fuentes; este fichero define u8g2_font_ncenB08_tr
+ * (SCREEN_FONT) con una fuente 5x7 para que screen.cpp y las pruebas de
+ * U8g2 enlacen en el PC.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <u8g2.h>
+
+extern "C" const uint8_t u8g2_font_ncenB08_tr[%d] = {
+%s
+};
+""" % (len(font), "\n".join(lines)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,156 @@
+/**
+ * @file      gps_uart_sim.h
+ * @brief     UART del GPS simulada con un receptor L76K o UBlox al otro lado
+ *
+ * Sustituye a SerialGPS. El receptor responde a la petición de versión del
+ * L76K ($PCAS06) con $GPTXT, al sondeo UBX-CFG-RATE con la trama CFG-RATE y
+ * al resto de comandos UBX-CFG con ACK-ACK, siempre GPS_SIM_REPLY_US después
+ * y solo si la UART está a su velocidad y ya ha arrancado (readyAtUs del
+ * reloj simulado). Lo que recibe antes de arrancar se pierde, como en el
+ * receptor real, y también lo que recibe sin alimentación (powered()).
+ * El comando de reposo ($PCAS12 del L76K, UBX-RXM-PMREQ de UBlox) se
+ * anota en standby, y sendFix() programa una posición RMC.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <deque>
+#include <string>
+#include <utility>
+
+#define GPS_SIM_REPLY_US 20000  // Respuesta del receptor (incluida la transmisión)
+#define SERIAL_8N1 0x800001c
+
+typedef enum {
+    GPS_SIM_NONE,
+    GPS_SIM_L76K,
+    GPS_SIM_UBLOX
+} gps_sim_model_t;
+
+class HardwareSerial {
+public:
+    gps_sim_model_t model = GPS_SIM_NONE;
+    uint32_t receiverBaud = 9600;
+    uint64_t readyAtUs = 0;     // Instante en que el receptor termina de arrancar
+    uint32_t baud = 9600;
+    uint32_t lost = 0;          // Comandos que el receptor no pudo atender
+    uint32_t replies = 0;
+    bool standby = false;       // Recibió el comando de reposo
+    bool (*powered)(void) = nullptr;  // Raíl principal encendido (nullptr: siempre)
+
+    void connect(gps_sim_model_t m, uint32_t b, uint64_t readyAt) {
+        model = m;
+        receiverBaud = b;
+        readyAtUs = readyAt;
+        rx.clear();
+        lost = replies = 0;
+        standby = false;
+    }
+
+    /**
+     * @brief El receptor entrega una posición RMC válida en el instante atUs
+     */
+    void sendFix(uint64_t atUs) {
+        sendNmea("GPRMC,081836.00,A,4807.03800,N,01131.00000,E,0.0,360.0,130998,,", atUs);
+    }
+
+    void begin(uint32_t b, ...) { baud = b; }
+    void updateBaudRate(uint32_t b) { baud = b; }
+    void flush(void) {}
+
+    size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t write(const uint8_t* data, size_t len) {
+        reply(data, len);
+        return len;
+    }
+
+    int available(void) {
+        int n = 0;
+        for (const auto& b : rx) {
+            if (b.first > host_clock_us) break;
+            n++;
+        }
+        return n;
+    }
+    int read(void) {
+        if (!available()) return -1;
+        uint8_t c = rx.front().second;
+        rx.pop_front();
+        return c;
+    }
+    size_t read(uint8_t* buf, size_t len) {
+        size_t n = 0;
+        while (n < len && available()) {
+            buf[n++] = (uint8_t)read();
+        }
+        return n;
+    }
+
+private:
+    std::deque<std::pair<uint64_t, uint8_t>> rx;  // Instante de llegada y byte
+
+    void send(const std::string& bytes, uint64_t at = 0) {
+        if (at == 0) {
+            at = host_clock_us + GPS_SIM_REPLY_US;
+        }
+        for (char c : bytes) {
+            rx.push_back({at, (uint8_t)c});
+        }
+        replies++;
+    }
+
+    void sendNmea(const char* body, uint64_t at = 0) {
+        uint8_t x = 0;
+        for (const char* p = body; *p; p++) x ^= (uint8_t)*p;
+        char tail[8];
+        snprintf(tail, sizeof(tail), "*%02X\r\n", x);
+        send(std::string("$") + body + tail, at);
+    }
+
+    void sendUbx(uint8_t cls, uint8_t id, const uint8_t* payload, uint16_t len) {
+        std::string f = {(char)0xB5, 0x62, (char)cls, (char)id, (char)(len & 0xFF), (char)(len >> 8)};
+        f.append((const char*)payload, len);
+        uint8_t a = 0, b = 0;
+        for (size_t i = 2; i < f.size(); i++) {
+            a += (uint8_t)f[i];
+            b += a;
+        }
+        f += (char)a;
+        f += (char)b;
+        send(f);
+    }
+
+    void reply(const uint8_t* data, size_t len) {
+        if (model == GPS_SIM_NONE) {
+            return;
+        }
+        if (baud != receiverBaud || host_clock_us < readyAtUs || (powered && !powered())) {
+            lost++;
+            return;
+        }
+        if (model == GPS_SIM_L76K && len > 7 && memcmp(data, "$PCAS06", 7) == 0) {
+            sendNmea("GPTXT,01,01,02,SW=URANUS5,V5.3.0.0");
+        } else if (model == GPS_SIM_L76K && len > 7 && memcmp(data, "$PCAS12", 7) == 0) {
+            standby = true;
+        } else if (model == GPS_SIM_UBLOX && len >= 8 && data[0] == 0xB5 && data[1] == 0x62 &&
+                   data[2] == 0x02 && data[3] == 0x41) {
+            standby = true;
+        } else if (model == GPS_SIM_UBLOX && len >= 8 && data[0] == 0xB5 && data[1] == 0x62 && data[2] == 0x06) {
+            if (data[3] == 0x08 && data[4] == 0 && data[5] == 0) {
+                const uint8_t rate[6] = {0xE8, 0x03, 0x01, 0x00, 0x01, 0x00};
+                sendUbx(0x06, 0x08, rate, sizeof(rate));
+            } else {
+                const uint8_t ack[2] = {data[2], data[3]};
+                sendUbx(0x05, 0x01, ack, sizeof(ack));
+            }
+        }
+    }
+};
+
+inline HardwareSerial Serial1;
+#define SerialGPS Serial1
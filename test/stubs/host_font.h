@@ -0,0 +1,101 @@
+/**
+ * @file      host_font.h
+ * @brief     Fuente ASCII 5x7 en formato U8g2 para las pruebas en el host
+ *
+ * Generado por test/stubs/gen_host_font.py: no editar. La copia de U8g2 de
+ * lib/ no incluye datos de fuentes; este fichero define u8g2_font_ncenB08_tr
+ * (SCREEN_FONT) con una fuente 5x7 para que screen.cpp y las pruebas de
+ * U8g2 enlacen en el PC.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <u8g2.h>
+
+extern "C" const uint8_t u8g2_font_ncenB08_tr[1281] = {
+    0x5F, 0x00, 0x04, 0x04, 0x04, 0x04, 0x02, 0x02, 0x04, 0x05, 0x07, 0x00, 0x00, 0x07, 0x00, 0x07,
+    0x00, 0x01, 0xA5, 0x03, 0x5C, 0x04, 0xE4, 0x20, 0x04, 0x00, 0xEA, 0x21, 0x0C, 0x75, 0xEA, 0x12,
+    0x28, 0x50, 0xA0, 0x40, 0x21, 0x83, 0x00, 0x22, 0x0D, 0x75, 0xEA, 0x11, 0x22, 0x48, 0x88, 0x20,
+    0x21, 0xC2, 0x03, 0x03, 0x23, 0x13, 0x75, 0xEA, 0x11, 0x22, 0x48, 0x88, 0x10, 0x25, 0x42, 0x84,
+    0x28, 0x11, 0x22, 0x48, 0x88, 0x10, 0x00, 0x24, 0x0D, 0x75, 0xEA, 0x12, 0xA6, 0x44, 0x98, 0x31,
+    0x21, 0xCA, 0x04, 0x01, 0x25, 0x0F, 0x75, 0xEA, 0x20, 0x46, 0x48, 0x98, 0x30, 0x61, 0xC2, 0x04,
+    0x11, 0x23, 0x00, 0x26, 0x12, 0x75, 0xEA, 0x11, 0x26, 0x44, 0x90, 0x10, 0x61, 0xC2, 0x84, 0x08,
+    0x21, 0x24, 0x88, 0x88, 0x00, 0x27, 0x0A, 0x75, 0xEA, 0x21, 0x28, 0x4C, 0x78, 0x80, 0x00, 0x28,
+    0x0D, 0x75, 0xEA, 0x13, 0x26, 0x4C, 0xA0, 0x40, 0xA1, 0x42, 0x85, 0x00, 0x29, 0x0D, 0x75, 0xEA,
+    0x11, 0x2A, 0x54, 0xA0, 0x40, 0x61, 0xC2, 0x84, 0x01, 0x2A, 0x12, 0x75, 0xEA, 0x12, 0x24, 0x44,
+    0x88, 0x10, 0x23, 0x4A, 0x8C, 0x08, 0x11, 0x22, 0x48, 0x10, 0x00, 0x2B, 0x0B, 0x75, 0xEA, 0x17,
+    0x28, 0x48, 0x91, 0x40, 0xE1, 0x00, 0x2C, 0x0A, 0x75, 0xEA, 0x0F, 0x4C, 0x50, 0x98, 0x30, 0x00,
+    0x2D, 0x07, 0x75, 0xEA, 0x5F, 0x1E, 0x00, 0x2E, 0x09, 0x75, 0xEA, 0x0F, 0x56, 0x8C, 0x10, 0x00,
+    0x2F, 0x0B, 0x75, 0xEA, 0x19, 0x26, 0x4C, 0x98, 0x30, 0x21, 0x01, 0x30, 0x10, 0x75, 0xEA, 0x31,
+    0x22, 0x8C, 0x90, 0x11, 0x21, 0x86, 0x88, 0x09, 0x31, 0x02, 0x00, 0x31, 0x0D, 0x75, 0xEA, 0x12,
+    0x46, 0x50, 0xA0, 0x40, 0x81, 0xC2, 0x8C, 0x00, 0x32, 0x0D, 0x75, 0xEA, 0x31, 0x22, 0x4C, 0xA0,
+    0x10, 0x23, 0x02, 0x05, 0x2A, 0x33, 0x0D, 0x75, 0xEA, 0x50, 0x28, 0x4C, 0x18, 0x51, 0x62, 0x42,
+    0x8C, 0x00, 0x34, 0x10, 0x75, 0xEA, 0x13, 0x46, 0x48, 0x88, 0x10, 0x41, 0x42, 0x94, 0x09, 0x14,
+    0x02, 0x00, 0x35, 0x0C, 0x75, 0xEA, 0x60, 0x88, 0x54, 0x20, 0x31, 0x21, 0x46, 0x00, 0x36, 0x0F,
+    0x75, 0xEA, 0x32, 0x22, 0x4C, 0x20, 0x12, 0x61, 0xC4, 0x84, 0x18, 0x01, 0x00, 0x37, 0x0D, 0x75,
+    0xEA, 0x50, 0x28, 0x50, 0x98, 0x30, 0x61, 0xC2, 0x04, 0x02, 0x38, 0x10, 0x75, 0xEA, 0x31, 0x22,
+    0x8C, 0x98, 0x10, 0x23, 0xC2, 0x88, 0x09, 0x31, 0x02, 0x00, 0x39, 0x0F, 0x75, 0xEA, 0x31, 0x22,
+    0x8C, 0x98, 0x10, 0x84, 0xC2, 0x84, 0x18, 0x02, 0x00, 0x3A, 0x0A, 0x75, 0xEA, 0x26, 0x46, 0xA0,
+    0x18, 0x71, 0x00, 0x3B, 0x0B, 0x75, 0xEA, 0x26, 0x46, 0xA0, 0xA0, 0x30, 0x61, 0x00, 0x3C, 0x0D,
+    0x75, 0xEA, 0x13, 0x26, 0x4C, 0x98, 0x50, 0xA1, 0x42, 0x85, 0x00, 0x3D, 0x08, 0x75, 0xEA, 0x5A,
+    0xAA, 0x28, 0x00, 0x3E, 0x0D, 0x75, 0xEA, 0x11, 0x2A, 0x54, 0xA8, 0x30, 0x61, 0xC2, 0x84, 0x01,
+    0x3F, 0x0D, 0x75, 0xEA, 0x31, 0x22, 0x4C, 0xA0, 0x20, 0x62, 0x42, 0x06, 0x01, 0x40, 0x0F, 0x75,
+    0xEA, 0x31, 0x22, 0x8C, 0x88, 0x10, 0x22, 0x48, 0x88, 0x08, 0x45, 0x00, 0x41, 0x0D, 0x75, 0xEA,
+    0x12, 0x26, 0x44, 0x88, 0x30, 0x62, 0xCE, 0x88, 0x09, 0x42, 0x0D, 0x75, 0xEA, 0x40, 0x22, 0x8C,
+    0x98, 0x12, 0x61, 0xC4, 0x94, 0x00, 0x43, 0x0F, 0x75, 0xEA, 0x31, 0x22, 0x8C, 0xA0, 0x40, 0x81,
+    0xC2, 0x84, 0x18, 0x01, 0x00, 0x44, 0x0D, 0x75, 0xEA, 0x40, 0x22, 0x8C, 0x18, 0x31, 0x62, 0xC4,
+    0x94, 0x00, 0x45, 0x0B, 0x75, 0xEA, 0x60, 0x28, 0x10, 0x89, 0x40, 0x81, 0x0A, 0x46, 0x0C, 0x75,
+    0xEA, 0x60, 0x28, 0x10, 0x89, 0x40, 0x81, 0x02, 0x01, 0x47, 0x0C, 0x75, 0xEA, 0x51, 0x46, 0x50,
+    0xA0, 0x20, 0x63, 0x42, 0x10, 0x48, 0x0C, 0x75, 0xEA, 0x10, 0x46, 0x8C, 0x98, 0x33, 0x62, 0xC4,
+    0x04, 0x49, 0x0D, 0x75, 0xEA, 0x31, 0x26, 0x50, 0xA0, 0x40, 0x81, 0xC2, 0x8C, 0x00, 0x4A, 0x0F,
+    0x75, 0xEA, 0x32, 0x26, 0x50, 0xA0, 0x40, 0x21, 0x82, 0x04, 0x11, 0x02, 0x00, 0x4B, 0x12, 0x75,
+    0xEA, 0x10, 0x46, 0x48, 0x88, 0x10, 0x41, 0xC4, 0x84, 0x08, 0x12, 0x24, 0x44, 0x98, 0x00, 0x4C,
+    0x0C, 0x75, 0xEA, 0x10, 0x28, 0x50, 0xA0, 0x40, 0x81, 0x02, 0x15, 0x4D, 0x11, 0x75, 0xEA, 0x10,
+    0x66, 0xC4, 0x88, 0x10, 0x22, 0x42, 0x88, 0x08, 0x21, 0x46, 0x4C, 0x00, 0x4E, 0x0F, 0x75, 0xEA,
+    0x10, 0x46, 0xCC, 0x10, 0x11, 0x21, 0x84, 0x8C, 0x11, 0x13, 0x00, 0x4F, 0x0F, 0x75, 0xEA, 0x31,
+    0x22, 0x8C, 0x18, 0x31, 0x62, 0xC4, 0x84, 0x18, 0x01, 0x00, 0x50, 0x0D, 0x75, 0xEA, 0x40, 0x22,
+    0x8C, 0x98, 0x12, 0x81, 0x02, 0x05, 0x02, 0x51, 0x10, 0x75, 0xEA, 0x31, 0x22, 0x8C, 0x18, 0x31,
+    0x22, 0x42, 0x08, 0x09, 0x22, 0x22, 0x00, 0x52, 0x10, 0x75, 0xEA, 0x40, 0x22, 0x8C, 0x98, 0x12,
+    0x21, 0x82, 0x04, 0x09, 0x11, 0x26, 0x00, 0x53, 0x0D, 0x75, 0xEA, 0x31, 0x22, 0x8C, 0xA8, 0x51,
+    0x62, 0x42, 0x8C, 0x00, 0x54, 0x0F, 0x75, 0xEA, 0x60, 0x22, 0x44, 0x90, 0x40, 0x81, 0x02, 0x05,
+    0x0A, 0x02, 0x00, 0x55, 0x0F, 0x75, 0xEA, 0x10, 0x46, 0x8C, 0x18, 0x31, 0x62, 0xC4, 0x84, 0x18,
+    0x01, 0x00, 0x56, 0x10, 0x75, 0xEA, 0x10, 0x46, 0x8C, 0x18, 0x31, 0x62, 0x42, 0x84, 0x08, 0x13,
+    0x04, 0x00, 0x57, 0x13, 0x75, 0xEA, 0x10, 0x46, 0x8C, 0x18, 0x11, 0x21, 0x44, 0x84, 0x10, 0x11,
+    0x22, 0x44, 0x88, 0x10, 0x00, 0x58, 0x11, 0x75, 0xEA, 0x10, 0x46, 0x4C, 0x88, 0x10, 0x61, 0xC2,
+    0x84, 0x08, 0x11, 0x46, 0x4C, 0x00, 0x59, 0x10, 0x75, 0xEA, 0x10, 0x46, 0x4C, 0x88, 0x10, 0x61,
+    0x02, 0x05, 0x0A, 0x14, 0x04, 0x00, 0x5A, 0x0C, 0x75, 0xEA, 0x50, 0x28, 0x4C, 0x90, 0x21, 0x61,
+    0x02, 0x15, 0x5B, 0x0C, 0x75, 0xEA, 0x41, 0x22, 0x50, 0xA0, 0x40, 0x81, 0x02, 0x11, 0x5C, 0x0B,
+    0x75, 0xEA, 0x15, 0x2A, 0x54, 0xA8, 0x50, 0xA1, 0x00, 0x5D, 0x0C, 0x75, 0xEA, 0x41, 0x28, 0x50,
+    0xA0, 0x40, 0x81, 0x42, 0x10, 0x5E, 0x0C, 0x75, 0xEA, 0x12, 0x26, 0x44, 0x88, 0x30, 0xE1, 0x41,
+    0x01, 0x5F, 0x07, 0x75, 0xEA, 0x0F, 0xBE, 0x00, 0x60, 0x0B, 0x75, 0xEA, 0x21, 0x46, 0x50, 0xA8,
+    0xF0, 0x20, 0x00, 0x61, 0x0B, 0x75, 0xEA, 0x2B, 0x2A, 0xC8, 0x88, 0x20, 0x41, 0x08, 0x62, 0x10,
+    0x75, 0xEA, 0x10, 0x28, 0x50, 0x08, 0x11, 0x42, 0xC4, 0x0C, 0x11, 0x21, 0x02, 0x00, 0x63, 0x0C,
+    0x75, 0xEA, 0x3B, 0x22, 0x8C, 0xA0, 0x30, 0x21, 0x46, 0x00, 0x64, 0x0F, 0x75, 0xEA, 0x14, 0x28,
+    0x84, 0x08, 0x21, 0x63, 0x84, 0x88, 0x10, 0x11, 0x00, 0x65, 0x0A, 0x75, 0xEA, 0x3B, 0x22, 0xCC,
+    0xA9, 0x11, 0x00, 0x66, 0x0F, 0x75, 0xEA, 0x13, 0x26, 0x44, 0x90, 0x30, 0x63, 0x02, 0x05, 0x0A,
+    0x02, 0x00, 0x67, 0x0C, 0x75, 0xEA, 0x56, 0x46, 0x4C, 0x08, 0x42, 0x21, 0x46, 0x00, 0x68, 0x0F,
+    0x75, 0xEA, 0x10, 0x28, 0x50, 0x08, 0x11, 0x42, 0xC4, 0x88, 0x11, 0x13, 0x00, 0x69, 0x0C, 0x75,
+    0xEA, 0x12, 0x50, 0x50, 0xA0, 0x40, 0x61, 0x46, 0x00, 0x6A, 0x0D, 0x75, 0xEA, 0x13, 0x32, 0x50,
+    0xA0, 0x10, 0x41, 0x82, 0x08, 0x01, 0x6B, 0x12, 0x75, 0xEA, 0x10, 0x28, 0x50, 0x90, 0x10, 0x21,
+    0x82, 0x88, 0x09, 0x11, 0x24, 0x48, 0x08, 0x00, 0x6C, 0x0D, 0x75, 0xEA, 0x21, 0x28, 0x50, 0xA0,
+    0x40, 0x81, 0xC2, 0x8C, 0x00, 0x6D, 0x11, 0x75, 0xEA, 0x2A, 0x22, 0x44, 0x88, 0x10, 0x22, 0x42,
+    0x88, 0x08, 0x21, 0x22, 0x44, 0x00, 0x6E, 0x0C, 0x75, 0xEA, 0x1A, 0x42, 0x84, 0x10, 0x31, 0x62,
+    0xC4, 0x04, 0x6F, 0x0C, 0x75, 0xEA, 0x3B, 0x22, 0x8C, 0x18, 0x31, 0x21, 0x46, 0x00, 0x70, 0x0B,
+    0x75, 0xEA, 0x4A, 0x22, 0x4C, 0x89, 0x40, 0x81, 0x00, 0x71, 0x0B, 0x75, 0xEA, 0x2B, 0x42, 0x88,
+    0x08, 0x42, 0x81, 0x02, 0x72, 0x0C, 0x75, 0xEA, 0x1A, 0x42, 0x84, 0x10, 0x41, 0x81, 0x02, 0x01,
+    0x73, 0x09, 0x75, 0xEA, 0x5B, 0x6A, 0x54, 0x09, 0x00, 0x74, 0x0F, 0x75, 0xEA, 0x12, 0x28, 0x48,
+    0x91, 0x40, 0x81, 0x42, 0x84, 0x09, 0x01, 0x00, 0x75, 0x0C, 0x75, 0xEA, 0x1A, 0x46, 0x8C, 0x18,
+    0x21, 0x22, 0x44, 0x04, 0x76, 0x0D, 0x75, 0xEA, 0x1A, 0x46, 0x8C, 0x98, 0x10, 0x21, 0xC2, 0x04,
+    0x01, 0x77, 0x10, 0x75, 0xEA, 0x1A, 0x46, 0x8C, 0x88, 0x10, 0x22, 0x42, 0x84, 0x08, 0x11, 0x02,
+    0x00, 0x78, 0x0F, 0x75, 0xEA, 0x1A, 0x26, 0x44, 0x88, 0x30, 0x61, 0x42, 0x84, 0x08, 0x13, 0x00,
+    0x79, 0x0C, 0x75, 0xEA, 0x1A, 0x46, 0x4C, 0x08, 0x42, 0x21, 0x46, 0x00, 0x7A, 0x0A, 0x75, 0xEA,
+    0x5A, 0x26, 0x4C, 0x98, 0x30, 0x05, 0x7B, 0x0D, 0x75, 0xEA, 0x13, 0x26, 0x50, 0x98, 0x50, 0x81,
+    0x42, 0x85, 0x00, 0x7C, 0x0D, 0x75, 0xEA, 0x12, 0x28, 0x50, 0xA0, 0x40, 0x81, 0x02, 0x05, 0x01,
+    0x7D, 0x0D, 0x75, 0xEA, 0x11, 0x2A, 0x50, 0xA8, 0x30, 0x81, 0xC2, 0x84, 0x01, 0x7E, 0x0C, 0x75,
+    0xEA, 0x11, 0x26, 0x44, 0x88, 0x30, 0xE1, 0x81, 0x01, 0x00, 0x00, 0x00, 0x04, 0xFF, 0xFF, 0x00,
+    0x00,
+};
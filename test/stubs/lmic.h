@@ -0,0 +1,58 @@
+/**
+ * @file      lmic.h
+ * @brief     Sustituto de lmic.h para las pruebas en el host
+ *
+ * Tipos básicos de LMIC y el subconjunto de lmic_t que leen y escriben los
+ * módulos probados. LMIC_setSession() copia la sesión como la biblioteca.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef HOST_LMIC_H
+#define HOST_LMIC_H
+
+#include <stdint.h>
+#include <string.h>
+
+typedef uint8_t u1_t;
+typedef int8_t s1_t;
+typedef uint16_t u2_t;
+typedef int16_t s2_t;
+typedef uint32_t u4_t;
+typedef int32_t s4_t;
+typedef uint8_t bit_t;
+typedef u4_t devaddr_t;
+typedef u1_t dr_t;
+
+enum {
+    OP_TXDATA   = 0x0008,  // Mismos valores que lib/LMIC
+    OP_TXRXPEND = 0x0080,
+};
+
+struct lmic_t {
+    u2_t opmode;
+    u4_t netid;
+    devaddr_t devaddr;
+    u1_t nwkKey[16];
+    u1_t artKey[16];
+    u4_t seqnoUp;
+    u4_t seqnoDn;
+    u2_t devNonce;
+    u1_t rxDelay;
+    dr_t dn2Dr;
+};
+
+inline lmic_t LMIC;
+
+inline void LMIC_setSession(u4_t netid, devaddr_t devaddr, const u1_t* nwkKey, const u1_t* artKey) {
+    LMIC.netid = netid;
+    LMIC.devaddr = devaddr;
+    memcpy(LMIC.nwkKey, nwkKey, sizeof(LMIC.nwkKey));
+    memcpy(LMIC.artKey, artKey, sizeof(LMIC.artKey));
+    LMIC.seqnoUp = 0;
+    LMIC.seqnoDn = 0;
+}
+
+#endif // HOST_LMIC_H
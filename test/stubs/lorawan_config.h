@@ -0,0 +1,21 @@
+/**
+ * @file      lorawan_config.h
+ * @brief     Claves de prueba para [env:native] (ver config/lorawan_config_template.h)
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#ifndef LORAWAN_CONFIG_H
+#define LORAWAN_CONFIG_H
+
+#include <lmic.h>
+#include <Arduino.h>
+
+static const u1_t PROGMEM APPEUI[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+static const u1_t PROGMEM DEVEUI[8] = {0x70, 0xB3, 0xD5, 0x7E, 0xD0, 0x00, 0x00, 0x01};
+static const u1_t PROGMEM APPKEY[16] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6,
+                                        0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+
+#endif // LORAWAN_CONFIG_H
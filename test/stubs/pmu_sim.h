@@ -0,0 +1,232 @@
+/**
+ * @file      pmu_sim.h
+ * @brief     Banco de registros simulado del AXP192 y del AXP2101 para las pruebas en el host
+ *
+ * XPowersLib sin ARDUINO accede al PMU mediante dos callbacks de lectura y
+ * escritura; aquí se conectan a un array de 256 registros que cuenta las
+ * transacciones I2C (una por callback, sea de uno o de varios bytes).
+ * Los helpers codifican tensión, corrientes y contador de culombios con
+ * las mismas escalas que XPowersAXP192.tpp y XPowersAXP2101.tpp.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <XPowersLib.h>
+
+struct PmuSim {
+    uint8_t regs[256];
+    uint8_t model;          // XPOWERS_AXP192 o XPOWERS_AXP2101
+    uint32_t reads;         // Transacciones de lectura
+    uint32_t writes;        // Transacciones de escritura
+    uint32_t bytesRead;
+    uint32_t bytesWritten;
+    double chargeCoulomb;   // Contadores internos del AXP192 (cuentas) antes de truncar a 32 bits
+    double dischargeCoulomb;
+
+    void reset(uint8_t chip) {
+        memset(this, 0, sizeof(*this));
+        model = chip;
+        if (chip == XPOWERS_AXP2101) {
+            regs[XPOWERS_AXP2101_IC_TYPE] = XPOWERS_AXP2101_CHIP_ID;
+            regs[XPOWERS_AXP2101_ADC_CHANNEL_CTRL] = 0x0B;  // Valor tras el reset del chip
+        } else {
+            regs[XPOWERS_AXP192_IC_TYPE] = XPOWERS_AXP192_CHIP_ID;
+            regs[XPOWERS_AXP192_ADC_SPEED] = 0x80;  // 100 Hz
+            regs[XPOWERS_AXP192_ADC_EN1] = 0x83;    // Valor tras el reset del chip
+        }
+    }
+
+    void clearCounters(void) {
+        reads = writes = bytesRead = bytesWritten = 0;
+    }
+
+    uint32_t transactions(void) const {
+        return reads + writes;
+    }
+
+    void putH8L4(uint8_t reg, uint16_t raw) {
+        regs[reg] = raw >> 4;
+        regs[reg + 1] = raw & 0x0F;
+    }
+
+    void putH8L5(uint8_t reg, uint16_t raw) {
+        regs[reg] = raw >> 5;
+        regs[reg + 1] = raw & 0x1F;
+    }
+
+    void putHL8(uint8_t reg, uint16_t raw) {
+        regs[reg] = raw >> 8;
+        regs[reg + 1] = raw & 0xFF;
+    }
+
+    void setBit(uint8_t reg, uint8_t bit, bool on) {
+        regs[reg] = on ? (regs[reg] | (1 << bit)) : (regs[reg] & ~(1 << bit));
+    }
+
+    void setBattery(float volts, bool connected = true) {
+        const uint16_t mv = (uint16_t)(volts * 1000.0f + 0.5f);
+        if (model == XPOWERS_AXP2101) {
+            putHL8(XPOWERS_AXP2101_ADC_DATA_RELUST0, mv & 0x1FFF);
+            setBit(XPOWERS_AXP2101_STATUS1, 3, connected);
+            return;
+        }
+        putH8L4(XPOWERS_AXP192_BAT_AVERVOL_H8, (uint16_t)(volts * 1000.0f / XPOWERS_AXP192_BATT_VOLTAGE_STEP + 0.5f));
+        setBit(XPOWERS_AXP192_MODE_CHGSTATUS, 5, connected);
+    }
+
+    void setVbus(bool present, float volts = 5.0f) {
+        const uint16_t mv = present ? (uint16_t)(volts * 1000.0f + 0.5f) : 0;
+        if (model == XPOWERS_AXP2101) {
+            putHL8(XPOWERS_AXP2101_ADC_DATA_RELUST4, mv & 0x3FFF);
+            setBit(XPOWERS_AXP2101_STATUS1, 5, present);
+            setBit(XPOWERS_AXP2101_STATUS2, 3, false);
+            return;
+        }
+        putH8L4(XPOWERS_AXP192_VBUS_VOL_H8, (uint16_t)(mv / XPOWERS_AXP192_VBUS_VOLTAGE_STEP));
+        setBit(XPOWERS_AXP192_STATUS, 5, present);
+    }
+
+    void setSystem(float volts) {
+        const uint16_t mv = (uint16_t)(volts * 1000.0f + 0.5f);
+        if (model == XPOWERS_AXP2101) {
+            putHL8(XPOWERS_AXP2101_ADC_DATA_RELUST6, mv & 0x3FFF);
+            return;
+        }
+        putH8L4(XPOWERS_AXP192_APS_AVERVOL_H8, (uint16_t)(mv / XPOWERS_AXP192_APS_VOLTAGE_STEP));
+    }
+
+    /**
+     * @brief Temperatura interna con la escala de cada chip (solo valores que se representan exactos)
+     */
+    void setTemperature(float celsius) {
+        if (model == XPOWERS_AXP2101) {
+            putHL8(XPOWERS_AXP2101_ADC_DATA_RELUST8, (uint16_t)(7274 - (celsius - 22.0f) * 20.0f) & 0x3FFF);
+            return;
+        }
+        putH8L4(XPOWERS_AXP192_INTERNAL_TEMP_H8,
+                (uint16_t)((celsius + XPOWERS_AXP192_INERNAL_TEMP_OFFSET) / XPOWERS_AXP192_INTERNAL_TEMP_STEP + 0.5f));
+    }
+
+    /**
+     * @brief Corriente de batería en mA (positiva descargando, negativa cargando)
+     *
+     * El AXP2101 no mide corriente: solo cambia el estado de carga de STATUS2.
+     */
+    void setCurrent(float ma) {
+        const bool charging = ma < 0;
+        if (model == XPOWERS_AXP2101) {
+            regs[XPOWERS_AXP2101_STATUS2] = (regs[XPOWERS_AXP2101_STATUS2] & 0x1F) | ((charging ? 0x01 : 0x02) << 5);
+            return;
+        }
+        putH8L5(XPOWERS_AXP192_BAT_AVERCHGCUR_H8, charging ? (uint16_t)(-ma / XPOWERS_AXP192_BATT_CHARGE_CUR_STEP) : 0);
+        putH8L5(XPOWERS_AXP192_BAT_AVERDISCHGCUR_H8, charging ? 0 : (uint16_t)(ma / XPOWERS_AXP192_BATT_DISCHARGE_CUR_STEP));
+        setBit(XPOWERS_AXP192_STATUS, 2, charging);
+        setBit(XPOWERS_AXP192_MODE_CHGSTATUS, 6, charging);
+    }
+
+    /**
+     * @brief Cuentas por mAh a la frecuencia de ADC actual (inversa de getCoulombData())
+     */
+    double countsPerMah(void) const {
+        const int rate = 25 << ((regs[XPOWERS_AXP192_ADC_SPEED] & 0xC0) >> 6);
+        return 3600.0 * rate / (65536.0 * 0.5);
+    }
+
+    /**
+     * @brief Integra carga en el contador de culombios del AXP192 si está activo
+     *
+     * El contador solo avanza con el ADC de corriente de batería (bit 6 de
+     * ADC_EN1) encendido, igual que en el chip.
+     *
+     * @param mah Carga en mAh (positiva entrando en la batería)
+     */
+    void addCharge(double mah) {
+        if (model != XPOWERS_AXP192 ||
+            !(regs[XPOWERS_AXP192_COULOMB_CTL] & 0x80) || (regs[XPOWERS_AXP192_COULOMB_CTL] & 0x40) ||
+            !(regs[XPOWERS_AXP192_ADC_EN1] & 0x40)) {
+            return;
+        }
+        if (mah >= 0) chargeCoulomb += mah * countsPerMah();
+        else dischargeCoulomb += -mah * countsPerMah();
+        putU32(XPOWERS_AXP192_BAT_CHGCOULOMB3, (uint32_t)chargeCoulomb);
+        putU32(XPOWERS_AXP192_BAT_DISCHGCOULOMB3, (uint32_t)dischargeCoulomb);
+    }
+
+    void putU32(uint8_t reg, uint32_t v) {
+        regs[reg] = v >> 24;
+        regs[reg + 1] = v >> 16;
+        regs[reg + 2] = v >> 8;
+        regs[reg + 3] = v;
+    }
+
+    /**
+     * @brief Tiempo de bus (µs) de las transacciones contadas a una frecuencia SCL dada
+     *
+     * Cada transacción: START, byte de dirección, byte de registro y, en las
+     * lecturas, START repetido con un segundo byte de dirección; 9 bits por
+     * byte más los bits de START/STOP.
+     */
+    double busMicros(uint32_t hz) const {
+        const double bits = writes * (2 + 9 * 2) + reads * (3 + 9 * 3) + (bytesRead + bytesWritten) * 9.0;
+        return bits * 1e6 / hz;
+    }
+};
+
+inline PmuSim pmu_sim;
+
+inline int pmu_sim_read(uint8_t, uint8_t reg, uint8_t* data, uint8_t len) {
+    pmu_sim.reads++;
+    pmu_sim.bytesRead += len;
+    for (uint8_t i = 0; i < len; i++) data[i] = pmu_sim.regs[(uint8_t)(reg + i)];
+    return 0;
+}
+
+inline int pmu_sim_write(uint8_t, uint8_t reg, uint8_t* data, uint8_t len) {
+    pmu_sim.writes++;
+    pmu_sim.bytesWritten += len;
+    for (uint8_t i = 0; i < len; i++) pmu_sim.regs[(uint8_t)(reg + i)] = data[i];
+    // Bit 5 de COULOMB_CTL del AXP192: borra los contadores y vuelve a 0 solo
+    if (pmu_sim.model == XPOWERS_AXP192 &&
+        reg <= XPOWERS_AXP192_COULOMB_CTL && reg + len > XPOWERS_AXP192_COULOMB_CTL &&
+        (pmu_sim.regs[XPOWERS_AXP192_COULOMB_CTL] & 0x20)) {
+        pmu_sim.chargeCoulomb = pmu_sim.dischargeCoulomb = 0;
+        pmu_sim.putU32(XPOWERS_AXP192_BAT_CHGCOULOMB3, 0);
+        pmu_sim.putU32(XPOWERS_AXP192_BAT_DISCHGCOULOMB3, 0);
+        pmu_sim.regs[XPOWERS_AXP192_COULOMB_CTL] &= ~0x20;
+    }
+    return 0;
+}
+
+/**
+ * @brief Reinicia el simulador y devuelve un XPowersAXP192 inicializado como en beginPower()
+ */
+inline XPowersAXP192* pmu_sim_begin_axp192(void) {
+    static XPowersAXP192* pmu = new XPowersAXP192(AXP192_SLAVE_ADDRESS, pmu_sim_read, pmu_sim_write);
+    pmu_sim.reset(XPOWERS_AXP192);
+    pmu->init();
+    // Las mismas medidas que deja encendidas beginPower()
+    pmu->enableSystemVoltageMeasure();
+    pmu->enableVbusVoltageMeasure();
+    pmu->enableBattVoltageMeasure();
+    pmu_sim.clearCounters();
+    return pmu;
+}
+
+/**
+ * @brief Reinicia el simulador y devuelve un XPowersAXP2101 inicializado como en beginPower()
+ */
+inline XPowersAXP2101* pmu_sim_begin_axp2101(void) {
+    static XPowersAXP2101* pmu = new XPowersAXP2101(AXP2101_SLAVE_ADDRESS, pmu_sim_read, pmu_sim_write);
+    pmu_sim.reset(XPOWERS_AXP2101);
+    pmu->init();
+    // Las mismas medidas que deja encendidas beginPower()
+    pmu->enableSystemVoltageMeasure();
+    pmu->enableVbusVoltageMeasure();
+    pmu->enableBattVoltageMeasure();
+    pmu_sim.clearCounters();
+    return pmu;
+}
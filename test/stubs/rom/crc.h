@@ -0,0 +1,26 @@
+/**
+ * @file      crc.h
+ * @brief     Sustituto de rom/crc.h para las pruebas en el host
+ *
+ * Mismo CRC16 que la ROM del ESP32 (CCITT reflejado, 0x8408, con el valor
+ * inicial y el resultado invertidos).
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+inline uint16_t crc16_le(uint16_t crc, const uint8_t* buf, uint32_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : crc >> 1;
+        }
+    }
+    return ~crc;
+}
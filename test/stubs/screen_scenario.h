@@ -0,0 +1,118 @@
+/**
+ * @file      screen_scenario.h
+ * @brief     Secuencia de pantallas de screen.cpp e imágenes de referencia PBM
+ *
+ * La usan test_screen (buffer completo) y test_screen_page (buffer por
+ * páginas): las dos recorren los mismos pasos sobre la pantalla simulada y
+ * comparan lo que recibe el panel con las mismas imágenes de
+ * test/test_screen/golden/. Incluir antes que src/screen.cpp.
+ *
+ * Para regenerar las imágenes tras un cambio de diseño intencionado:
+ *
+ *     SCREEN_GOLDEN_UPDATE=1 pio test -e native -f test_screen
+ *
+ * Si una imagen no coincide se escribe la obtenida junto a ella como
+ * <nombre>.actual.pbm.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <string>
+#include "../../config/config.h"  // Placa (DISPLAY_MODEL) antes que LoRaBoards.h
+#include "display_sim.h"
+#include "host_font.h"
+#include "LoRaBoards.h"
+#include "screen.h"
+
+#define SCREEN_GOLDEN_DIR "test/test_screen/golden/"
+
+// Sin prototipo en screen.h; pgm_board.cpp la declara igual
+void turnOffDisplay();
+
+// Sin status_bitmaps_data.c: showStatus() dibuja los mensajes fijos con la fuente
+extern "C" const status_bitmap_t STATUS_BITMAPS[STATUS_MESSAGE_COUNT] = {};
+
+bool boot_mode_headless(void) {
+    return false;
+}
+
+bool beginDisplay() {
+    u8g2 = new DISPLAY_MODEL(U8G2_R0, U8X8_PIN_NONE);
+    display_sim_attach(*u8g2);
+    return true;
+}
+
+typedef struct {
+    const char* name;   /**< Imagen de referencia: SCREEN_GOLDEN_DIR<name>.pbm */
+    void (*run)(void);  /**< Llamadas a screen.cpp que producen el fotograma */
+} screen_step_t;
+
+static const screen_step_t SCREEN_STEPS[] = {
+    {"splash", [] { initDisplay(); }},
+    {"info", [] { showInfo("Enviando datos"); }},
+    {"warning_wrap", [] { showWarning("Bateria baja: se reduce la frecuencia de envio a una hora"); }},
+    {"sensor_data", [] { showSensorData(21.5f, 48.2f, 3.92f); }},
+    {"sensor_error", [] { showSensorData(-999.0f, -1.0f, 3.90f); }},
+    {"status_data_sent", [] { showStatus(STATUS_DATA_SENT, 5000); }},
+    {"indicators", [] { turnOffDisplay(); }},
+    {"error_expired", [] {
+         showError("Fallo de join", 3000);
+         delay(3001);
+         updateDisplay();
+     }},
+    {"off", [] { turnOffDisplayCompletely(); }},
+};
+
+#define SCREEN_STEP_COUNT (sizeof(SCREEN_STEPS) / sizeof(SCREEN_STEPS[0]))
+
+static std::string screen_read_file(const std::string& path) {
+    std::string out;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) {
+        return out;
+    }
+    char buf[512];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        out.append(buf, n);
+    }
+    fclose(f);
+    return out;
+}
+
+static void screen_write_file(const std::string& path, const std::string& data) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (f) {
+        fwrite(data.data(), 1, data.size(), f);
+        fclose(f);
+    }
+}
+
+/**
+ * @brief Compara el panel simulado con la imagen de referencia del paso
+ *
+ * @return Mensaje de error vacío si coinciden
+ */
+static std::string screen_check_golden(const char* name) {
+    const std::string path = std::string(SCREEN_GOLDEN_DIR) + name + ".pbm";
+    const std::string actual = display_sim_pbm();
+    if (getenv("SCREEN_GOLDEN_UPDATE")) {
+        screen_write_file(path, actual);
+        return "";
+    }
+    const std::string golden = screen_read_file(path);
+    if (golden.empty()) {
+        return path + " no existe (SCREEN_GOLDEN_UPDATE=1 para crearla)";
+    }
+    if (golden == actual) {
+        return "";
+    }
+    const std::string actualPath = std::string(SCREEN_GOLDEN_DIR) + name + ".actual.pbm";
+    screen_write_file(actualPath, actual);
+    return path + " distinta, obtenida en " + actualPath;
+}
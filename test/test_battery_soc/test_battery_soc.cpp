@@ -0,0 +1,217 @@
+/**
+ * @file      test_battery_soc.cpp
+ * @brief     Error de estimación del SoC frente a curvas de descarga
+ *
+ * Curvas de referencia de una celda 18650 NMC de 3000 mAh a 25 °C (valores
+ * típicos de hoja de datos, no medidas de esta placa): tensión en bornes
+ * cada 5 % de capacidad descargada a 0,2C (600 mA) y a 1C (3000 mA).
+ * Se comparan con el SoC real:
+ * - Tabla OCV con compensación de carga frente al mapeo lineal 3,0-4,2 V.
+ * - Conteo de culombios del AXP192 simulado, también con un error de
+ *   tensión fijo que la tabla OCV sola no puede corregir.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include "pmu_sim.h"
+#include "../../src/battery_soc.cpp"
+#include "../../src/pmu_status.cpp"
+
+// Tensión en bornes (mV) con el 100, 95, ..., 0 % de carga restante
+static const uint16_t DISCHARGE_02C_MV[] = {
+    4100, 4035, 3985, 3935, 3895, 3855, 3815, 3775, 3745, 3715, 3685,
+    3655, 3635, 3612, 3585, 3555, 3515, 3465, 3390, 3285, 3000
+};
+static const uint16_t DISCHARGE_1C_MV[] = {
+    3790, 3730, 3680, 3635, 3600, 3565, 3530, 3495, 3465, 3440, 3415,
+    3390, 3370, 3350, 3325, 3300, 3265, 3220, 3150, 3050, 2750
+};
+#define CURVE_POINTS (sizeof(DISCHARGE_02C_MV) / sizeof(DISCHARGE_02C_MV[0]))
+
+static float batteryVolts;
+
+float readBatteryVoltage() {
+    return batteryVolts;
+}
+
+/**
+ * @brief Mapeo lineal 3,0-4,2 V que usaba batteryPercentFromVoltage()
+ */
+static float linear_percent(float volts) {
+    return constrain((volts - 3.0f) / 1.2f * 100.0f, 0.0f, 100.0f);
+}
+
+typedef struct {
+    float maxError;
+    float meanError;
+} curve_error_t;
+
+/**
+ * @brief Error (puntos de %) de una estimación a lo largo de una curva
+ *
+ * Los extremos de la curva (0 % y 100 %) quedan fuera: ahí las curvas con
+ * carga se separan de la OCV por la polarización, no por la resistencia.
+ */
+static curve_error_t curve_error(const uint16_t* curve, float current_ma, bool linear) {
+    curve_error_t err = {0, 0};
+    int n = 0;
+    for (size_t i = 1; i + 1 < CURVE_POINTS; i++) {
+        const float truth = 100.0f - 5.0f * i;
+        const float volts = curve[i] / 1000.0f;
+        const float estimate = linear ? linear_percent(volts)
+                                      : battery_soc_from_ocv(battery_soc_compensate(volts, current_ma));
+        const float e = fabsf(estimate - truth);
+        if (e > err.maxError) err.maxError = e;
+        err.meanError += e;
+        n++;
+    }
+    err.meanError /= n;
+    return err;
+}
+
+static void report(const char* name, curve_error_t err) {
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%s: error máx %.1f, medio %.1f puntos", name, err.maxError, err.meanError);
+    TEST_MESSAGE(msg);
+}
+
+void setUp(void) {
+    memset(&state, 0, sizeof(state));
+    PMU = NULL;
+    pmu_status_invalidate();
+}
+
+void tearDown(void) {}
+
+void test_ocv_table_endpoints(void) {
+    TEST_ASSERT_EQUAL_UINT8(0, battery_soc_from_ocv(2.9f));
+    TEST_ASSERT_EQUAL_UINT8(100, battery_soc_from_ocv(4.25f));
+    TEST_ASSERT_EQUAL_UINT8(50, battery_soc_from_ocv(3.76f));
+}
+
+void test_compensation_sign(void) {
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 3.745f, battery_soc_compensate(3.7f, 300.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 3.655f, battery_soc_compensate(3.7f, -300.0f));
+}
+
+void test_discharge_curve_02c(void) {
+    curve_error_t ocv = curve_error(DISCHARGE_02C_MV, 600.0f, false);
+    curve_error_t linear = curve_error(DISCHARGE_02C_MV, 600.0f, true);
+    report("0,2C OCV+compensación", ocv);
+    report("0,2C lineal", linear);
+    TEST_ASSERT_LESS_OR_EQUAL(8.0, ocv.maxError);
+    TEST_ASSERT_LESS_OR_EQUAL(4.0, ocv.meanError);
+    TEST_ASSERT_GREATER_THAN(ocv.maxError * 2, linear.maxError);
+}
+
+void test_discharge_curve_1c(void) {
+    curve_error_t ocv = curve_error(DISCHARGE_1C_MV, 3000.0f, false);
+    curve_error_t uncompensated = curve_error(DISCHARGE_1C_MV, 0.0f, false);
+    curve_error_t linear = curve_error(DISCHARGE_1C_MV, 3000.0f, true);
+    report("1C OCV+compensación", ocv);
+    report("1C OCV sin compensar", uncompensated);
+    report("1C lineal", linear);
+    // A 1C la polarización ya pesa tanto como la resistencia interna: la
+    // compensación reduce el error a menos de la mitad pero no lo anula
+    TEST_ASSERT_GREATER_THAN(ocv.meanError * 2, uncompensated.meanError);
+    TEST_ASSERT_LESS_THAN(linear.meanError, ocv.meanError);
+    TEST_ASSERT_LESS_THAN(linear.maxError, ocv.maxError);
+}
+
+void test_estimate_without_pmu_uses_ocv(void) {
+    batteryVolts = 3.76f - BATTERY_AWAKE_CURRENT_MA * BATTERY_INTERNAL_RESISTANCE_MOHM / 1e6f;
+    TEST_ASSERT_EQUAL_UINT8(50, battery_soc_estimate());
+    TEST_ASSERT_FALSE(battery_soc_uses_coulomb_counter());
+}
+
+/**
+ * @brief Descarga a 0,2C con despertares cada 5 minutos y el AXP192 simulado
+ *
+ * @param offset Error fijo (V) de la tensión que lee el firmware
+ * @param ocvError Salida: error máximo de la tabla OCV sola
+ * @return Error máximo (puntos de %) de battery_soc_estimate()
+ */
+static float run_discharge(float offset, float* ocvError) {
+    PMU = pmu_sim_begin_axp192();
+    const float current = 600.0f;
+    const float capacity = BATTERY_CAPACITY_MAH;
+    const float hoursPerWake = 5.0f / 60.0f;
+
+    float maxError = 0;
+    *ocvError = 0;
+    for (float used = 0; used < capacity * 0.9f; used += current * hoursPerWake) {
+        const float truth = 100.0f * (1.0f - used / capacity);
+        // Interpolar la curva registrada en el punto actual
+        const float pos = used / capacity * 20.0f;
+        const int i = (int)pos;
+        const float mv = DISCHARGE_02C_MV[i] + (DISCHARGE_02C_MV[i + 1] - DISCHARGE_02C_MV[i]) * (pos - i);
+        batteryVolts = mv / 1000.0f + offset;
+        pmu_sim.setBattery(batteryVolts);
+        pmu_sim.setCurrent(current);
+        pmu_status_invalidate();  // Despertar nuevo: el estado del PMU se vuelve a leer
+
+        const float estimate = battery_soc_estimate();
+        const float ocvOnly = battery_soc_from_ocv(battery_soc_compensate(batteryVolts, current));
+        if (used > 0) {
+            TEST_ASSERT_TRUE(battery_soc_uses_coulomb_counter());
+            maxError = fmaxf(maxError, fabsf(estimate - truth));
+        }
+        *ocvError = fmaxf(*ocvError, fabsf(ocvOnly - truth));
+
+        pmu_sim.addCharge(-current * hoursPerWake);
+    }
+    return maxError;
+}
+
+void test_coulomb_counting_tracks_discharge(void) {
+    float ocvError;
+    const float error = run_discharge(0.0f, &ocvError);
+    char msg[128];
+    snprintf(msg, sizeof(msg), "culombios: máx %.1f puntos (OCV sola %.1f)", error, ocvError);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_OR_EQUAL(5.0, error);
+}
+
+/**
+ * @brief Con la tensión desplazada +60 mV (divisor o ADC mal calibrado) la
+ *        tabla OCV sola se equivoca en la meseta; el contador lo atenúa
+ */
+void test_coulomb_counting_attenuates_voltage_error(void) {
+    float ocvError;
+    const float error = run_discharge(0.060f, &ocvError);
+    char msg[128];
+    snprintf(msg, sizeof(msg), "culombios con +60 mV: máx %.1f puntos (OCV sola %.1f)", error, ocvError);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_THAN(ocvError, error);
+}
+
+void test_coulomb_counting_follows_charge(void) {
+    PMU = pmu_sim_begin_axp192();
+    batteryVolts = 3.70f;
+    pmu_sim.setBattery(batteryVolts);
+    pmu_sim.setCurrent(BATTERY_AWAKE_CURRENT_MA);
+    const uint8_t start = battery_soc_estimate();
+
+    // 300 mAh de carga solar (10 % de la capacidad) a tensión casi constante
+    pmu_sim.setCurrent(-200.0f);
+    pmu_sim.addCharge(300.0f);
+    pmu_status_invalidate();
+    const uint8_t charged = battery_soc_estimate();
+    TEST_ASSERT_GREATER_OR_EQUAL(start + 7, charged);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_ocv_table_endpoints);
+    RUN_TEST(test_compensation_sign);
+    RUN_TEST(test_discharge_curve_02c);
+    RUN_TEST(test_discharge_curve_1c);
+    RUN_TEST(test_estimate_without_pmu_uses_ocv);
+    RUN_TEST(test_coulomb_counting_tracks_discharge);
+    RUN_TEST(test_coulomb_counting_attenuates_voltage_error);
+    RUN_TEST(test_coulomb_counting_follows_charge);
+    return UNITY_END();
+}
@@ -0,0 +1,268 @@
+/**
+ * @file      test_deferred_output.cpp
+ * @brief     Salida diferida durante TX/RX y apertura de las ventanas RX1/RX2
+ *
+ * Radio simulada con LMIC sin interrupciones: el fin de TX se detecta al
+ * sondear DIO0 en una iteración del bucle y a partir de ese instante se
+ * programan RX1 (+1 s) y RX2 (+2 s), que también se abren en una iteración.
+ * El bucle emite la misma secuencia de log y pantalla que durante un envío,
+ * directamente (como antes) o con deferred_*(). Cada fotograma de pantalla
+ * bloquea 25 ms (bus I2C a 400 kHz) y Serial 87 µs por byte (115200 baudios
+ * con el FIFO lleno).
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include <string>
+#include <vector>
+#include "../../src/deferred_output.cpp"
+
+#define LOOP_STEP_US 1000           // os_runloop_once() y el resto de loop()
+#define DISPLAY_FRAME_US 25000      // sendBuffer() de 1024 bytes a 400 kHz
+#define SERIAL_US_PER_BYTE 87       // 115200 baudios
+#define AIRTIME_US 370000           // SF10, 125 kHz, 11 bytes de payload
+#define RX_DELAY_US 1000000         // RX1_DELAY; RX2 un segundo después
+#define RX_WINDOW_US 20000          // Ventana abierta sin preámbulo detectado
+
+// ---------------------------------------------------------------------------
+// Pantalla simulada: cada mensaje es un fotograma enviado por I2C
+
+static std::vector<std::string> trace;
+static int framesWhileBusy = 0;
+
+void showMessage(ScreenMessageType type, const char* text, uint32_t duration) {
+    trace.push_back(std::string("show:") + text);
+    framesWhileBusy += deferred_radio_busy();
+    delay(DISPLAY_FRAME_US / 1000);
+}
+
+void showStatus(StatusMessage id, uint32_t duration) {
+    trace.push_back("status:" + std::to_string(id));
+    framesWhileBusy += deferred_radio_busy();
+    delay(DISPLAY_FRAME_US / 1000);
+}
+
+static void markCall(void) {
+    trace.push_back("call");
+}
+
+// ---------------------------------------------------------------------------
+// Radio simulada
+
+typedef struct {
+    uint64_t txEnd;       // Fin real de la transmisión
+    uint64_t detected;    // Iteración en que se sondeó DIO0 tras el fin de TX
+    uint64_t rx1Open;
+    uint64_t rx2Open;
+    bool done;
+} radio_sim_t;
+
+static radio_sim_t radio;
+
+static void radio_start_tx(void) {
+    radio = {host_clock_us + AIRTIME_US, 0, 0, 0, false};
+    LMIC.opmode |= OP_TXRXPEND;
+}
+
+/**
+ * @brief Lo que hace os_runloop_once() con la radio en cada iteración
+ */
+static void radio_poll(void) {
+    const uint64_t now = host_clock_us;
+    if (!radio.detected && now >= radio.txEnd) {
+        radio.detected = now;
+    }
+    if (radio.detected && !radio.rx1Open && now >= radio.detected + RX_DELAY_US) {
+        radio.rx1Open = now;
+    }
+    if (radio.rx1Open && !radio.rx2Open && now >= radio.detected + 2 * RX_DELAY_US) {
+        radio.rx2Open = now;
+    }
+    if (radio.rx2Open && !radio.done && now >= radio.rx2Open + RX_WINDOW_US) {
+        LMIC.opmode &= ~OP_TXRXPEND;
+        radio.done = true;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Salida de la aplicación durante un envío
+
+static bool useDeferred;
+
+static void app_log(const char* text) {
+    if (useDeferred) {
+        deferred_log("%s", text);
+    } else {
+        Serial.println(text);
+    }
+}
+
+static void app_show(const char* text) {
+    if (useDeferred) {
+        deferred_show(MSG_INFO, text, 3000);
+    } else {
+        showMessage(MSG_INFO, text, 3000);
+    }
+}
+
+typedef struct {
+    uint32_t atMs;
+    bool display;
+    const char* text;
+} app_event_t;
+
+// do_send(), updateDisplay() y el log de sensores alrededor de un envío
+static const app_event_t EVENTS[] = {
+    {0, false, "Preparando datos del sensor para envío..."},
+    {0, false, "Enviando: Temp=21.50 C, Hum=48.00 %, Batt=3.92 V"},
+    {0, true, "Enviando datos"},
+    {150, false, "Sensor: 3 lecturas en ventana, media 21.47 C"},
+    {360, true, "Temp: 21.5 C"},
+    {980, true, "Hum: 48 %"},
+    {1990, false, "Bateria: 3.92 V (87 %)"},
+};
+
+#define EVENT_COUNT (sizeof(EVENTS) / sizeof(EVENTS[0]))
+
+typedef struct {
+    int64_t rx1LateUs;
+    int64_t rx2LateUs;
+    size_t serialBytes;
+    size_t frames;
+} run_result_t;
+
+static run_result_t run_transaction(bool deferred) {
+    useDeferred = deferred;
+    host_clock_us = 0;
+    Serial.bytes = 0;
+    trace.clear();
+    framesWhileBusy = 0;
+    LMIC.opmode = 0;
+
+    radio_start_tx();
+    const uint64_t start = host_clock_us;
+    size_t next = 0;
+    while (!radio.done || host_clock_us < radio.rx2Open + 500000) {
+        const size_t serialBefore = Serial.bytes;
+        radio_poll();
+        while (next < EVENT_COUNT && host_clock_us >= start + EVENTS[next].atMs * 1000ULL) {
+            if (EVENTS[next].display) {
+                app_show(EVENTS[next].text);
+            } else {
+                app_log(EVENTS[next].text);
+            }
+            next++;
+        }
+        deferred_drain();
+        host_clock_us += (Serial.bytes - serialBefore) * SERIAL_US_PER_BYTE + LOOP_STEP_US;
+    }
+
+    return {(int64_t)(radio.rx1Open - (radio.txEnd + RX_DELAY_US)),
+            (int64_t)(radio.rx2Open - (radio.txEnd + 2 * RX_DELAY_US)), Serial.bytes, trace.size()};
+}
+
+void setUp(void) {
+    LMIC.opmode = 0;
+    deferred_drain();
+    trace.clear();
+}
+
+void tearDown(void) {}
+
+/**
+ * @brief Las ventanas RX se abren a tiempo con la salida diferida
+ */
+void test_rx_windows_open_on_time(void) {
+    const run_result_t direct = run_transaction(false);
+    const run_result_t deferred = run_transaction(true);
+
+    char msg[200];
+    snprintf(msg, sizeof(msg), "RX1/RX2 tarde: directa %.1f/%.1f ms, diferida %.1f/%.1f ms (iteración %d ms)",
+             direct.rx1LateUs / 1000.0, direct.rx2LateUs / 1000.0, deferred.rx1LateUs / 1000.0,
+             deferred.rx2LateUs / 1000.0, LOOP_STEP_US / 1000);
+    TEST_MESSAGE(msg);
+
+    // Solo el redondeo a la iteración del bucle: sondeo del fin de TX y apertura
+    TEST_ASSERT_LESS_OR_EQUAL(2 * LOOP_STEP_US, deferred.rx1LateUs);
+    TEST_ASSERT_LESS_OR_EQUAL(2 * LOOP_STEP_US, deferred.rx2LateUs);
+    TEST_ASSERT_GREATER_THAN(DISPLAY_FRAME_US / 2, direct.rx1LateUs);
+    TEST_ASSERT_EQUAL_INT(0, framesWhileBusy);
+
+    // Misma salida, emitida después de la transacción
+    TEST_ASSERT_EQUAL_UINT32(direct.serialBytes, deferred.serialBytes);
+    TEST_ASSERT_EQUAL_UINT32(direct.frames, deferred.frames);
+}
+
+void test_free_radio_emits_immediately(void) {
+    deferred_show(MSG_INFO, "libre", 1000);
+    deferred_call(markCall);
+    TEST_ASSERT_EQUAL_UINT32(2, trace.size());
+    TEST_ASSERT_EQUAL_STRING("show:libre", trace[0].c_str());
+}
+
+/**
+ * @brief Lo encolado sale en orden y lo nuevo espera detrás aunque la radio ya esté libre
+ */
+void test_queue_preserves_order(void) {
+    LMIC.opmode |= OP_TXRXPEND;
+    deferred_show(MSG_INFO, "uno", 1000);
+    deferred_status(STATUS_DATA_SENT, 1000);
+    deferred_call(markCall);
+    deferred_drain();
+    TEST_ASSERT_EQUAL_UINT32(0, trace.size());
+
+    LMIC.opmode &= ~OP_TXRXPEND;
+    deferred_show(MSG_INFO, "dos", 1000);
+    TEST_ASSERT_EQUAL_UINT32(0, trace.size());
+    deferred_drain();
+
+    const char* expected[] = {"show:uno", "status:2", "call", "show:dos"};
+    TEST_ASSERT_EQUAL_UINT32(4, trace.size());
+    for (size_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_STRING(expected[i], trace[i].c_str());
+    }
+}
+
+/**
+ * @brief Con la cola llena se descartan log y pantalla, nunca las llamadas
+ *
+ * Con un solo núcleo nadie vacía la cola mientras la radio está ocupada:
+ * una llamada que no cabe en los huecos reservados emite lo más antiguo.
+ */
+void test_full_queue_keeps_calls(void) {
+    LMIC.opmode |= OP_TXRXPEND;
+    char text[8];
+    for (int i = 0; i < DEFERRED_QUEUE_SIZE; i++) {
+        snprintf(text, sizeof(text), "s%d", i);
+        deferred_show(MSG_INFO, text, 1000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(DEFERRED_CALL_RESERVE, dropped.load());
+    TEST_ASSERT_EQUAL_UINT32(0, trace.size());
+
+    for (int i = 0; i < DEFERRED_CALL_RESERVE + 2; i++) {
+        deferred_call(markCall);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, trace.size());  // Los dos mensajes más antiguos, a destiempo
+
+    LMIC.opmode &= ~OP_TXRXPEND;
+    deferred_drain();
+    const size_t shows = DEFERRED_QUEUE_SIZE - DEFERRED_CALL_RESERVE;
+    TEST_ASSERT_EQUAL_UINT32(shows + DEFERRED_CALL_RESERVE + 2, trace.size());
+    for (size_t i = 0; i < trace.size(); i++) {
+        snprintf(text, sizeof(text), "s%u", (unsigned)i);
+        TEST_ASSERT_EQUAL_STRING(i < shows ? (std::string("show:") + text).c_str() : "call", trace[i].c_str());
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, dropped.load());  // Informado al vaciar la cola
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_rx_windows_open_on_time);
+    RUN_TEST(test_free_radio_emits_immediately);
+    RUN_TEST(test_queue_preserves_order);
+    RUN_TEST(test_full_queue_keeps_calls);
+    return UNITY_END();
+}
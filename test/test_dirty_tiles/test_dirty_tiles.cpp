@@ -0,0 +1,175 @@
+/**
+ * @file      test_dirty_tiles.cpp
+ * @brief     Seguimiento de tiles modificados de U8g2 (U8G2_WITH_DIRTY_TILES)
+ *
+ * La pantalla simulada (display_sim.h) copia cada DRAW_TILE en su propia
+ * RAM. Tras cada updateDirty() esa RAM debe coincidir con el buffer de U8g2
+ * aunque solo se hayan enviado los tramos modificados. Se mide lo enviado
+ * frente a sendBuffer() con una secuencia aleatoria de primitivas, borrados
+ * y colores XOR.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include "display_sim.h"
+#include "host_font.h"
+
+#define FULL_FRAME_TILES (DISPLAY_SIM_TILE_WIDTH * DISPLAY_SIM_TILE_HEIGHT)
+#define I2C_HZ 800000
+
+static U8G2_SSD1306_128X64_NONAME_F_HW_I2C display(U8G2_R0);
+
+/**
+ * @brief Pantalla de mensaje como la de screen.cpp: cabecera y dos líneas
+ */
+static void draw_message(const char* header, const char* line) {
+    display.clearBuffer();
+    display.setFont(u8g2_font_ncenB08_tr);
+    display.drawStr(0, 10, header);
+    display.drawStr(0, 30, line);
+}
+
+static void draw_status_pixels(void) {
+    display.drawPixel(125, 1);
+    display.drawPixel(126, 1);
+    display.drawPixel(125, 2);
+    display.drawPixel(126, 2);
+}
+
+void setUp(void) {
+    display_sim_attach(display);
+}
+
+void tearDown(void) {}
+
+void test_first_frame_sends_only_drawn_tiles(void) {
+    draw_message("LoRaWAN", "Enviando datos");
+    display.updateDirty();
+    TEST_ASSERT_TRUE(display_sim_matches(display));
+    TEST_ASSERT_GREATER_THAN(0, display_sim.tiles);
+    TEST_ASSERT_LESS_THAN(FULL_FRAME_TILES, display_sim.tiles);
+}
+
+void test_status_pixels_send_one_tile(void) {
+    draw_message("LoRaWAN", "Enviando datos");
+    display.updateDirty();
+
+    // Nuevo mensaje: se reenvían los tiles borrados y los del texto nuevo
+    display_sim.clearCounters();
+    draw_message("LoRaWAN", "OK");
+    draw_status_pixels();
+    display.updateDirty();
+    TEST_ASSERT_TRUE(display_sim_matches(display));
+    const uint32_t messageTiles = display_sim.tiles;
+
+    // Solo los indicadores: un tile (8 bytes de datos)
+    display_sim.clearCounters();
+    display.setDrawColor(0);
+    draw_status_pixels();
+    display.setDrawColor(1);
+    display.updateDirty();
+    TEST_ASSERT_TRUE(display_sim_matches(display));
+    TEST_ASSERT_EQUAL_UINT32(1, display_sim.tiles);
+    const uint32_t statusBytes = display_sim.bytes;
+
+    display_sim.clearCounters();
+    display.sendBuffer();
+    TEST_ASSERT_EQUAL_UINT32(FULL_FRAME_TILES, display_sim.tiles);
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "mensaje nuevo %lu tiles, indicadores 1 tile / %lu bytes I2C, sendBuffer %lu bytes",
+             (unsigned long)messageTiles, (unsigned long)statusBytes, (unsigned long)display_sim.bytes);
+    TEST_MESSAGE(msg);
+}
+
+void test_clear_buffer_resends_previous_drawing(void) {
+    display.drawBox(40, 20, 30, 20);
+    display.updateDirty();
+    display.clearBuffer();
+    display_sim.clearCounters();
+    display.updateDirty();
+    TEST_ASSERT_TRUE(display_sim_matches(display));
+    TEST_ASSERT_GREATER_THAN(0, display_sim.tiles);
+
+    // Sin dibujar nada más no queda nada pendiente
+    display_sim.clearCounters();
+    display.updateDirty();
+    TEST_ASSERT_EQUAL_UINT32(0, display_sim.tiles);
+}
+
+void test_mark_all_dirty_sends_full_frame(void) {
+    display.drawPixel(0, 0);
+    display.updateDirty();
+    display_sim.clearCounters();
+    display.markAllDirty();
+    display.updateDirty();
+    TEST_ASSERT_EQUAL_UINT32(FULL_FRAME_TILES, display_sim.tiles);
+}
+
+/**
+ * @brief Secuencia aleatoria: la pantalla simulada coincide con el buffer en cada fotograma
+ */
+void test_random_frames_match_buffer(void) {
+    uint32_t seed = 2025;
+    auto rnd = [&seed](uint32_t n) {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) % n;
+    };
+    display.setFont(u8g2_font_ncenB08_tr);
+
+    const int frames = 400;
+    uint64_t dirtyTiles = 0, dirtyBytes = 0;
+    for (int f = 0; f < frames; f++) {
+        if (rnd(8) == 0) {
+            display.clearBuffer();
+        }
+        const int ops = 1 + rnd(4);
+        for (int i = 0; i < ops; i++) {
+            display.setDrawColor(rnd(3));  // 0, 1 o XOR
+            const int x = rnd(140) - 6, y = rnd(76) - 6;
+            switch (rnd(5)) {
+                case 0: display.drawPixel(x & 127, y & 63); break;
+                case 1: display.drawBox(x & 127, y & 63, 1 + rnd(40), 1 + rnd(20)); break;
+                case 2: display.drawLine(x & 127, y & 63, rnd(128), rnd(64)); break;
+                case 3: display.drawCircle(x & 127, y & 63, 1 + rnd(20)); break;
+                default: display.drawStr(x & 127, (y & 63) + 8, "Temp 21.5C"); break;
+            }
+        }
+        display.setDrawColor(1);
+        display_sim.clearCounters();
+        display.updateDirty();
+        dirtyTiles += display_sim.tiles;
+        dirtyBytes += display_sim.bytes;
+        if (!display_sim_matches(display)) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "fotograma %d distinto del buffer", f);
+            TEST_FAIL_MESSAGE(msg);
+        }
+    }
+
+    display_sim.clearCounters();
+    display.sendBuffer();
+    const uint32_t fullBytes = display_sim.bytes;
+    const double fullUs = display_sim.busMicros(I2C_HZ);
+
+    char msg[200];
+    snprintf(msg, sizeof(msg),
+             "%d fotogramas aleatorios: %.1f tiles y %.0f bytes por fotograma (sendBuffer: %d tiles, %lu bytes, %.0f us a %d kHz)",
+             frames, (double)dirtyTiles / frames, (double)dirtyBytes / frames, FULL_FRAME_TILES,
+             (unsigned long)fullBytes, fullUs, I2C_HZ / 1000);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_THAN(fullBytes, dirtyBytes / frames);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_frame_sends_only_drawn_tiles);
+    RUN_TEST(test_status_pixels_send_one_tile);
+    RUN_TEST(test_clear_buffer_resends_previous_drawing);
+    RUN_TEST(test_mark_all_dirty_sends_full_frame);
+    RUN_TEST(test_random_frames_match_buffer);
+    return UNITY_END();
+}
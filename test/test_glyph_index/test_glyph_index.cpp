@@ -0,0 +1,153 @@
+/**
+ * @file      test_glyph_index.cpp
+ * @brief     Índice de glifos de U8g2 (U8G2_WITH_GLYPH_INDEX) frente a la búsqueda lineal
+ *
+ * u8g2_font_get_glyph_data() con el índice debe devolver lo mismo que la
+ * búsqueda lineal original (reproducida aquí) para las 256 codificaciones
+ * de 8 bits, y rehacer el índice al cambiar de fuente. El benchmark mide
+ * ambas búsquedas y el coste de drawStr() con los textos de screen.cpp.
+ *
+ * Las fuentes de u8x8_fonts.c usan el formato u8x8, que no pasa por esta
+ * búsqueda; se usa la fuente del host (host_font.h, 95 glifos).
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <vector>
+#include "display_sim.h"
+#include "host_font.h"
+
+extern "C" const uint8_t* u8g2_font_get_glyph_data(u8g2_t* u8g2, uint16_t encoding);
+
+#define FONT_HEADER_SIZE 23  // U8G2_FONT_DATA_STRUCT_SIZE (u8g2_font.c)
+
+static U8G2_SSD1306_128X64_NONAME_F_HW_I2C display(U8G2_R0);
+
+static const char* const SCREEN_TEXTS[] = {
+    "LoRaWAN", "Enviando datos", "Temp: 21.5 C", "Hum: 48 %", "Pres: 1013 hPa", "Bat: 3.92 V 87%",
+};
+
+static uint32_t linearSteps;
+
+/**
+ * @brief Búsqueda lineal de u8g2_font_get_glyph_data() sin índice (codificaciones de 8 bits)
+ */
+static const uint8_t* linear_glyph_data(u8g2_t* u8g2, uint16_t encoding) {
+    const uint8_t* font = u8g2->font + FONT_HEADER_SIZE;
+    if (encoding >= 'a') {
+        font += u8g2->font_info.start_pos_lower_a;
+    } else if (encoding >= 'A') {
+        font += u8g2->font_info.start_pos_upper_A;
+    }
+    for (;;) {
+        linearSteps++;
+        if (font[1] == 0) {
+            return NULL;
+        }
+        if (font[0] == encoding) {
+            return font + 2;
+        }
+        font += font[1];
+    }
+}
+
+template <typename F>
+static double ns_per_lookup(F lookup, int rounds) {
+    using clock = std::chrono::steady_clock;
+    double best = 1e30;
+    volatile uintptr_t sink = 0;
+    for (int r = 0; r < 5; r++) {
+        const auto t0 = clock::now();
+        for (int i = 0; i < rounds; i++) {
+            for (const char* text : SCREEN_TEXTS) {
+                for (const char* c = text; *c; c++) {
+                    sink = sink + (uintptr_t)lookup((uint8_t)*c);
+                }
+            }
+        }
+        const double ns = std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+        best = ns < best ? ns : best;
+    }
+    size_t chars = 0;
+    for (const char* text : SCREEN_TEXTS) {
+        chars += strlen(text);
+    }
+    return best / (rounds * chars);
+}
+
+void setUp(void) {
+    display_sim_attach(display);
+    display.setFont(u8g2_font_ncenB08_tr);
+}
+
+void tearDown(void) {}
+
+void test_index_matches_linear_search(void) {
+    u8g2_t* u8g2 = display.getU8g2();
+    for (uint16_t e = 0; e < 256; e++) {
+        TEST_ASSERT_EQUAL_PTR(linear_glyph_data(u8g2, e), u8g2_font_get_glyph_data(u8g2, e));
+    }
+    TEST_ASSERT_NOT_NULL(u8g2_font_get_glyph_data(u8g2, 'A'));
+    TEST_ASSERT_NULL(u8g2_font_get_glyph_data(u8g2, 0x7F));  // Fuera de la fuente, dentro del índice
+    TEST_ASSERT_NULL(u8g2_font_get_glyph_data(u8g2, 0xE9));  // Fuera del índice
+}
+
+/**
+ * @brief Otra fuente en otra dirección: el índice se rehace al primer uso
+ */
+void test_index_rebuilt_after_font_change(void) {
+    u8g2_t* u8g2 = display.getU8g2();
+    const uint8_t* first = u8g2_font_get_glyph_data(u8g2, 'x');
+    TEST_ASSERT_NOT_NULL(first);
+
+    std::vector<uint8_t> copy(u8g2_font_ncenB08_tr, u8g2_font_ncenB08_tr + sizeof(u8g2_font_ncenB08_tr));
+    display.setFont(copy.data());
+    const uint8_t* second = u8g2_font_get_glyph_data(u8g2, 'x');
+    TEST_ASSERT_EQUAL_PTR(copy.data() + (first - u8g2_font_ncenB08_tr), second);
+
+    display.setFont(u8g2_font_ncenB08_tr);
+    TEST_ASSERT_EQUAL_PTR(first, u8g2_font_get_glyph_data(u8g2, 'x'));
+}
+
+void test_benchmark_lookup_and_draw(void) {
+    u8g2_t* u8g2 = display.getU8g2();
+    const int rounds = 20000;
+
+    linearSteps = 0;
+    const double linearNs = ns_per_lookup([u8g2](uint8_t e) { return linear_glyph_data(u8g2, e); }, rounds);
+    size_t chars = 0;
+    for (const char* text : SCREEN_TEXTS) {
+        chars += strlen(text);
+    }
+    const double steps = (double)linearSteps / (5.0 * rounds * chars);
+    const double indexNs = ns_per_lookup([u8g2](uint8_t e) { return u8g2_font_get_glyph_data(u8g2, e); }, rounds);
+
+    using clock = std::chrono::steady_clock;
+    const auto t0 = clock::now();
+    for (int i = 0; i < rounds / 10; i++) {
+        display.clearBuffer();
+        for (size_t t = 0; t < sizeof(SCREEN_TEXTS) / sizeof(SCREEN_TEXTS[0]); t++) {
+            display.drawStr(0, 10 + 10 * t, SCREEN_TEXTS[t]);
+        }
+    }
+    const double drawNs = std::chrono::duration<double, std::nano>(clock::now() - t0).count() / (rounds / 10 * chars);
+
+    char msg[200];
+    snprintf(msg, sizeof(msg),
+             "búsqueda por carácter: lineal %.1f ns (%.1f glifos recorridos), índice %.1f ns; drawStr %.0f ns por carácter",
+             linearNs, steps, indexNs, drawNs);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_THAN(linearNs, indexNs);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_index_matches_linear_search);
+    RUN_TEST(test_index_rebuilt_after_font_change);
+    RUN_TEST(test_benchmark_lookup_and_draw);
+    return UNITY_END();
+}
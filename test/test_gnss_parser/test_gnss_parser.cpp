@@ -0,0 +1,213 @@
+/**
+ * @file      test_gnss_parser.cpp
+ * @brief     Analizador NMEA/UBX: posiciones, sumas de comprobación, resincronización y benchmark
+ *
+ * Las sentencias y tramas se generan aquí con su suma correcta (no hay
+ * registros grabados de un receptor en el repositorio). El benchmark
+ * alimenta un registro sintético de RMC, GGA, GSA, GSV y NAV-PVT y mide
+ * sentencias por segundo y la duración de cada gnss_parser_feed() (la que
+ * cierra una sentencia incluye su callback).
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../../src/gnss_parser.cpp"
+
+#define BENCH_SENTENCES 80000
+
+static gnss_parser_t parser;
+static std::vector<gnss_fix_t> fixes;
+static std::vector<std::string> sentences;
+static uint32_t ubxFrames;
+
+static void on_sentence(const char* sentence, void* ctx) {
+    sentences.push_back(sentence);
+}
+
+static void on_ubx(uint8_t cls, uint8_t id, const uint8_t* payload, uint16_t len, void* ctx) {
+    ubxFrames++;
+}
+
+static void on_fix(const gnss_fix_t* fix, void* ctx) {
+    fixes.push_back(*fix);
+}
+
+static std::string nmea(const char* body) {
+    uint8_t x = 0;
+    for (const char* p = body; *p; p++) {
+        x ^= (uint8_t)*p;
+    }
+    char tail[8];
+    snprintf(tail, sizeof(tail), "*%02X\r\n", x);
+    return std::string("$") + body + tail;
+}
+
+static std::string ubx(uint8_t cls, uint8_t id, const std::string& payload) {
+    std::string f = {(char)0xB5, 0x62, (char)cls, (char)id, (char)(payload.size() & 0xFF), (char)(payload.size() >> 8)};
+    f += payload;
+    uint8_t a = 0, b = 0;
+    for (size_t i = 2; i < f.size(); i++) {
+        a += (uint8_t)f[i];
+        b += a;
+    }
+    f += (char)a;
+    f += (char)b;
+    return f;
+}
+
+static void feed(const std::string& data) {
+    gnss_parser_feed_buf(&parser, (const uint8_t*)data.data(), data.size());
+}
+
+static const char* const GGA = "GPGGA,123519.00,4807.03800,N,01131.00000,E,1,08,0.9,545.4,M,46.9,M,,";
+static const char* const RMC = "GPRMC,081836.00,A,3751.65000,S,14507.36000,W,0.0,360.0,130998,011.3,E";
+
+void setUp(void) {
+    gnss_parser_init(&parser, on_sentence, on_ubx, on_fix, NULL);
+    fixes.clear();
+    sentences.clear();
+    ubxFrames = 0;
+}
+
+void tearDown(void) {}
+
+void test_gga_and_rmc_fixes(void) {
+    feed(nmea(GGA) + nmea(RMC));
+    TEST_ASSERT_EQUAL_UINT32(2, fixes.size());
+
+    const gnss_fix_t& g = fixes[0];
+    TEST_ASSERT_EQUAL_INT('G', g.type);
+    TEST_ASSERT_TRUE(g.valid);
+    TEST_ASSERT_EQUAL_INT32(481173000, g.lat_e7);   // 48° 07,038'
+    TEST_ASSERT_EQUAL_INT32(115166666, g.lon_e7);   // 11° 31,000'
+    TEST_ASSERT_EQUAL_UINT32(45319000, g.time_ms);  // 12:35:19
+    TEST_ASSERT_EQUAL_INT32(5454, g.alt_dm);
+    TEST_ASSERT_EQUAL_UINT8(8, g.satellites);
+    TEST_ASSERT_EQUAL_UINT16(9, g.hdop_x10);
+
+    const gnss_fix_t& r = fixes[1];
+    TEST_ASSERT_EQUAL_INT('R', r.type);
+    TEST_ASSERT_TRUE(r.valid);
+    TEST_ASSERT_EQUAL_INT32(-378608333, r.lat_e7);   // Sur
+    TEST_ASSERT_EQUAL_INT32(-1451226666, r.lon_e7);  // Oeste
+    TEST_ASSERT_EQUAL_UINT32(29916000, r.time_ms);
+    TEST_ASSERT_EQUAL_UINT32(130998, r.date);
+}
+
+void test_checksum_errors_and_resync(void) {
+    std::string bad = nmea(GGA);
+    bad[10] = '9';
+    std::string data = bad;
+    data += "\x01\xFF$GPG";                      // Basura y una sentencia cortada
+    data += nmea(RMC);
+    data += ubx(0x05, 0x01, std::string("\x06\x08", 2));
+    std::string badUbx = ubx(0x05, 0x01, std::string("\x06\x08", 2));
+    badUbx.back() ^= 1;
+    data += badUbx + nmea(GGA);
+    feed(data);
+
+    TEST_ASSERT_EQUAL_UINT32(2, parser.checksum_errors);
+    TEST_ASSERT_EQUAL_UINT32(2, parser.sentences);
+    TEST_ASSERT_EQUAL_UINT32(1, parser.frames);
+    TEST_ASSERT_EQUAL_UINT32(1, ubxFrames);
+    TEST_ASSERT_EQUAL_STRING(RMC, sentences[0].c_str());
+    TEST_ASSERT_EQUAL_STRING(GGA, sentences[1].c_str());
+}
+
+/**
+ * @brief Cabecera UBX con longitud 0xFFFF: se descarta sin tragarse lo que sigue
+ */
+void test_oversized_ubx_length_rejected(void) {
+    std::string data("\xB5\x62\x01\x07\xFF\xFF", 6);
+    for (int i = 0; i < 500; i++) {
+        data += nmea(GGA);
+    }
+    feed(data);
+
+    TEST_ASSERT_EQUAL_UINT32(1, parser.overflows);
+    TEST_ASSERT_EQUAL_UINT32(500, parser.sentences);
+    TEST_ASSERT_EQUAL_UINT32(500, fixes.size());
+    TEST_ASSERT_EQUAL_UINT32(0, parser.frames);
+}
+
+/**
+ * @brief Una trama válida más larga que el buffer tampoco llega al callback
+ */
+void test_ubx_longer_than_buffer(void) {
+    feed(ubx(0x01, 0x07, std::string(GNSS_UBX_MAX_PAYLOAD + 1, 'x')) + nmea(RMC) +
+         ubx(0x01, 0x07, std::string(GNSS_UBX_MAX_PAYLOAD, 'x')));
+    TEST_ASSERT_EQUAL_UINT32(1, parser.overflows);
+    TEST_ASSERT_EQUAL_UINT32(1, parser.sentences);
+    TEST_ASSERT_EQUAL_UINT32(1, ubxFrames);
+}
+
+void test_long_nmea_overflow(void) {
+    feed("$GPTXT," + std::string(GNSS_NMEA_MAX_LEN, 'A') + "*00\r\n" + nmea(GGA));
+    TEST_ASSERT_EQUAL_UINT32(1, parser.overflows);
+    TEST_ASSERT_EQUAL_UINT32(1, parser.sentences);
+}
+
+void test_benchmark_synthetic_log(void) {
+    const std::string pvt = ubx(0x01, 0x07, std::string(92, '\x11'));
+    const std::string cycle[] = {
+        nmea(RMC),
+        nmea(GGA),
+        nmea("GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1"),
+        nmea("GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45"),
+        pvt,
+    };
+    std::string log;
+    for (int i = 0; i < BENCH_SENTENCES / 5; i++) {
+        for (const std::string& s : cycle) {
+            log += s;
+        }
+    }
+
+    using clock = std::chrono::steady_clock;
+    double best = 1e30;
+    for (int r = 0; r < 3; r++) {
+        setUp();
+        const auto t0 = clock::now();
+        feed(log);
+        best = std::min(best, std::chrono::duration<double>(clock::now() - t0).count());
+    }
+    TEST_ASSERT_EQUAL_UINT32(BENCH_SENTENCES * 4 / 5, parser.sentences);
+    TEST_ASSERT_EQUAL_UINT32(BENCH_SENTENCES / 5, parser.frames);
+    TEST_ASSERT_EQUAL_UINT32(0, parser.checksum_errors);
+
+    // Duración de cada byte por separado (incluye ~20 ns de lectura del reloj)
+    setUp();
+    std::vector<float> ns(log.size());
+    for (size_t i = 0; i < log.size(); i++) {
+        const auto t0 = clock::now();
+        gnss_parser_feed(&parser, (uint8_t)log[i]);
+        ns[i] = std::chrono::duration<float, std::nano>(clock::now() - t0).count();
+    }
+    std::sort(ns.begin(), ns.end());
+
+    char msg[200];
+    snprintf(msg, sizeof(msg),
+             "%d sentencias/tramas, %.1f MB: %.2f M sentencias/s, %.0f ns/byte; por byte p50 %.0f ns, "
+             "p99.99 %.0f ns, máx %.0f ns",
+             BENCH_SENTENCES, log.size() / 1e6, BENCH_SENTENCES / best / 1e6, best * 1e9 / log.size(),
+             ns[ns.size() / 2], ns[(size_t)(ns.size() * 0.9999)], ns.back());
+    TEST_MESSAGE(msg);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_gga_and_rmc_fixes);
+    RUN_TEST(test_checksum_errors_and_resync);
+    RUN_TEST(test_oversized_ubx_length_rejected);
+    RUN_TEST(test_ubx_longer_than_buffer);
+    RUN_TEST(test_long_nmea_overflow);
+    RUN_TEST(test_benchmark_synthetic_log);
+    return UNITY_END();
+}
@@ -0,0 +1,242 @@
+/**
+ * @file      test_gnss_power.cpp
+ * @brief     GNSS con arranque en caliente: tipo de arranque, reposo, presupuesto y espera antes de dormir
+ *
+ * Receptor simulado (stubs/gps_uart_sim.h) alimentado por el raíl del PMU
+ * simulado (stubs/pmu_sim.h): solo atiende comandos con el raíl encendido.
+ * Se comprueba que el presupuesto sigue al tipo de arranque (frío sin
+ * respaldo, caliente con una posición reciente, templado con una antigua),
+ * que la hora de la posición sobrevive al sueño profundo en memoria RTC,
+ * que el comando de reposo sale antes de cortar el raíl y que
+ * gnss_power_finish() no espera más que el presupuesto ni más que
+ * GNSS_FINISH_SLICE_MS, continuando la búsqueda en el siguiente despertar.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include "../../config/config.h"
+#ifndef HAS_GPS  // La placa de config.h no lleva GPS: la de un T-Beam
+#define HAS_GPS
+#define GPS_BAUD_RATE 9600
+#define GPS_RX_PIN 34
+#define GPS_TX_PIN 12
+#endif
+#undef ENABLE_GNSS_TRACKING
+#define ENABLE_GNSS_TRACKING true
+#include "gps_uart_sim.h"
+#include "pmu_sim.h"
+#include "../../src/gnss_parser.cpp"
+#include "../../src/gps_detect.cpp"
+#include "../../src/pmu_profile.cpp"
+#include "../../src/boot_mode.cpp"
+#include "../../src/gnss_power.cpp"
+
+#define WAKE_MS 5000          // Tiempo despierto antes de gnss_power_finish()
+#define SLEEP_S 300           // Sueño profundo entre despertares
+
+/**
+ * @brief Raíl principal del receptor (el que conmuta setMainRail())
+ */
+static bool gnss_rail_on(void) {
+    return PMU->isPowerChannelEnable(PMU->getChipModel() == XPOWERS_AXP192 ? XPOWERS_LDO3 : XPOWERS_ALDO3);
+}
+
+/**
+ * @brief Arranque en frío con el receptor ya detectado
+ */
+static void power_on(uint8_t chip, gps_sim_model_t model) {
+    PMU = chip == XPOWERS_AXP2101 ? (XPowersLibInterface*)pmu_sim_begin_axp2101()
+                                  : (XPowersLibInterface*)pmu_sim_begin_axp192();
+    cacheValid = false;
+    host_wakeup_cause = ESP_SLEEP_WAKEUP_UNDEFINED;
+    find_gps = true;
+    gps_model_id = model == GPS_SIM_L76K ? GPS_MODEL_L76K : GPS_MODEL_UBLOX;
+    SerialGPS.connect(model, 9600, 0);
+    SerialGPS.powered = gnss_rail_on;
+    state = GNSS_STATE_OFF;
+}
+
+/**
+ * @brief Sueño profundo: se pierde la RAM y se conserva la memoria RTC
+ */
+static void deep_sleep(void) {
+    host_clock_us += (uint64_t)SLEEP_S * 1000000;
+    host_wakeup_cause = ESP_SLEEP_WAKEUP_TIMER;
+    state = GNSS_STATE_OFF;
+    expected = GNSS_START_COLD;
+    budgetMs = 0;
+    SerialGPS.connect(SerialGPS.model, 9600, 0);
+}
+
+/**
+ * @brief loop() durante ms milisegundos o hasta que termina la búsqueda
+ */
+static void run_ms(uint32_t ms) {
+    const uint32_t t0 = millis();
+    for (;;) {
+        gnss_power_loop();
+        if (state != GNSS_STATE_SEARCHING || millis() - t0 >= ms) {
+            break;
+        }
+        delay(10);
+    }
+}
+
+/**
+ * @brief Despertar completo con una posición a los fixMs de encender
+ */
+static void wake_with_fix(uint32_t fixMs) {
+    gnss_power_begin();
+    SerialGPS.sendFix(host_clock_us + (uint64_t)fixMs * 1000);
+    run_ms(WAKE_MS);
+    gnss_power_finish();
+}
+
+void setUp(void) {
+    host_clock_us = 0;
+    lastFixValid = false;
+    backupKept = false;
+    missedFixes = 0;
+    carriedMs = 0;
+}
+
+void tearDown(void) {}
+
+/**
+ * @brief Frío sin respaldo, caliente con posición reciente, templado con una antigua
+ */
+void test_budget_follows_start_type(void) {
+    power_on(XPOWERS_AXP2101, GPS_SIM_UBLOX);
+    gnss_power_begin();
+    TEST_ASSERT_EQUAL(GNSS_START_COLD, expected);
+    TEST_ASSERT_EQUAL_UINT32(GNSS_COLD_FIX_BUDGET_MS, budgetMs);
+    SerialGPS.sendFix(host_clock_us + 3000000);
+    run_ms(WAKE_MS);
+    gnss_power_finish();
+    TEST_ASSERT_EQUAL(GNSS_STATE_FIXED, state);
+
+    // La hora de la posición sigue en memoria RTC tras el sueño profundo
+    deep_sleep();
+    gnss_power_begin();
+    TEST_ASSERT_TRUE(lastFixValid);
+    TEST_ASSERT_TRUE(backupKept);
+    TEST_ASSERT_EQUAL(GNSS_START_HOT, expected);
+    TEST_ASSERT_EQUAL_UINT32(GNSS_HOT_FIX_BUDGET_MS, budgetMs);
+    SerialGPS.sendFix(host_clock_us + 1000000);
+    run_ms(WAKE_MS);
+    gnss_power_finish();
+
+    // Efemérides caducadas: templado
+    deep_sleep();
+    lastFixTime -= GNSS_HOT_START_MAX_AGE_S + 60;
+    gnss_power_begin();
+    TEST_ASSERT_EQUAL(GNSS_START_WARM, expected);
+    TEST_ASSERT_EQUAL_UINT32(GNSS_WARM_FIX_BUDGET_MS, budgetMs);
+    SerialGPS.sendFix(host_clock_us + 1000000);
+    run_ms(WAKE_MS);
+    gnss_power_finish();
+
+    // Un arranque en frío no se fía de la memoria RTC
+    power_on(XPOWERS_AXP2101, GPS_SIM_UBLOX);
+    gnss_power_begin();
+    TEST_ASSERT_FALSE(lastFixValid);
+    TEST_ASSERT_EQUAL(GNSS_START_COLD, expected);
+}
+
+/**
+ * @brief El comando de reposo llega al receptor antes de cortar su raíl
+ */
+void test_standby_sent_before_rail_cut(void) {
+    const gps_sim_model_t models[] = {GPS_SIM_L76K, GPS_SIM_UBLOX};
+    for (gps_sim_model_t model : models) {
+        power_on(XPOWERS_AXP192, model);
+        gnss_power_begin();
+        TEST_ASSERT_TRUE(gnss_rail_on());
+        SerialGPS.sendFix(host_clock_us + 2000000);
+        run_ms(WAKE_MS);
+        TEST_ASSERT_EQUAL(GNSS_STATE_FIXED, state);
+        TEST_ASSERT_FALSE(gnss_rail_on());
+        TEST_ASSERT_TRUE(SerialGPS.standby);
+        TEST_ASSERT_EQUAL_UINT32(0, SerialGPS.lost);
+    }
+}
+
+/**
+ * @brief gnss_power_finish() se detiene al agotar el presupuesto, no antes ni después
+ */
+void test_finish_stops_at_budget(void) {
+    power_on(XPOWERS_AXP2101, GPS_SIM_L76K);
+    wake_with_fix(2000);
+    deep_sleep();
+
+    // Caliente sin posición: el presupuesto vence dentro del tramo de espera
+    gnss_power_begin();
+    TEST_ASSERT_EQUAL(GNSS_START_HOT, expected);
+    const uint32_t t0 = millis();
+    run_ms(GNSS_HOT_FIX_BUDGET_MS - GNSS_FINISH_SLICE_MS / 2);
+    TEST_ASSERT_EQUAL(GNSS_STATE_SEARCHING, state);
+    gnss_power_finish();
+    TEST_ASSERT_EQUAL_UINT32(GNSS_HOT_FIX_BUDGET_MS, millis() - t0);
+    TEST_ASSERT_EQUAL(GNSS_STATE_TIMEOUT, state);
+    TEST_ASSERT_EQUAL_UINT8(1, missedFixes);
+    TEST_ASSERT_EQUAL_UINT32(0, carriedMs);
+    TEST_ASSERT_FALSE(gnss_rail_on());
+    TEST_ASSERT_TRUE(SerialGPS.standby);
+}
+
+/**
+ * @brief Antes de dormir espera como mucho un tramo; la búsqueda en frío sigue al despertar
+ */
+void test_finish_caps_wait_and_resumes(void) {
+    power_on(XPOWERS_AXP192, GPS_SIM_UBLOX);
+    uint32_t searchedMs = 0;
+    uint8_t wakes = 0;
+    gnss_power_begin();
+    for (;;) {
+        const uint32_t t0 = millis();
+        run_ms(WAKE_MS);
+        const uint32_t before = millis();
+        gnss_power_finish();
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(GNSS_FINISH_SLICE_MS, millis() - before);
+        TEST_ASSERT_FALSE(gnss_rail_on());
+        searchedMs += millis() - t0;
+        wakes++;
+        if (state != GNSS_STATE_PAUSED) {
+            break;
+        }
+        TEST_ASSERT_LESS_THAN_UINT32(100, wakes);
+        TEST_ASSERT_EQUAL_UINT32(searchedMs, carriedMs);
+        deep_sleep();
+        gnss_power_begin();
+        TEST_ASSERT_EQUAL(GNSS_START_COLD, expected);
+        TEST_ASSERT_EQUAL_UINT32(GNSS_COLD_FIX_BUDGET_MS - searchedMs, budgetMs);
+    }
+    // El presupuesto en frío se reparte entre despertares sin pasarse
+    TEST_ASSERT_EQUAL(GNSS_STATE_TIMEOUT, state);
+    TEST_ASSERT_EQUAL_UINT32(GNSS_COLD_FIX_BUDGET_MS, searchedMs);
+    TEST_ASSERT_EQUAL_UINT8(GNSS_COLD_FIX_BUDGET_MS / (WAKE_MS + GNSS_FINISH_SLICE_MS) + 1, wakes);
+
+    // Una búsqueda aplazada que encuentra posición al despertar
+    power_on(XPOWERS_AXP192, GPS_SIM_UBLOX);
+    gnss_power_begin();
+    run_ms(WAKE_MS);
+    gnss_power_finish();
+    TEST_ASSERT_EQUAL(GNSS_STATE_PAUSED, state);
+    deep_sleep();
+    wake_with_fix(1000);
+    TEST_ASSERT_EQUAL(GNSS_STATE_FIXED, state);
+    TEST_ASSERT_EQUAL_UINT32(0, carriedMs);
+    TEST_ASSERT_EQUAL_UINT8(0, missedFixes);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_budget_follows_start_type);
+    RUN_TEST(test_standby_sent_before_rail_cut);
+    RUN_TEST(test_finish_stops_at_budget);
+    RUN_TEST(test_finish_caps_wait_and_resumes);
+    return UNITY_END();
+}
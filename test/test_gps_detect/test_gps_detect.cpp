@@ -0,0 +1,140 @@
+/**
+ * @file      test_gps_detect.cpp
+ * @brief     Receptor GPS guardado en NVS: confirmación, reintento y detección completa
+ *
+ * UART simulada (stubs/gps_uart_sim.h) y NVS en memoria (stubs/Preferences.h).
+ * El receptor guardado se confirma con una sola petición; si aún está
+ * arrancando, el reintento lo encuentra sin borrar la NVS, y solo un
+ * receptor que no responde a ninguna de las dos obliga a la detección
+ * completa en el arranque siguiente.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include "../../config/config.h"
+#ifndef HAS_GPS  // La placa de config.h no lleva GPS: la de un T-Beam
+#define HAS_GPS
+#define GPS_BAUD_RATE 9600
+#define GPS_RX_PIN 34
+#define GPS_TX_PIN 12
+#endif
+#include "gps_uart_sim.h"
+#include "../../src/gnss_parser.cpp"
+#include "../../src/gps_detect.cpp"
+
+static uint64_t start;
+
+static uint32_t elapsed_ms(void) {
+    return (uint32_t)((host_clock_us - start) / 1000);
+}
+
+static bool nvs_has_receiver(void) {
+    Preferences prefs;
+    if (!prefs.begin(GPS_NVS_NAMESPACE, true)) {
+        return false;
+    }
+    bool has = prefs.isKey("model");
+    prefs.end();
+    return has;
+}
+
+void setUp(void) {
+    Preferences::reset();
+    find_gps = false;
+    host_clock_us = 0;
+    SerialGPS.updateBaudRate(GPS_BAUD_RATE);
+}
+
+void tearDown(void) {}
+
+void test_cached_receiver_confirmed(void) {
+    gpsSaveDetected(GPS_MODEL_L76K, 9600);
+    SerialGPS.connect(GPS_SIM_L76K, 9600, 0);
+    const uint32_t writes = Preferences::writes;
+
+    start = host_clock_us;
+    TEST_ASSERT_TRUE(beginCachedGPS());
+    TEST_ASSERT_LESS_THAN(100, elapsed_ms());
+    TEST_ASSERT_EQUAL_UINT32(writes, Preferences::writes);
+    TEST_ASSERT_EQUAL_STRING("L76K", gps_model);
+}
+
+/**
+ * @brief El receptor aún arranca en la primera petición: el reintento lo encuentra
+ */
+void test_retry_covers_receiver_boot(void) {
+    gpsSaveDetected(GPS_MODEL_L76K, 9600);
+    SerialGPS.connect(GPS_SIM_L76K, 9600, host_clock_us + 600000);  // Arranca en 0,6 s
+    const uint32_t writes = Preferences::writes;
+
+    start = host_clock_us;
+    TEST_ASSERT_TRUE(beginCachedGPS());
+    TEST_ASSERT_EQUAL_UINT32(1, SerialGPS.lost);
+    TEST_ASSERT_GREATER_OR_EQUAL(GPS_CONFIRM_TIMEOUT_MS, elapsed_ms());
+    TEST_ASSERT_LESS_THAN(GPS_CONFIRM_TIMEOUT_MS + 100, elapsed_ms());
+    TEST_ASSERT_EQUAL_UINT32(writes, Preferences::writes);
+    TEST_ASSERT_TRUE(nvs_has_receiver());
+}
+
+void test_absent_receiver_cleared_after_retry(void) {
+    gpsSaveDetected(GPS_MODEL_UBLOX, 38400);
+    SerialGPS.connect(GPS_SIM_NONE, 38400, 0);
+
+    start = host_clock_us;
+    TEST_ASSERT_FALSE(beginCachedGPS());
+    TEST_ASSERT_GREATER_OR_EQUAL(GPS_CONFIRM_ATTEMPTS * GPS_CONFIRM_TIMEOUT_MS, elapsed_ms());
+    TEST_ASSERT_FALSE(nvs_has_receiver());
+    TEST_ASSERT_EQUAL_UINT32(GPS_BAUD_RATE, SerialGPS.baud);
+}
+
+void test_ublox_confirmed_at_saved_baud(void) {
+    gpsSaveDetected(GPS_MODEL_UBLOX, 38400);
+    SerialGPS.connect(GPS_SIM_UBLOX, 38400, 0);
+
+    start = host_clock_us;
+    TEST_ASSERT_TRUE(beginCachedGPS());
+    TEST_ASSERT_EQUAL_UINT32(38400, SerialGPS.baud);
+    TEST_ASSERT_LESS_THAN(100, elapsed_ms());
+}
+
+/**
+ * @brief Otro receptor que el guardado: barrido completo y NVS actualizada
+ */
+void test_changed_receiver_detected_and_saved(void) {
+    gpsSaveDetected(GPS_MODEL_L76K, 9600);
+    SerialGPS.connect(GPS_SIM_UBLOX, 38400, 0);
+
+    start = host_clock_us;
+    TEST_ASSERT_TRUE(detectGPS());
+    TEST_ASSERT_TRUE(gpsDetected());
+    const uint32_t sweepMs = elapsed_ms();
+
+    Preferences prefs;
+    TEST_ASSERT_TRUE(prefs.begin(GPS_NVS_NAMESPACE, true));
+    TEST_ASSERT_EQUAL_UINT8(GPS_MODEL_UBLOX, prefs.getUChar("model"));
+    TEST_ASSERT_EQUAL_UINT32(38400, prefs.getULong("baud"));
+    prefs.end();
+
+    // Arranque siguiente: una sola petición
+    SerialGPS.updateBaudRate(GPS_BAUD_RATE);
+    start = host_clock_us;
+    TEST_ASSERT_TRUE(detectGPS());
+    char msg[100];
+    snprintf(msg, sizeof(msg), "detección completa %lu ms, receptor guardado %lu ms",
+             (unsigned long)sweepMs, (unsigned long)elapsed_ms());
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_THAN(100, elapsed_ms());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_cached_receiver_confirmed);
+    RUN_TEST(test_retry_covers_receiver_boot);
+    RUN_TEST(test_absent_receiver_cleared_after_retry);
+    RUN_TEST(test_ublox_confirmed_at_saved_baud);
+    RUN_TEST(test_changed_receiver_detected_and_saved);
+    return UNITY_END();
+}
@@ -0,0 +1,119 @@
+/**
+ * @file      test_i2c_scan.cpp
+ * @brief     scanDevices(): inventario en caliente frente al escaneo completo
+ *
+ * Buses simulados (test/stubs/Wire.h) con los dispositivos de la placa. Un
+ * arranque completo escanea las 126 direcciones y guarda el inventario; el
+ * arranque en caliente siguiente solo comprueba esas direcciones y debe
+ * dejar deviceOnline exactamente igual. Si un dispositivo deja de
+ * responder se vuelve al escaneo completo.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include "../../src/i2c_scan.cpp"
+
+#define FULL_SCAN_ADDRESSES 126
+
+static bool warmBoot;
+
+bool boot_mode_warm(void) {
+    return warmBoot;
+}
+
+typedef struct {
+    uint32_t deviceOnline;
+    uint32_t transactions;
+    uint64_t us;
+} scan_result_t;
+
+/**
+ * @brief Un arranque: deviceOnline parte de cero y se escanean los dos buses
+ */
+static scan_result_t boot(bool warm) {
+    warmBoot = warm;
+    deviceOnline = 0;
+    Wire.transactions = 0;
+    Wire1.transactions = 0;
+    const uint64_t start = host_clock_us;
+    scanDevices(&Wire);
+    scanDevices(&Wire1);
+    return {deviceOnline, Wire.transactions + Wire1.transactions, host_clock_us - start};
+}
+
+void setUp(void) {
+    i2cInventoryMagic = 0;
+    i2cInventoryValid = 0;
+    memset(i2cInventory, 0, sizeof(i2cInventory));
+    Wire.reset();
+    Wire1.reset();
+    Wire.attach(0x34);   // AXP192
+    Wire.attach(0x3C);   // SSD1306
+    Wire.attach(0x51);   // PCF8563
+    Wire1.attach(0x1C);  // QMC6310
+    Wire1.attach(0x68);  // Desconocido: solo se anota
+}
+
+void tearDown(void) {}
+
+void test_warm_scan_matches_full_scan(void) {
+    const scan_result_t full = boot(false);
+    const scan_result_t warm = boot(true);
+
+    TEST_ASSERT_EQUAL_HEX32(POWERMANAGE_ONLINE | DISPLAY_ONLINE | PCF8563_ONLINE | QMC6310_ONLINE,
+                            full.deviceOnline);
+    TEST_ASSERT_EQUAL_HEX32(full.deviceOnline, warm.deviceOnline);
+    TEST_ASSERT_EQUAL_UINT32(2 * FULL_SCAN_ADDRESSES, full.transactions);
+    TEST_ASSERT_EQUAL_UINT32(5, warm.transactions);
+
+    char msg[120];
+    snprintf(msg, sizeof(msg), "escaneo completo %.1f ms (%lu direcciones), inventario %.1f ms (%lu)",
+             full.us / 1000.0, (unsigned long)full.transactions, warm.us / 1000.0,
+             (unsigned long)warm.transactions);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_THAN(full.us / 50, warm.us);
+}
+
+/**
+ * @brief Un dispositivo que ya no responde: escaneo completo y nuevo inventario
+ */
+void test_missing_device_falls_back_to_full_scan(void) {
+    boot(false);
+    Wire.detach(0x3C);
+    const scan_result_t fallback = boot(true);
+    const scan_result_t expected = boot(false);
+
+    TEST_ASSERT_EQUAL_HEX32(expected.deviceOnline, fallback.deviceOnline);
+    TEST_ASSERT_EQUAL_UINT32(0, fallback.deviceOnline & DISPLAY_ONLINE);
+    // 0x34 y 0x3C del inventario, el bus 0 entero y el inventario del bus 1
+    TEST_ASSERT_EQUAL_UINT32(2 + FULL_SCAN_ADDRESSES + 2, fallback.transactions);
+
+    const scan_result_t warm = boot(true);
+    TEST_ASSERT_EQUAL_HEX32(expected.deviceOnline, warm.deviceOnline);
+    TEST_ASSERT_EQUAL_UINT32(4, warm.transactions);
+}
+
+/**
+ * @brief Sin arranque en caliente el inventario se ignora aunque sea válido
+ */
+void test_full_boot_ignores_inventory(void) {
+    boot(false);
+    Wire.attach(0x77);
+    const scan_result_t full = boot(false);
+    TEST_ASSERT_EQUAL_UINT32(2 * FULL_SCAN_ADDRESSES, full.transactions);
+
+    const scan_result_t warm = boot(true);
+    TEST_ASSERT_EQUAL_UINT32(6, warm.transactions);
+    TEST_ASSERT_EQUAL_HEX32(full.deviceOnline, warm.deviceOnline);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_warm_scan_matches_full_scan);
+    RUN_TEST(test_missing_device_falls_back_to_full_scan);
+    RUN_TEST(test_full_boot_ignores_inventory);
+    return UNITY_END();
+}
@@ -0,0 +1,145 @@
+/**
+ * @file      test_init_graph.cpp
+ * @brief     Arranque por grafo con latencias simuladas: camino crítico, caducidad y after
+ *
+ * Las tareas y grupos de eventos de stubs/freertos/ se turnan sobre el
+ * reloj simulado: cada nodo ocupa su periférico con host_task_busy_ms() y
+ * los que corren a la vez solapan su espera. Se comprueba que el grafo del
+ * firmware (radio, pantalla y sensores tras la pantalla) dura su camino
+ * crítico y no la suma de los pasos, que un nodo caducado deja sin
+ * ejecutar a los que dependen de él (deps) y que los ordenados tras él
+ * (after) esperan a que su tarea termine de verdad.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include "../../config/config.h"
+#undef ENABLE_PARALLEL_INIT
+#define ENABLE_PARALLEL_INIT true
+#include "../../src/init_graph.cpp"
+
+// Latencias típicas de la placa (ms)
+#define RADIO_MS 350     // Reset del SX1276 y os_init()
+#define DISPLAY_MS 120   // Inicialización del SSD1306 y pantalla de inicio
+#define SENSORS_MS 250   // Detección y arranque de los sensores I2C
+
+// Instantes (ms simulados) en que empieza y acaba cada nodo de prueba
+static uint32_t startedMs[INIT_GRAPH_MAX_NODES];
+static uint32_t endedMs[INIT_GRAPH_MAX_NODES];
+static uint8_t calls;
+
+/**
+ * @brief Nodo de prueba: ocupa su periférico ms milisegundos y devuelve ok
+ */
+template <int index, uint32_t ms, bool ok = true>
+static bool fake_node(void) {
+    startedMs[index] = millis();
+    calls |= INIT_DEP(index);
+    host_task_busy_ms(ms);
+    endedMs[index] = millis();
+    return ok;
+}
+
+static uint32_t elapsed_ms(uint32_t since) {
+    return millis() - since;
+}
+
+static uint32_t node_ms(uint8_t i) {
+    return (uint32_t)((states[i].endUs - states[i].startUs) / 1000);
+}
+
+void setUp(void) {
+    memset(startedMs, 0, sizeof(startedMs));
+    memset(endedMs, 0, sizeof(endedMs));
+    calls = 0;
+    host_clock_us = 1000000;  // esp_timer_get_time() == 0 marca "sin empezar"
+}
+
+void tearDown(void) {}
+
+/**
+ * @brief Grafo de main.ino: el total es el camino crítico, no la suma
+ */
+void test_firmware_graph_runs_critical_path(void) {
+    const init_node_t nodes[] = {
+        { "radio",    fake_node<0, RADIO_MS>,   0, 0,          2000, 0 },
+        { "pantalla", fake_node<1, DISPLAY_MS>, 0, 0,          500,  1 },
+        { "sensores", fake_node<2, SENSORS_MS>, 0, INIT_DEP(1), 2000, 1 },
+    };
+    const uint32_t t0 = millis();
+    const uint8_t ok = init_graph_run(nodes, 3);
+    const uint32_t totalMs = elapsed_ms(t0);
+
+    const uint32_t sumMs = RADIO_MS + DISPLAY_MS + SENSORS_MS;
+    const uint32_t criticalMs = DISPLAY_MS + SENSORS_MS > RADIO_MS ? DISPLAY_MS + SENSORS_MS : RADIO_MS;
+    char msg[120];
+    snprintf(msg, sizeof(msg), "grafo del firmware: %lu ms en total, camino crítico %lu ms, suma %lu ms",
+             (unsigned long)totalMs, (unsigned long)criticalMs, (unsigned long)sumMs);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_EQUAL_HEX8(0x07, ok);
+    TEST_ASSERT_LESS_THAN_UINT32(sumMs, totalMs);
+    TEST_ASSERT_UINT32_WITHIN(INIT_GRAPH_POLL_MS, criticalMs, totalMs);
+    TEST_ASSERT_EQUAL_UINT32(RADIO_MS, node_ms(0));
+
+    // Radio y pantalla a la vez; sensores tras la pantalla
+    TEST_ASSERT_EQUAL_UINT32(startedMs[0], startedMs[1]);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(endedMs[1], startedMs[2]);
+    TEST_ASSERT_LESS_THAN_UINT32(endedMs[0], startedMs[2]);
+}
+
+/**
+ * @brief Nodo caducado: sus deps no se ejecutan y los after esperan a su tarea
+ */
+void test_timed_out_node_skips_deps_and_delays_after(void) {
+    const init_node_t nodes[] = {
+        { "lento",    fake_node<0, 400>, 0,           0,           100,  1 },
+        { "depende",  fake_node<1, 50>,  INIT_DEP(0), 0,           1000, 0 },
+        { "despues",  fake_node<2, 50>,  0,           INIT_DEP(0), 1000, 1 },
+        { "libre",    fake_node<3, 30>,  0,           0,           1000, 0 },
+    };
+    const uint32_t t0 = millis();
+    const uint8_t ok = init_graph_run(nodes, 4);
+
+    // El lento devuelve true, pero tarde: cuenta como fallido
+    TEST_ASSERT_EQUAL_HEX8(INIT_DEP(2) | INIT_DEP(3), ok);
+    TEST_ASSERT_FALSE(calls & INIT_DEP(1));
+    TEST_ASSERT_FALSE(states[1].ran);
+    TEST_ASSERT_TRUE(states[0].ok);
+
+    // "depende" queda libre en cuanto vence el plazo, no cuando acaba la tarea
+    TEST_ASSERT_UINT32_WITHIN(INIT_GRAPH_POLL_MS, 100, (uint32_t)(states[1].endUs / 1000) - t0);
+
+    // "despues" espera a que la tarea caducada suelte su periférico
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(endedMs[0], startedMs[2]);
+    TEST_ASSERT_EQUAL_UINT32(t0, startedMs[3]);
+
+    // init_graph_run() no vuelve hasta que acaban todas las tareas
+    TEST_ASSERT_EQUAL_UINT32(400 + 50, elapsed_ms(t0));
+}
+
+/**
+ * @brief Un nodo que falla sin caducar también omite sus deps, pero no sus after
+ */
+void test_failed_node_skips_deps_only(void) {
+    const init_node_t nodes[] = {
+        { "falla",   fake_node<0, 20, false>, 0,           0,           1000, 1 },
+        { "depende", fake_node<1, 20>,        INIT_DEP(0), 0,           1000, 1 },
+        { "despues", fake_node<2, 20>,        0,           INIT_DEP(0), 1000, 1 },
+    };
+    const uint8_t ok = init_graph_run(nodes, 3);
+    TEST_ASSERT_EQUAL_HEX8(INIT_DEP(2), ok);
+    TEST_ASSERT_EQUAL_HEX8(INIT_DEP(0) | INIT_DEP(2), calls);
+    TEST_ASSERT_EQUAL_UINT32(endedMs[0], startedMs[2]);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_firmware_graph_runs_critical_path);
+    RUN_TEST(test_timed_out_node_skips_deps_and_delays_after);
+    RUN_TEST(test_failed_node_skips_deps_only);
+    return UNITY_END();
+}
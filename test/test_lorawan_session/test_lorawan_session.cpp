@@ -0,0 +1,233 @@
+/**
+ * @file      test_lorawan_session.cpp
+ * @brief     Sesión LoRaWAN persistente: reserva aplazada y simulación de 10 años
+ *
+ * NVS en memoria (stubs/Preferences.h) sobre una partición nvs de 0x5000
+ * como la de partitions.csv. La simulación recorre 10 años de despertares
+ * cada SEND_INTERVAL_SECONDS con cortes de alimentación (arranques en frío
+ * y cortes con una trama en el aire), joins fallidos y sesiones
+ * perdidas, y comprueba que nunca se repite un contador de subida ni un
+ * devNonce, que tras un corte el contador salta como mucho
+ * SESSION_FCNT_COMMIT_INTERVAL valores y que el desgaste de NVS coincide
+ * con la estimación del módulo.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include <map>
+#include <random>
+#include <set>
+#include "../../config/config.h"
+#undef ENABLE_SESSION_PERSISTENCE
+#define ENABLE_SESSION_PERSISTENCE true
+#include <esp_partition.h>
+#include "../../src/boot_mode.cpp"
+#include "../../src/lorawan_session.cpp"
+
+#define NVS_PARTITION_BYTES 0x5000  // partitions.csv
+#define SIM_YEARS 10
+#define SIM_WAKES ((uint32_t)(SIM_YEARS * SECONDS_PER_YEAR / SEND_INTERVAL_SECONDS))
+
+static std::mt19937 rng(42);
+
+/**
+ * @brief Despertar: LMIC_reset() elige un devNonce al azar y descarta la sesión
+ */
+static bool wake(bool cold) {
+    host_wakeup_cause = cold ? ESP_SLEEP_WAKEUP_UNDEFINED : ESP_SLEEP_WAKEUP_TIMER;
+    memset(&LMIC, 0, sizeof(LMIC));
+    LMIC.devNonce = (uint16_t)rng();
+    return lorawan_session_resume();
+}
+
+/**
+ * @brief Join aceptado con la dirección indicada (EV_JOINED)
+ */
+static void join(uint32_t devaddr) {
+    LMIC.devNonce++;
+    lorawan_session_update();
+    LMIC.devaddr = devaddr;
+    LMIC.netid = 0x13;
+    LMIC.seqnoUp = 0;
+    LMIC.seqnoDn = 0;
+    LMIC.rxDelay = 5;
+    lorawan_session_save();
+}
+
+/**
+ * @brief Construye una trama: LMIC usa seqnoUp y lo incrementa
+ */
+static uint32_t build_frame(void) {
+    LMIC.opmode |= OP_TXRXPEND;
+    return LMIC.seqnoUp++;
+}
+
+void setUp(void) {
+    Preferences::reset();
+    host_partition_add("nvs", ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_NVS, NVS_PARTITION_BYTES);
+}
+
+void tearDown(void) {}
+
+void test_warm_wake_keeps_counters(void) {
+    TEST_ASSERT_FALSE(wake(true));
+    join(0x2601ABCD);
+    for (int i = 0; i < 5; i++) {
+        build_frame();
+        LMIC.opmode &= ~OP_TXRXPEND;
+        lorawan_session_update();
+    }
+    LMIC.seqnoDn = 3;
+    lorawan_session_update();
+    const uint32_t writes = Preferences::writes;
+
+    TEST_ASSERT_TRUE(wake(false));
+    TEST_ASSERT_EQUAL_HEX32(0x2601ABCD, LMIC.devaddr);
+    TEST_ASSERT_EQUAL_UINT32(5, LMIC.seqnoUp);
+    TEST_ASSERT_EQUAL_UINT32(3, LMIC.seqnoDn);
+    TEST_ASSERT_EQUAL_UINT32(writes, Preferences::writes);
+}
+
+/**
+ * @brief La reserva del bloque siguiente espera a EV_TXCOMPLETE
+ */
+void test_reservation_waits_for_tx_complete(void) {
+    TEST_ASSERT_FALSE(wake(true));
+    join(0x2601ABCD);
+
+    for (uint32_t i = 0; i < SESSION_FCNT_COMMIT_INTERVAL - 1; i++) {
+        build_frame();
+        lorawan_session_update();
+        LMIC.opmode &= ~OP_TXRXPEND;
+        lorawan_session_update();
+    }
+    const uint32_t writes = Preferences::writes;
+
+    // La trama que llega al límite: nada en NVS mientras está en el aire
+    TEST_ASSERT_EQUAL_UINT32(SESSION_FCNT_COMMIT_INTERVAL - 1, build_frame());
+    lorawan_session_update();
+    TEST_ASSERT_EQUAL_UINT32(writes, Preferences::writes);
+
+    LMIC.opmode &= ~OP_TXRXPEND;  // EV_TXCOMPLETE
+    lorawan_session_update();
+    TEST_ASSERT_EQUAL_UINT32(writes + 1, Preferences::writes);
+
+    // Un corte ahora continúa en el límite nuevo
+    TEST_ASSERT_TRUE(wake(true));
+    TEST_ASSERT_EQUAL_UINT32(2 * SESSION_FCNT_COMMIT_INTERVAL, LMIC.seqnoUp);
+}
+
+/**
+ * @brief Corte con la trama del límite en el aire: la siguiente no repite contador
+ */
+void test_power_cut_before_tx_complete(void) {
+    TEST_ASSERT_FALSE(wake(true));
+    join(0x2601ABCD);
+    uint32_t last = 0;
+    for (uint32_t i = 0; i < SESSION_FCNT_COMMIT_INTERVAL; i++) {
+        last = build_frame();
+        lorawan_session_update();
+        if (i + 1 < SESSION_FCNT_COMMIT_INTERVAL) {
+            LMIC.opmode &= ~OP_TXRXPEND;
+            lorawan_session_update();
+        }
+    }
+
+    TEST_ASSERT_TRUE(wake(true));
+    TEST_ASSERT_EQUAL_UINT32(last + 1, LMIC.seqnoUp);
+}
+
+void test_ten_year_simulation(void) {
+    std::map<uint32_t, uint32_t> lastUp;  // devaddr -> último contador usado
+    std::set<uint16_t> nonces;
+    uint32_t coldBoots = 0, powerCuts = 0, joins = 0, sessions = 0;
+    uint32_t counterReuse = 0, nonceReuse = 0, maxGap = 0, writesDuringTx = 0;
+    uint32_t nextAddr = 1;
+    bool cutPending = false;
+
+    for (uint32_t w = 0; w < SIM_WAKES; w++) {
+        const bool cold = w == 0 || cutPending || rng() % 2000 == 0;  // Corte cada ~7 días
+        cutPending = false;
+        coldBoots += cold;
+
+        if (!wake(cold)) {
+            const int failed = rng() % 3;  // Joins fallidos antes del aceptado
+            for (int t = 0; t <= failed; t++) {
+                nonceReuse += !nonces.insert(LMIC.devNonce).second;
+                joins++;
+                if (t < failed) {
+                    LMIC.devNonce++;
+                    lorawan_session_update();
+                }
+            }
+            join(nextAddr++);
+            sessions++;
+        }
+
+        auto it = lastUp.find(LMIC.devaddr);
+        const uint32_t up = build_frame();
+        if (it != lastUp.end()) {
+            counterReuse += up <= it->second;
+            maxGap = std::max(maxGap, up - it->second);
+        }
+        lastUp[LMIC.devaddr] = up;
+
+        const uint32_t writes = Preferences::writes;
+        lorawan_session_update();  // Iteraciones con la trama en el aire
+        writesDuringTx += Preferences::writes != writes;
+        if (rng() % 5000 == 0) {
+            cutPending = true;     // Corte antes de EV_TXCOMPLETE
+            powerCuts++;
+            continue;
+        }
+        LMIC.opmode &= ~OP_TXRXPEND;
+        lorawan_session_update();
+        if (rng() % 50000 == 0) {
+            lorawan_session_forget();  // EV_LINK_DEAD
+        }
+        lorawan_session_update();  // enterDeepSleep()
+    }
+
+    lorawan_session_stats_t st;
+    lorawan_session_get_stats(&st);
+    const uint32_t pages = NVS_PARTITION_BYTES / NVS_PAGE_BYTES - 1;
+    const double cyclesPerPage = (double)Preferences::entries / (pages * NVS_ENTRIES_PER_PAGE);
+
+    char msg[240];
+    snprintf(msg, sizeof(msg),
+             "%d años, %lu envíos: %lu arranques en frío (%lu con trama en el aire), %lu sesiones, %lu joins, "
+             "salto máximo %lu",
+             SIM_YEARS, (unsigned long)SIM_WAKES, (unsigned long)coldBoots, (unsigned long)powerCuts,
+             (unsigned long)sessions, (unsigned long)joins, (unsigned long)maxGap);
+    TEST_MESSAGE(msg);
+    snprintf(msg, sizeof(msg),
+             "NVS: %llu entradas, %.1f ciclos de borrado por página en %d años (estimación %.1f/año, %.0f años)",
+             (unsigned long long)Preferences::entries, cyclesPerPage, SIM_YEARS, st.eraseCyclesPerYear,
+             st.enduranceYears);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_EQUAL_UINT32(0, counterReuse);
+    TEST_ASSERT_EQUAL_UINT32(0, nonceReuse);
+    TEST_ASSERT_EQUAL_UINT32(0, writesDuringTx);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(SESSION_FCNT_COMMIT_INTERVAL + 1, maxGap);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, powerCuts);
+
+    // Desgaste: dentro de la vida de la flash y del orden de la estimación
+    // (que no cuenta sesiones, devNonce ni arranques en frío)
+    TEST_ASSERT_LESS_THAN(NVS_ERASE_CYCLES, cyclesPerPage);
+    TEST_ASSERT_GREATER_OR_EQUAL(SIM_YEARS, st.enduranceYears);
+    TEST_ASSERT_GREATER_OR_EQUAL(st.eraseCyclesPerYear * SIM_YEARS, cyclesPerPage);
+    TEST_ASSERT_LESS_THAN(st.eraseCyclesPerYear * SIM_YEARS * 2, cyclesPerPage);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_warm_wake_keeps_counters);
+    RUN_TEST(test_reservation_waits_for_tx_complete);
+    RUN_TEST(test_power_cut_before_tx_complete);
+    RUN_TEST(test_ten_year_simulation);
+    return UNITY_END();
+}
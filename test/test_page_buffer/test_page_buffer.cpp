@@ -0,0 +1,155 @@
+/**
+ * @file      test_page_buffer.cpp
+ * @brief     Buffer completo (_F) frente a buffer por páginas (_2, _1): RAM, bus y CPU
+ *
+ * Los tres modos dibujan la misma secuencia de fotogramas que screen.cpp
+ * con drawFrame(): _F limpia, dibuja y envía los tiles modificados; _2 y _1
+ * repiten el dibujo en el bucle firstPage()/nextPage(). Se comprueba que la
+ * pantalla simulada acaba igual en los tres y se mide la RAM del buffer, los
+ * bytes I2C por fotograma y el tiempo de dibujo en el PC.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include <chrono>
+#include "display_sim.h"
+#include "host_font.h"
+#include "screen_types.h"
+
+#define I2C_HZ 800000  // DISPLAY_I2C_CLOCK_HZ
+#define REPEAT 200
+
+static U8G2_SSD1306_128X64_NONAME_F_HW_I2C fullDisplay(U8G2_R0);
+static U8G2_SSD1306_128X64_NONAME_2_HW_I2C page2Display(U8G2_R0);
+static U8G2_SSD1306_128X64_NONAME_1_HW_I2C page1Display(U8G2_R0);
+
+static U8G2* target;
+static bool indicators;
+
+static void drawMessageFrame(void) {
+    target->setFont(SCREEN_FONT);
+    target->drawStr(0, SCREEN_HEADER_Y, "[INFO]");
+    target->drawStr(0, SCREEN_TEXT_FIRST_Y, "Enviando datos");
+    target->drawStr(0, SCREEN_TEXT_FIRST_Y + SCREEN_TEXT_LINE_STEP, "LoRaWAN SF10");
+    if (indicators) {
+        target->drawPixel(125, 1);
+        target->drawPixel(126, 1);
+        target->drawPixel(125, 2);
+        target->drawPixel(126, 2);
+    }
+}
+
+static void drawSensorFrame(void) {
+    target->setFont(SCREEN_FONT);
+    target->drawStr(0, SCREEN_HEADER_Y, "[SENSOR]");
+    target->drawStr(0, SCREEN_TEXT_FIRST_Y, "Temp: 21.5 C");
+    target->drawStr(0, SCREEN_TEXT_FIRST_Y + SCREEN_TEXT_LINE_STEP, "Hum: 48 %");
+    target->drawStr(0, SCREEN_TEXT_FIRST_Y + 2 * SCREEN_TEXT_LINE_STEP, "Bat: 3.92 V");
+    target->drawFrame(0, 0, 128, 64);
+}
+
+/**
+ * @brief drawFrame() de screen.cpp para el modo de la pantalla
+ */
+static void draw_frame(U8G2& display, bool paged, void (*draw)(void)) {
+    target = &display;
+    if (paged) {
+        display.firstPage();
+        do {
+            draw();
+        } while (display.nextPage());
+    } else {
+        display.clearBuffer();
+        draw();
+        display.updateDirty();
+    }
+}
+
+typedef struct {
+    const char* name;
+    U8G2* display;
+    bool paged;
+    uint32_t ramBytes;
+    uint32_t bytes[3];
+    double busUs[3];
+    double cpuUs[3];
+    uint8_t panel[3][sizeof(display_sim.ram)];
+} mode_result_t;
+
+static mode_result_t results[3] = {
+    {"_F", &fullDisplay, false},
+    {"_2", &page2Display, true},
+    {"_1", &page1Display, true},
+};
+
+/**
+ * @brief Mensaje, el mismo mensaje redibujado con los indicadores y datos del sensor
+ */
+static void run_sequence(mode_result_t& r) {
+    using clock = std::chrono::steady_clock;
+    display_sim_attach(*r.display);
+    r.ramBytes = r.display->getBufferTileHeight() * r.display->getBufferTileWidth() * 8;
+
+    void (*const draws[3])(void) = {drawMessageFrame, drawMessageFrame, drawSensorFrame};
+    for (int f = 0; f < 3; f++) {
+        indicators = (f == 1);
+        display_sim.clearCounters();
+        draw_frame(*r.display, r.paged, draws[f]);
+        r.bytes[f] = display_sim.bytes;
+        r.busUs[f] = display_sim.busMicros(I2C_HZ);
+        memcpy(r.panel[f], display_sim.ram, sizeof(display_sim.ram));
+
+        // CPU: el mismo fotograma repetido, incluido el envío a la pantalla simulada
+        double best = 1e30;
+        for (int i = 0; i < 5; i++) {
+            const auto t0 = clock::now();
+            for (int n = 0; n < REPEAT; n++) {
+                draw_frame(*r.display, r.paged, draws[f]);
+            }
+            const double us = std::chrono::duration<double, std::micro>(clock::now() - t0).count() / REPEAT;
+            best = us < best ? us : best;
+        }
+        r.cpuUs[f] = best;
+    }
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_page_modes_match_full_buffer(void) {
+    for (mode_result_t& r : results) {
+        run_sequence(r);
+    }
+    for (int f = 0; f < 3; f++) {
+        TEST_ASSERT_EQUAL_MEMORY(results[0].panel[f], results[1].panel[f], sizeof(display_sim.ram));
+        TEST_ASSERT_EQUAL_MEMORY(results[0].panel[f], results[2].panel[f], sizeof(display_sim.ram));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(1024, results[0].ramBytes);
+    TEST_ASSERT_EQUAL_UINT32(256, results[1].ramBytes);
+    TEST_ASSERT_EQUAL_UINT32(128, results[2].ramBytes);
+
+    // Las páginas reenvían el fotograma entero; _F solo lo modificado
+    TEST_ASSERT_LESS_THAN(results[1].bytes[1], results[0].bytes[1]);
+    TEST_ASSERT_EQUAL_UINT32(results[1].bytes[2], results[2].bytes[2]);
+
+    for (const mode_result_t& r : results) {
+        char msg[220];
+        snprintf(msg, sizeof(msg),
+                 "%s: buffer %4lu B; mensaje %lu B / %.0f us bus / %.0f us CPU; redibujado con indicadores %lu B / %.0f us; "
+                 "sensor %lu B / %.0f us CPU",
+                 r.name, (unsigned long)r.ramBytes, (unsigned long)r.bytes[0], r.busUs[0], r.cpuUs[0],
+                 (unsigned long)r.bytes[1], r.busUs[1], (unsigned long)r.bytes[2], r.cpuUs[2]);
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_page_modes_match_full_buffer);
+    return UNITY_END();
+}
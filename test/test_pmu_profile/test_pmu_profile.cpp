@@ -0,0 +1,174 @@
+/**
+ * @file      test_pmu_profile.cpp
+ * @brief     Transacciones I2C para entrar en sueño profundo: perfil frente a la secuencia anterior
+ *
+ * La secuencia anterior de disablePeripherals() (disable*Measure(), LED de
+ * carga, disableIRQ() y disablePowerOutput() uno a uno) se compara con
+ * pmu_profile_apply(PMU_PROFILE_DEEP_SLEEP) sobre el AXP192 y el AXP2101
+ * simulados: mismos raíles apagados e IRQ enmascaradas, menos transacciones.
+ * También se comprueba que el contador de culombios sigue contando durante
+ * el sueño y que pmu_profile_restore() recupera el estado activo.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include "pmu_sim.h"
+#include "../../src/pmu_profile.cpp"
+
+#define I2C_HZ 400000
+
+/**
+ * @brief Deja el simulador como tras beginPower() con todos los raíles encendidos
+ *
+ * También olvida la caché y el estado RTC del módulo (un arranque en frío).
+ */
+static void begin(uint8_t chip) {
+    if (chip == XPOWERS_AXP2101) {
+        PMU = pmu_sim_begin_axp2101();
+        pmu_sim.regs[XPOWERS_AXP2101_LDO_ONOFF_CTRL0] = 0x37;
+        pmu_sim.regs[XPOWERS_AXP2101_INTEN1] = 0xCC;
+        pmu_sim.regs[XPOWERS_AXP2101_INTEN2] = 0x0C;
+        pmu_sim.regs[XPOWERS_AXP2101_BAT_DET_CTRL] = 0x01;
+    } else {
+        PMU = pmu_sim_begin_axp192();
+        pmu_sim.regs[XPOWERS_AXP192_LDO23_DC123_EXT_CTL] = 0x4F;
+        pmu_sim.regs[XPOWERS_AXP192_INTEN1] = 0xFC;
+        pmu_sim.regs[XPOWERS_AXP192_INTEN2] = 0xFC;
+        pmu_sim.regs[XPOWERS_AXP192_OFF_CTL] = 0x40;
+        pmu_sim.regs[XPOWERS_AXP192_ADC_EN2] = 0x80;
+    }
+    cacheValid = false;
+    savedValid = false;
+    current = PMU_PROFILE_ACTIVE;
+    pmu_sim.clearCounters();
+}
+
+/**
+ * @brief Secuencia de disablePeripherals() antes de los perfiles (sin clearIrqStatus(), común a ambas)
+ */
+static void legacy_sleep_entry(void) {
+    PMU->setChargingLedMode(XPOWERS_CHG_LED_OFF);
+    PMU->disableSystemVoltageMeasure();
+    PMU->disableVbusVoltageMeasure();
+    PMU->disableBattVoltageMeasure();
+    PMU->disableTemperatureMeasure();
+    PMU->disableBattDetection();
+    if (PMU->getChipModel() == XPOWERS_AXP2101) {
+        PMU->disableIRQ(XPOWERS_AXP2101_ALL_IRQ);
+        PMU->disablePowerOutput(XPOWERS_ALDO2);
+        PMU->disablePowerOutput(XPOWERS_ALDO3);
+        PMU->disablePowerOutput(XPOWERS_ALDO1);
+        PMU->disablePowerOutput(XPOWERS_BLDO1);
+        PMU->disablePowerOutput(XPOWERS_BLDO2);
+    } else {
+        PMU->disableIRQ(XPOWERS_AXP192_ALL_IRQ);
+        PMU->disablePowerOutput(XPOWERS_LDO2);
+        PMU->disablePowerOutput(XPOWERS_LDO3);
+        PMU->disablePowerOutput(XPOWERS_DCDC1);
+    }
+}
+
+static void report(const char* chip, uint32_t legacy, double legacyUs, uint32_t profile, double profileUs) {
+    char msg[160];
+    snprintf(msg, sizeof(msg), "%s: secuencia anterior %lu transacciones / %.0f us, perfil %lu / %.0f us a %d kHz",
+             chip, (unsigned long)legacy, legacyUs, (unsigned long)profile, profileUs, I2C_HZ / 1000);
+    TEST_MESSAGE(msg);
+}
+
+/**
+ * @brief Compara ambas secuencias sobre el mismo estado inicial
+ */
+static void compare_sleep_entry(uint8_t chip, const char* name, const uint8_t* railRegs, const uint8_t* railMasks,
+                                size_t rails) {
+    begin(chip);
+    legacy_sleep_entry();
+    const uint32_t legacy = pmu_sim.transactions();
+    const double legacyUs = pmu_sim.busMicros(I2C_HZ);
+    uint8_t legacyRegs[256];
+    memcpy(legacyRegs, pmu_sim.regs, sizeof(legacyRegs));
+
+    begin(chip);
+    TEST_ASSERT_GREATER_THAN(0, pmu_profile_apply(PMU_PROFILE_DEEP_SLEEP));
+    const uint32_t profile = pmu_sim.transactions();
+    report(name, legacy, legacyUs, profile, pmu_sim.busMicros(I2C_HZ));
+
+    // Mismos raíles apagados e IRQ enmascaradas que la secuencia anterior
+    for (size_t i = 0; i < rails; i++) {
+        TEST_ASSERT_EQUAL_HEX8(legacyRegs[railRegs[i]] & railMasks[i], pmu_sim.regs[railRegs[i]] & railMasks[i]);
+    }
+    TEST_ASSERT_LESS_THAN(legacy, profile);
+    TEST_ASSERT_LESS_THAN(legacyUs, pmu_sim.busMicros(I2C_HZ));
+
+    // Aplicar otra vez el mismo perfil no escribe nada ni vuelve a leer
+    pmu_sim.clearCounters();
+    TEST_ASSERT_EQUAL_INT(0, pmu_profile_apply(PMU_PROFILE_DEEP_SLEEP));
+    TEST_ASSERT_EQUAL_UINT32(0, pmu_sim.transactions());
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_axp192_sleep_entry_transactions(void) {
+    const uint8_t regs[] = {XPOWERS_AXP192_LDO23_DC123_EXT_CTL, XPOWERS_AXP192_INTEN1, XPOWERS_AXP192_INTEN2,
+                            XPOWERS_AXP192_INTEN3, XPOWERS_AXP192_INTEN4, XPOWERS_AXP192_INTEN5,
+                            XPOWERS_AXP192_OFF_CTL};
+    const uint8_t masks[] = {0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x78};
+    compare_sleep_entry(XPOWERS_AXP192, "AXP192", regs, masks, sizeof(regs));
+    // El raíl del ESP32 (DC3, bit1) sigue encendido
+    TEST_ASSERT_BITS_HIGH(0x02, pmu_sim.regs[XPOWERS_AXP192_LDO23_DC123_EXT_CTL]);
+}
+
+void test_axp2101_sleep_entry_transactions(void) {
+    const uint8_t regs[] = {XPOWERS_AXP2101_LDO_ONOFF_CTRL0, XPOWERS_AXP2101_INTEN1, XPOWERS_AXP2101_INTEN2,
+                            XPOWERS_AXP2101_INTEN3, XPOWERS_AXP2101_ADC_CHANNEL_CTRL, XPOWERS_AXP2101_BAT_DET_CTRL};
+    const uint8_t masks[] = {0x37, 0xFF, 0xFF, 0xFF, 0x1D, 0x01};
+    compare_sleep_entry(XPOWERS_AXP2101, "AXP2101", regs, masks, sizeof(regs));
+}
+
+/**
+ * @brief El contador de culombios del AXP192 sigue integrando durante el sueño
+ */
+void test_axp192_coulomb_counter_runs_in_deep_sleep(void) {
+    begin(XPOWERS_AXP192);
+    XPowersAXP192* axp = static_cast<XPowersAXP192*>(PMU);
+    axp->enableCoulomb();
+    pmu_profile_apply(PMU_PROFILE_DEEP_SLEEP);
+
+    TEST_ASSERT_BITS_HIGH(0x40, pmu_sim.regs[XPOWERS_AXP192_ADC_EN1]);
+    // El resto de medidas sí se apaga
+    TEST_ASSERT_BITS_LOW(0x8E, pmu_sim.regs[XPOWERS_AXP192_ADC_EN1]);
+    TEST_ASSERT_BITS_LOW(0x80, pmu_sim.regs[XPOWERS_AXP192_ADC_EN2]);
+
+    // Una noche a 150 µA; el contador resuelve una cuenta
+    pmu_sim.addCharge(-0.150 * 12);
+    TEST_ASSERT_FLOAT_WITHIN(1.0 / pmu_sim.countsPerMah(), -1.8f, axp->getCoulombData());
+}
+
+void test_restore_recovers_active_state(void) {
+    begin(XPOWERS_AXP192);
+    uint8_t before[256];
+    memcpy(before, pmu_sim.regs, sizeof(before));
+    pmu_profile_apply(PMU_PROFILE_DEEP_SLEEP);
+
+    // Despertar: caché perdida, estado RTC conservado
+    cacheValid = false;
+    current = PMU_PROFILE_DEEP_SLEEP;
+    TEST_ASSERT_GREATER_THAN(0, pmu_profile_restore());
+    for (size_t i = 0; i < RULE_COUNT(AXP192_RULES); i++) {
+        TEST_ASSERT_EQUAL_HEX8(before[AXP192_RULES[i].reg], pmu_sim.regs[AXP192_RULES[i].reg]);
+    }
+    TEST_ASSERT_EQUAL(PMU_PROFILE_ACTIVE, pmu_profile_current());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_axp192_sleep_entry_transactions);
+    RUN_TEST(test_axp2101_sleep_entry_transactions);
+    RUN_TEST(test_axp192_coulomb_counter_runs_in_deep_sleep);
+    RUN_TEST(test_restore_recovers_active_state);
+    return UNITY_END();
+}
@@ -0,0 +1,206 @@
+/**
+ * @file      test_pmu_snapshot.cpp
+ * @brief     Transacciones I2C de getStatusSnapshot() frente a los getters sueltos
+ *
+ * Sobre el AXP192 y el AXP2101 simulados (pmu_sim.h) se lee el mismo estado
+ * de dos formas: con un getter por campo, como hacía el firmware, y con
+ * getStatusSnapshot(). Se comprueba que los campos decodificados coinciden y
+ * se cuentan transacciones, bytes y tiempo de bus estimado a 400 kHz.
+ *
+ * La última prueba recorre las lecturas de un ciclo del firmware (tensión
+ * de batería, corriente para el SoC y carga solar), que comparten un único
+ * snapshot a través de pmu_status.cpp. Ahí el tiempo de bus queda parejo
+ * (el bloque ADC entero frente a once lecturas de un byte); lo que baja es
+ * el número de transacciones, cada una con su coste fijo en el driver I2C.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include "pmu_sim.h"
+#include "../../src/battery_soc.cpp"
+#include "../../src/battery_adc.cpp"
+#include "../../src/pmu_status.cpp"
+#include "../../src/solar.cpp"
+
+#define I2C_HZ 400000
+
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes;
+    double busUs;
+} bus_cost_t;
+
+static bus_cost_t bus_cost(void) {
+    bus_cost_t c = {pmu_sim.transactions(), pmu_sim.bytesRead + pmu_sim.bytesWritten, pmu_sim.busMicros(I2C_HZ)};
+    pmu_sim.clearCounters();
+    return c;
+}
+
+static void report(const char* chip, bus_cost_t getters, bus_cost_t snapshot) {
+    char msg[200];
+    snprintf(msg, sizeof(msg),
+             "%s: getters %lu transacciones / %lu bytes / %.0f us, snapshot %lu / %lu / %.0f us a %d kHz",
+             chip, (unsigned long)getters.transactions, (unsigned long)getters.bytes, getters.busUs,
+             (unsigned long)snapshot.transactions, (unsigned long)snapshot.bytes, snapshot.busUs, I2C_HZ / 1000);
+    TEST_MESSAGE(msg);
+}
+
+/**
+ * @brief Estado típico de un nodo en la mesa: USB conectado y batería cargando
+ */
+static void set_state(float battery, float current) {
+    pmu_sim.setBattery(battery);
+    pmu_sim.setVbus(true, 5.0f);
+    pmu_sim.setSystem(4.9f);
+    pmu_sim.setTemperature(36.0f);
+    pmu_sim.setCurrent(current);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_axp192_snapshot_matches_getters(void) {
+    XPowersAXP192* pmu = pmu_sim_begin_axp192();
+    set_state(3.95f, -320.0f);
+    pmu_sim.clearCounters();
+
+    XPowersStatusSnapshot_t g;
+    g.vbusIn = pmu->isVbusIn();
+    g.batteryConnected = pmu->isBatteryConnect();
+    g.charging = pmu->isCharging();
+    g.discharging = pmu->isDischarge();
+    g.battVoltage = pmu->getBattVoltage();
+    g.vbusVoltage = pmu->getVbusVoltage();
+    g.systemVoltage = pmu->getSystemVoltage();
+    g.temperature = pmu->getTemperature();
+    g.chargeCurrent = pmu->getBatteryChargeCurrent();
+    g.dischargeCurrent = pmu->getBattDischargeCurrent();
+    const bus_cost_t getters = bus_cost();
+
+    XPowersStatusSnapshot_t s;
+    TEST_ASSERT_TRUE(pmu->getStatusSnapshot(s));
+    const bus_cost_t snapshot = bus_cost();
+    report("AXP192", getters, snapshot);
+
+    TEST_ASSERT_TRUE(s.vbusIn);
+    TEST_ASSERT_TRUE(s.charging);
+    TEST_ASSERT_EQUAL(g.vbusIn, s.vbusIn);
+    TEST_ASSERT_EQUAL(g.batteryConnected, s.batteryConnected);
+    TEST_ASSERT_EQUAL(g.charging, s.charging);
+    TEST_ASSERT_EQUAL(g.discharging, s.discharging);
+    TEST_ASSERT_EQUAL_UINT16(g.battVoltage, s.battVoltage);
+    TEST_ASSERT_EQUAL_UINT16(g.vbusVoltage, s.vbusVoltage);
+    TEST_ASSERT_EQUAL_UINT16(g.systemVoltage, s.systemVoltage);
+    TEST_ASSERT_EQUAL_FLOAT(g.temperature, s.temperature);
+    TEST_ASSERT_EQUAL_FLOAT(g.chargeCurrent, s.chargeCurrent);
+    TEST_ASSERT_EQUAL_FLOAT(g.dischargeCurrent, s.dischargeCurrent);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 320.0f, s.chargeCurrent);
+
+    TEST_ASSERT_EQUAL_UINT32(2, snapshot.transactions);
+    TEST_ASSERT_GREATER_OR_EQUAL(4 * snapshot.transactions, getters.transactions);
+    TEST_ASSERT_LESS_THAN(getters.busUs, snapshot.busUs);
+}
+
+void test_axp192_snapshot_without_battery(void) {
+    XPowersAXP192* pmu = pmu_sim_begin_axp192();
+    set_state(3.95f, 100.0f);
+    pmu_sim.setBattery(3.95f, false);
+    XPowersStatusSnapshot_t s;
+    TEST_ASSERT_TRUE(pmu->getStatusSnapshot(s));
+    TEST_ASSERT_FALSE(s.batteryConnected);
+    TEST_ASSERT_EQUAL_UINT16(pmu->getBattVoltage(), s.battVoltage);
+    TEST_ASSERT_EQUAL_UINT16(0, s.battVoltage);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, s.dischargeCurrent);
+}
+
+void test_axp2101_snapshot_matches_getters(void) {
+    XPowersAXP2101* pmu = pmu_sim_begin_axp2101();
+    set_state(3.80f, 150.0f);
+    pmu_sim.clearCounters();
+
+    XPowersStatusSnapshot_t g;
+    g.vbusIn = pmu->isVbusIn();
+    g.batteryConnected = pmu->isBatteryConnect();
+    g.charging = pmu->isCharging();
+    g.discharging = pmu->isDischarge();
+    g.battVoltage = pmu->getBattVoltage();
+    g.vbusVoltage = pmu->getVbusVoltage();
+    g.systemVoltage = pmu->getSystemVoltage();
+    g.temperature = pmu->getTemperature();
+    const bus_cost_t getters = bus_cost();
+
+    XPowersStatusSnapshot_t s;
+    TEST_ASSERT_TRUE(pmu->getStatusSnapshot(s));
+    const bus_cost_t snapshot = bus_cost();
+    report("AXP2101", getters, snapshot);
+
+    TEST_ASSERT_TRUE(s.discharging);
+    TEST_ASSERT_EQUAL(g.vbusIn, s.vbusIn);
+    TEST_ASSERT_EQUAL(g.batteryConnected, s.batteryConnected);
+    TEST_ASSERT_EQUAL(g.charging, s.charging);
+    TEST_ASSERT_EQUAL(g.discharging, s.discharging);
+    TEST_ASSERT_EQUAL_UINT16(3800, s.battVoltage);
+    TEST_ASSERT_EQUAL_UINT16(g.battVoltage, s.battVoltage);
+    TEST_ASSERT_EQUAL_UINT16(g.vbusVoltage, s.vbusVoltage);
+    TEST_ASSERT_EQUAL_UINT16(g.systemVoltage, s.systemVoltage);
+    TEST_ASSERT_EQUAL_FLOAT(g.temperature, s.temperature);
+
+    TEST_ASSERT_EQUAL_UINT32(2, snapshot.transactions);
+    TEST_ASSERT_GREATER_OR_EQUAL(4 * snapshot.transactions, getters.transactions);
+    TEST_ASSERT_LESS_THAN(getters.busUs, snapshot.busUs);
+}
+
+float readBatteryVoltage() {
+    return battery_read_voltage();
+}
+
+/**
+ * @brief Lecturas del PMU en un ciclo: getters sueltos frente al snapshot compartido
+ *
+ * Con getters, battery_adc elegía la fuente y leía la tensión, battery_soc
+ * preguntaba el estado de carga y una corriente, y solar.cpp VBUS y carga.
+ */
+void test_axp192_cycle_shares_one_snapshot(void) {
+    PMU = pmu_sim_begin_axp192();
+    XPowersAXP192* pmu = static_cast<XPowersAXP192*>(PMU);
+    set_state(3.70f, -240.0f);
+    pmu_sim.clearCounters();
+
+    const float voltage = pmu->getBattVoltage() / 1000.0f;
+    pmu->getBattVoltage();
+    const float current = pmu->isCharging() ? -pmu->getBatteryChargeCurrent() : pmu->getBattDischargeCurrent();
+    const bool solar = pmu->isVbusIn() && pmu->isCharging();
+    const bus_cost_t getters = bus_cost();
+
+    TEST_ASSERT_FLOAT_WITHIN(0.002f, voltage, battery_read_voltage());
+    TEST_ASSERT_EQUAL_FLOAT(current, battery_current_ma());
+    TEST_ASSERT_EQUAL(solar, isSolarChargingBattery());
+    const bus_cost_t cycle = bus_cost();
+    report("AXP192 ciclo (tensión, corriente para el SoC, carga solar)", getters, cycle);
+
+    TEST_ASSERT_TRUE(solar);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, -240.0f, current);
+    TEST_ASSERT_EQUAL_UINT32(2, cycle.transactions);
+    TEST_ASSERT_GREATER_OR_EQUAL(4 * cycle.transactions, getters.transactions);
+
+    // Nuevo despertar: una lectura más, no una por consulta
+    pmu_status_invalidate();
+    battery_invalidate_cache();
+    battery_read_voltage();
+    battery_current_ma();
+    isSolarChargingBattery();
+    TEST_ASSERT_EQUAL_UINT32(2, bus_cost().transactions);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_axp192_snapshot_matches_getters);
+    RUN_TEST(test_axp192_snapshot_without_battery);
+    RUN_TEST(test_axp2101_snapshot_matches_getters);
+    RUN_TEST(test_axp192_cycle_shares_one_snapshot);
+    return UNITY_END();
+}
@@ -0,0 +1,51 @@
+/**
+ * @file      test_screen.cpp
+ * @brief     Imágenes de referencia de screen.cpp con buffer completo
+ *
+ * Recorre los pasos de screen_scenario.h (bienvenida, mensajes con reparto
+ * en líneas, datos del sensor, mensaje fijo, indicadores, caducidad y
+ * apagado) y compara lo que recibe el panel simulado con las imágenes PBM
+ * de golden/. Tras cada paso el panel debe coincidir además con el buffer:
+ * el envío de tiles modificados no puede dejar restos.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include "screen_scenario.h"
+#include "../../src/screen.cpp"
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_screen_goldens(void) {
+    TEST_ASSERT_TRUE(beginDisplay());
+    for (size_t i = 0; i < SCREEN_STEP_COUNT; i++) {
+        SCREEN_STEPS[i].run();
+        TEST_ASSERT_TRUE_MESSAGE(display_sim_matches(*u8g2), SCREEN_STEPS[i].name);
+        const std::string error = screen_check_golden(SCREEN_STEPS[i].name);
+        TEST_ASSERT_TRUE_MESSAGE(error.empty(), error.c_str());
+    }
+}
+
+/**
+ * @brief El mismo mensaje otra vez no reenvía más que los tiles que dibuja
+ */
+void test_repeated_message_sends_only_drawn_tiles(void) {
+    showInfo("Enviando datos");
+    display_sim.clearCounters();
+    showInfo("Enviando datos");
+    TEST_ASSERT_GREATER_THAN(0, display_sim.tiles);
+    TEST_ASSERT_LESS_THAN(DISPLAY_SIM_TILE_WIDTH * DISPLAY_SIM_TILE_HEIGHT, display_sim.tiles);
+    TEST_ASSERT_TRUE(display_sim_matches(*u8g2));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_screen_goldens);
+    RUN_TEST(test_repeated_message_sends_only_drawn_tiles);
+    return UNITY_END();
+}
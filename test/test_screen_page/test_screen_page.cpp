@@ -0,0 +1,42 @@
+/**
+ * @file      test_screen_page.cpp
+ * @brief     screen.cpp con buffer por páginas frente a las imágenes de referencia
+ *
+ * Mismos pasos que test_screen con DISPLAY_PAGE_BUFFER 1 (variante _1 de la
+ * SSD1306): el panel simulado debe recibir exactamente las mismas imágenes
+ * de test/test_screen/golden/ que con el buffer completo.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#define DISPLAY_PAGE_BUFFER 1
+
+#include <unity.h>
+#include "screen_scenario.h"
+#include "../../src/screen.cpp"
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_page_buffer_type(void) {
+    TEST_ASSERT_TRUE(beginDisplay());
+    TEST_ASSERT_EQUAL_UINT8(1, u8g2->getBufferTileHeight());
+}
+
+void test_screen_goldens_page_buffer(void) {
+    for (size_t i = 0; i < SCREEN_STEP_COUNT; i++) {
+        SCREEN_STEPS[i].run();
+        const std::string error = screen_check_golden(SCREEN_STEPS[i].name);
+        TEST_ASSERT_TRUE_MESSAGE(error.empty(), error.c_str());
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_page_buffer_type);
+    RUN_TEST(test_screen_goldens_page_buffer);
+    return UNITY_END();
+}
@@ -0,0 +1,182 @@
+/**
+ * @file      test_sd_logger.cpp
+ * @brief     Registro en la SD: bloques completos, rotación, recuperación y escrituras cortas
+ *
+ * Tarjeta en memoria (stubs/SD.h) con archivos de 4 KB para que roten a
+ * menudo. Cada lectura va seguida de un sd_logger_flush(), como un
+ * despertar por lectura: los archivos deben quedar en bloques completos y
+ * abrirse muchas menos veces que una apertura por lectura. Una escritura
+ * corta que deja un registro a medias debe continuar en un archivo nuevo
+ * sin perder ni repetir registros.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include <string>
+#include "../../config/config.h"
+#undef ENABLE_SD_LOGGER
+#define ENABLE_SD_LOGGER true
+#undef SD_LOG_MAX_FILE_BYTES
+#define SD_LOG_MAX_FILE_BYTES 4096UL
+#include "../../src/boot_mode.cpp"
+#include "../../src/sd_logger.cpp"
+
+#define BENCH_RECORDS 1000
+
+static uint32_t logged = 0;
+
+/**
+ * @brief Arranque: en frío se reconstruye el estado desde la tarjeta
+ */
+static void boot(bool cold) {
+    host_wakeup_cause = cold ? ESP_SLEEP_WAKEUP_UNDEFINED : ESP_SLEEP_WAKEUP_TIMER;
+    TEST_ASSERT_TRUE(sd_logger_begin());
+}
+
+/**
+ * @brief Un despertar: una lectura y el vaciado antes de dormir
+ */
+static void log_and_flush(uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        sensor_data_t d = {};
+        d.temperature = (float)logged++;
+        d.valid = true;
+        TEST_ASSERT_TRUE(sd_logger_append(&d));
+        sd_logger_flush();
+        boot(false);
+    }
+}
+
+/**
+ * @brief Todos los registros, en orden, sin huecos ni repeticiones
+ */
+static void check_tail(uint32_t expected) {
+    static sd_log_record_t out[BENCH_RECORDS * 2];
+    const size_t n = sd_logger_read_tail(out, BENCH_RECORDS * 2);
+    TEST_ASSERT_EQUAL_UINT32(expected, n);
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i, out[i].sequence);
+        TEST_ASSERT_EQUAL_FLOAT(i, out[i].data.temperature);
+    }
+}
+
+static uint32_t log_files(uint32_t* bytes = NULL) {
+    uint32_t n = 0;
+    for (const auto& f : SD.files) {
+        if (f.first.find("/LOG") != std::string::npos) {
+            n++;
+            if (bytes) {
+                *bytes += f.second.size();
+            }
+        }
+    }
+    return n;
+}
+
+void setUp(void) {
+    SD.reset();
+    logged = 0;
+    boot(true);
+}
+
+void tearDown(void) {}
+
+void test_flush_writes_whole_blocks(void) {
+    log_and_flush(BENCH_RECORDS);
+    sd_logger_stats_t st;
+    sd_logger_get_stats(&st);
+
+    for (const auto& f : SD.files) {
+        if (f.first.find("/LOG") != std::string::npos) {
+            TEST_ASSERT_EQUAL_UINT32(0, f.second.size() % SD_LOG_BLOCK_BYTES);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(BENCH_RECORDS, st.records);
+    TEST_ASSERT_EQUAL_UINT32(0, st.dropped);
+    check_tail(BENCH_RECORDS);
+
+    uint32_t logBytes = 0;
+    const uint32_t files = log_files(&logBytes);
+    char msg[160];
+    snprintf(msg, sizeof(msg),
+             "%u registros de %u B: %lu bytes escritos para %lu de registros (%.3fx con el índice), "
+             "%lu aperturas, %lu archivos",
+             (unsigned)BENCH_RECORDS, (unsigned)RECORD_BYTES, (unsigned long)st.bytesWritten,
+             (unsigned long)logBytes, st.bytesWritten / (double)logBytes, (unsigned long)SD.opens,
+             (unsigned long)files);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_THAN(BENCH_RECORDS / 5, SD.opens);
+}
+
+void test_cold_boot_resumes_sequence(void) {
+    log_and_flush(300);
+    const uint32_t onCard = (300 * RECORD_BYTES / SD_LOG_BLOCK_BYTES) * SD_LOG_BLOCK_BYTES / RECORD_BYTES;
+
+    // Lo que seguía en memoria RTC se pierde con ella
+    boot(true);
+    check_tail(onCard);
+    logged = onCard;
+    log_and_flush(100);
+    TEST_ASSERT_EQUAL_UINT32(0, sd_logger_sync() % RECORD_BYTES);
+    check_tail(onCard + 100);
+}
+
+/**
+ * @brief Una escritura corta deja medio registro: lo siguiente va a un archivo nuevo
+ */
+void test_short_write_starts_new_file(void) {
+    log_and_flush(40);                         // Un bloque escrito, 8 registros en RTC
+    const uint32_t files = log_files();
+
+    SD.writeBudget = SD_LOG_BLOCK_BYTES / 2 + RECORD_BYTES / 2;  // Corta a mitad de un registro
+    log_and_flush(16);
+    SD.writeBudget = -1;
+    log_and_flush(100);
+
+    TEST_ASSERT_EQUAL_UINT32(files + 1, log_files());
+    TEST_ASSERT_EQUAL_UINT32(0, sd_logger_sync() % RECORD_BYTES);
+    check_tail(156);
+
+    // Solo el archivo cortado tiene un registro a medias; el nuevo empieza alineado
+    uint32_t torn = 0;
+    for (const auto& f : SD.files) {
+        if (f.first.find("/LOG") != std::string::npos) {
+            torn += (f.second.size() % RECORD_BYTES) != 0;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, torn);
+
+    // Un arranque en frío tampoco sigue detrás del registro cortado
+    boot(true);
+    logged = 156;
+    log_and_flush(20);
+    sd_logger_sync();
+    check_tail(176);
+}
+
+void test_card_full_drops_when_buffer_full(void) {
+    SD.writeBudget = 0;
+    const uint32_t capacity = SD_LOG_BUFFER_BYTES / RECORD_BYTES;
+    for (uint32_t i = 0; i < capacity; i++) {
+        sensor_data_t d = {};
+        TEST_ASSERT_TRUE(sd_logger_append(&d));
+        sd_logger_flush();
+    }
+    sensor_data_t d = {};
+    TEST_ASSERT_FALSE(sd_logger_append(&d));
+    sd_logger_stats_t st;
+    sd_logger_get_stats(&st);
+    TEST_ASSERT_EQUAL_UINT32(1, st.dropped);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_flush_writes_whole_blocks);
+    RUN_TEST(test_cold_boot_resumes_sequence);
+    RUN_TEST(test_short_write_starts_new_file);
+    RUN_TEST(test_card_full_drops_when_buffer_full);
+    return UNITY_END();
+}
@@ -0,0 +1,182 @@
+/**
+ * @file      test_spsc_queue.cpp
+ * @brief     SpscQueue y la salida diferida con dos núcleos, con dos hilos reales
+ *
+ * Un hilo hace de tarea de LMIC (productor) y otro de loop() (consumidor).
+ * La cola cruda debe entregar todos los mensajes en orden y sin lecturas a
+ * medias; la salida diferida con ENABLE_DUAL_CORE puede descartar log y
+ * pantalla con la cola llena, pero nunca un deferred_call(), y debe
+ * mantener el orden entre ambos.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "../../config/config.h"
+#undef ENABLE_DUAL_CORE
+#define ENABLE_DUAL_CORE true
+#include "../../src/deferred_output.cpp"
+
+#define STRESS_MESSAGES 200000
+#define STRESS_SENDS 20000
+#define PAYLOAD_WORDS 15
+
+// ---------------------------------------------------------------------------
+// Cola cruda
+
+typedef struct {
+    uint32_t seq;
+    uint32_t payload[PAYLOAD_WORDS];  // Derivado de seq: detecta copias a medias
+} stress_msg_t;
+
+static SpscQueue<stress_msg_t, 8> rawQueue;
+
+static uint32_t payload_word(uint32_t seq, int i) {
+    return seq * 2654435761u + (uint32_t)i;
+}
+
+// ---------------------------------------------------------------------------
+// Salida diferida: pantalla y llamadas se ejecutan en el hilo de loop()
+
+static std::atomic<bool> producerDone{false};
+static uint32_t callsRun = 0;
+static uint32_t showsRun = 0;
+static uint32_t outOfOrder = 0;
+
+/**
+ * @brief Fotograma lento (~2 µs) para que la cola llegue a llenarse
+ */
+static void busy_wait_us(int us) {
+    const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(us);
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+void showMessage(ScreenMessageType type, const char* text, uint32_t duration) {
+    // El envío k encola "k" y después su llamada: las llamadas anteriores ya corrieron
+    if ((uint32_t)atol(text) != callsRun) {
+        outOfOrder++;
+    }
+    showsRun++;
+    busy_wait_us(2);
+}
+
+void showStatus(StatusMessage id, uint32_t duration) {}
+
+static void markCall(void) {
+    callsRun++;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_raw_queue_two_threads(void) {
+    uint32_t received = 0;
+    uint32_t errors = 0;
+
+    std::thread consumer([&] {
+        stress_msg_t m;
+        while (received < STRESS_MESSAGES) {
+            if (!rawQueue.pop(m)) {
+                std::this_thread::yield();  // Con un solo núcleo en el PC, dejar correr al productor
+                continue;
+            }
+            errors += (m.seq != received);
+            for (int i = 0; i < PAYLOAD_WORDS; i++) {
+                errors += (m.payload[i] != payload_word(m.seq, i));
+            }
+            received++;
+        }
+    });
+
+    const auto t0 = std::chrono::steady_clock::now();
+    stress_msg_t m;
+    for (uint32_t seq = 0; seq < STRESS_MESSAGES; seq++) {
+        m.seq = seq;
+        for (int i = 0; i < PAYLOAD_WORDS; i++) {
+            m.payload[i] = payload_word(seq, i);
+        }
+        while (!rawQueue.push(m)) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+
+    char msg[100];
+    snprintf(msg, sizeof(msg), "%u mensajes de %u B entre hilos: %.0f ns por mensaje",
+             (unsigned)STRESS_MESSAGES, (unsigned)sizeof(stress_msg_t), ns / STRESS_MESSAGES);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_UINT32(STRESS_MESSAGES, received);
+    TEST_ASSERT_EQUAL_UINT32(0, errors);
+    TEST_ASSERT_TRUE(rawQueue.empty());
+}
+
+void test_reserve_keeps_free_slots(void) {
+    SpscQueue<uint32_t, 8> q;
+    uint32_t pushed = 0;
+    while (q.push(pushed, 3)) {
+        pushed++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, pushed);
+    while (q.push(pushed)) {
+        pushed++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(8, pushed);
+
+    uint32_t v = 0;
+    for (uint32_t i = 0; i < 8; i++) {
+        TEST_ASSERT_TRUE(q.pop(v));
+        TEST_ASSERT_EQUAL_UINT32(i, v);
+    }
+    TEST_ASSERT_FALSE(q.pop(v));
+}
+
+/**
+ * @brief LMIC encola a ráfagas mientras loop() emite despacio: ninguna llamada se pierde
+ */
+void test_deferred_calls_survive_full_queue(void) {
+    LMIC.opmode |= OP_TXRXPEND;  // Con dos núcleos se encola y se emite igual
+
+    std::thread loopTask([] {
+        while (!producerDone || !queue.empty()) {
+            deferred_drain();
+            std::this_thread::yield();
+        }
+    });
+
+    char text[12];
+    for (uint32_t k = 0; k < STRESS_SENDS; k++) {
+        snprintf(text, sizeof(text), "%lu", (unsigned long)k);
+        deferred_show(MSG_INFO, text, 1000);
+        deferred_log("envío %lu", (unsigned long)k);
+        deferred_call(markCall);
+    }
+    producerDone = true;
+    loopTask.join();
+
+    char msg[120];
+    snprintf(msg, sizeof(msg), "%u envíos: %u llamadas, %u fotogramas (%u descartados)",
+             (unsigned)STRESS_SENDS, (unsigned)callsRun, (unsigned)showsRun,
+             (unsigned)(STRESS_SENDS - showsRun));
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_EQUAL_UINT32(STRESS_SENDS, callsRun);
+    TEST_ASSERT_EQUAL_UINT32(0, outOfOrder);
+    TEST_ASSERT_LESS_THAN(STRESS_SENDS, showsRun);  // La cola sí llegó a llenarse
+    LMIC.opmode = 0;
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_raw_queue_two_threads);
+    RUN_TEST(test_reserve_keeps_free_slots);
+    RUN_TEST(test_deferred_calls_survive_full_queue);
+    return UNITY_END();
+}
@@ -0,0 +1,145 @@
+/**
+ * @file      test_status_bitmaps.cpp
+ * @brief     Mensajes fijos prerenderizados: blitTileRows() frente al dibujo con la fuente
+ *
+ * Cada mensaje de status_messages.def se dibuja como renderMessage() y
+ * status_bitmap_gen.c (cabecera y texto con la geometría de
+ * screen_types.h), se guardan sus filas de tiles ocupadas y se copian con
+ * blitTileRows(). El resultado debe ser idéntico al dibujo en el buffer
+ * completo, en la pantalla tras updateDirty() y en modo página (_1).
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include <vector>
+#include "display_sim.h"
+#include "host_font.h"
+#include "screen_types.h"
+
+#define TILE_ROWS DISPLAY_SIM_TILE_HEIGHT
+#define ROW_BYTES (DISPLAY_SIM_TILE_WIDTH * 8)
+
+typedef struct {
+    ScreenMessageType type;
+    const char* text;
+} message_t;
+
+static const message_t MESSAGES[] = {
+#define STATUS_MESSAGE(id, type, text) {type, text},
+#include "status_messages.def"
+#undef STATUS_MESSAGE
+};
+
+#define MESSAGE_COUNT (sizeof(MESSAGES) / sizeof(MESSAGES[0]))
+
+static const char* const SCREEN_TYPE_LABELS[] = {SCREEN_TYPE_LABEL_STRINGS};
+
+static U8G2_SSD1306_128X64_NONAME_F_HW_I2C full(U8G2_R0);
+static U8G2_SSD1306_128X64_NONAME_1_HW_I2C paged(U8G2_R0);
+
+// Filas ocupadas de cada mensaje, como las genera status_bitmap_gen.c
+static std::vector<uint8_t> tiles[MESSAGE_COUNT];
+static uint8_t rows[MESSAGE_COUNT];
+
+static void draw_live(U8G2& display, const message_t& m) {
+    display.setFont(SCREEN_FONT);
+    display.drawStr(0, SCREEN_HEADER_Y, SCREEN_TYPE_LABELS[m.type]);
+    display.drawStr(0, SCREEN_TEXT_FIRST_Y, m.text);
+}
+
+static void prerender(void) {
+    for (size_t i = 0; i < MESSAGE_COUNT; i++) {
+        full.clearBuffer();
+        draw_live(full, MESSAGES[i]);
+        const uint8_t* buf = full.getBufferPtr();
+        rows[i] = 0;
+        for (uint8_t r = 0; r < TILE_ROWS; r++) {
+            for (uint16_t b = 0; b < ROW_BYTES; b++) {
+                if (buf[r * ROW_BYTES + b]) {
+                    rows[i] = r + 1;
+                    break;
+                }
+            }
+        }
+        tiles[i].assign(buf, buf + rows[i] * ROW_BYTES);
+    }
+}
+
+void setUp(void) {
+    display_sim_attach(full);
+}
+
+void tearDown(void) {}
+
+void test_blit_matches_live_drawing(void) {
+    prerender();
+    std::vector<uint8_t> live(ROW_BYTES * TILE_ROWS);
+    for (size_t i = 0; i < MESSAGE_COUNT; i++) {
+        TEST_ASSERT_GREATER_THAN(0, rows[i]);
+        TEST_ASSERT_LESS_THAN(TILE_ROWS, rows[i]);
+
+        full.clearBuffer();
+        draw_live(full, MESSAGES[i]);
+        memcpy(live.data(), full.getBufferPtr(), live.size());
+
+        // Otro contenido antes, como al pasar de un mensaje a otro
+        full.drawBox(0, 0, 128, 64);
+        full.clearBuffer();
+        full.blitTileRows(0, rows[i], tiles[i].data());
+        TEST_ASSERT_EQUAL_MEMORY(live.data(), full.getBufferPtr(), live.size());
+    }
+}
+
+/**
+ * @brief Las filas copiadas quedan marcadas para updateDirty()
+ */
+void test_blit_reaches_display_with_dirty_tiles(void) {
+    prerender();
+    full.clearBuffer();
+    draw_live(full, MESSAGES[0]);
+    full.updateDirty();
+
+    for (size_t i = 1; i < MESSAGE_COUNT; i++) {
+        full.clearBuffer();
+        full.blitTileRows(0, rows[i], tiles[i].data());
+        display_sim.clearCounters();
+        full.updateDirty();
+        TEST_ASSERT_TRUE(display_sim_matches(full));
+        TEST_ASSERT_LESS_OR_EQUAL(rows[i] * DISPLAY_SIM_TILE_WIDTH, display_sim.tiles);
+    }
+}
+
+/**
+ * @brief En modo página cada pasada copia solo su fila
+ */
+void test_blit_in_page_mode(void) {
+    prerender();
+    display_sim_attach(paged);
+    uint8_t live[sizeof(display_sim.ram)];
+
+    for (size_t i = 0; i < MESSAGE_COUNT; i++) {
+        paged.firstPage();
+        do {
+            draw_live(paged, MESSAGES[i]);
+        } while (paged.nextPage());
+        memcpy(live, display_sim.ram, sizeof(live));
+
+        memset(display_sim.ram, 0xA5, sizeof(display_sim.ram));
+        paged.firstPage();
+        do {
+            paged.blitTileRows(0, rows[i], tiles[i].data());
+        } while (paged.nextPage());
+        TEST_ASSERT_EQUAL_MEMORY(live, display_sim.ram, sizeof(live));
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_blit_matches_live_drawing);
+    RUN_TEST(test_blit_reaches_display_with_dirty_tiles);
+    RUN_TEST(test_blit_in_page_mode);
+    return UNITY_END();
+}
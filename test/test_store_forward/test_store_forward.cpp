@@ -0,0 +1,322 @@
+/**
+ * @file      test_store_forward.cpp
+ * @brief     Cola en flash: cortes de alimentación durante la escritura y arranques en frío
+ *
+ * Flash en RAM (stubs/esp_partition.h) del tamaño de la partición upqueue.
+ * Un corte a mitad de un registro deja un hueco que no es válido ni está
+ * borrado; el recorrido de un arranque en frío debe saltarlo (o parar en el
+ * límite del sector, que se borra al entrar) sin perder ni repetir
+ * registros. La última prueba alterna al azar envíos, lotes, cortes y
+ * arranques en frío, y comprueba que cada registro guardado se entrega una
+ * vez, en orden y sin cambios, o consta como perdido.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include <vector>
+#include "../../config/config.h"
+#undef ENABLE_STORE_FORWARD
+#define ENABLE_STORE_FORWARD true
+#include <esp_partition.h>
+#include "../../src/boot_mode.cpp"
+#include "../../src/store_forward.cpp"
+
+#define PARTITION_BYTES 0x10000  // partitions.csv
+#define STRESS_OPERATIONS 20000
+
+static uint32_t nextId = 0;
+static std::vector<uint32_t> delivered;
+static uint32_t corrupted = 0;
+
+static uint8_t payload_byte(uint32_t id, int i) {
+    return (uint8_t)(id * 31 + i);
+}
+
+/**
+ * @brief Guarda un payload completo: identificador (4 bytes) y relleno derivado de él
+ */
+static bool push_next(void) {
+    uint8_t p[STORE_FORWARD_MAX_PAYLOAD];
+    const uint32_t id = nextId++;
+    memcpy(p, &id, sizeof(id));
+    for (int i = sizeof(id); i < STORE_FORWARD_MAX_PAYLOAD; i++) {
+        p[i] = payload_byte(id, i);
+    }
+    return store_forward_push(p, sizeof(p));
+}
+
+/**
+ * @brief Guarda un payload con un corte de alimentación tras 'bytes' bytes escritos
+ */
+static void push_with_power_cut(int64_t bytes) {
+    host_flash_write_budget = bytes;
+    TEST_ASSERT_FALSE(push_next());
+    host_flash_write_budget = -1;
+}
+
+static void boot(bool cold) {
+    host_wakeup_cause = cold ? ESP_SLEEP_WAKEUP_UNDEFINED : ESP_SLEEP_WAKEUP_TIMER;
+    TEST_ASSERT_TRUE(store_forward_begin());
+}
+
+/**
+ * @brief Envía lotes hasta vaciar la cola y anota los identificadores entregados
+ */
+static void drain(void) {
+    uint8_t buf[STORE_FORWARD_BATCH_BYTES];
+    uint8_t count;
+    uint8_t size;
+    while ((size = store_forward_build_batch(buf, sizeof(buf), &count)) > 0) {
+        uint8_t pos = 1;
+        for (uint8_t r = 0; r < count; r++) {
+            const uint8_t len = buf[pos + 4];
+            const uint8_t* p = &buf[pos + 5];
+            uint32_t id;
+            memcpy(&id, p, sizeof(id));
+            for (int i = sizeof(id); i < len; i++) {
+                corrupted += p[i] != payload_byte(id, i);
+            }
+            delivered.push_back(id);
+            pos += 5 + len;
+        }
+        TEST_ASSERT_EQUAL_UINT8(size, pos);
+        store_forward_commit();
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, store_forward_pending());
+}
+
+static void assert_delivered(const std::vector<uint32_t>& expected) {
+    TEST_ASSERT_EQUAL_UINT32(0, corrupted);
+    TEST_ASSERT_EQUAL_UINT32(expected.size(), delivered.size());
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected.data(), delivered.data(), expected.size());
+}
+
+static std::vector<uint32_t> ids(uint32_t first, uint32_t last) {
+    std::vector<uint32_t> v;
+    for (uint32_t id = first; id <= last; id++) {
+        v.push_back(id);
+    }
+    return v;
+}
+
+static const uint8_t* slot_bytes(uint32_t slot) {
+    return host_partitions.at(STORE_FORWARD_PARTITION).data.data() + slot * sizeof(slot_t);
+}
+
+void setUp(void) {
+    // Sin vaciar host_partitions: store_forward conserva el puntero a la partición
+    host_partition_add(STORE_FORWARD_PARTITION, ESP_PARTITION_TYPE_DATA, STORE_FORWARD_PARTITION_SUBTYPE,
+                       PARTITION_BYTES);
+    host_flash_write_budget = -1;
+    nextId = 0;
+    delivered.clear();
+    corrupted = 0;
+    boot(true);
+}
+
+void tearDown(void) {
+    TEST_ASSERT_EQUAL_INT32(0, lock->held);
+}
+
+/**
+ * @brief Cortes seguidos a mitad de registro: el recorrido salta todos los huecos escritos
+ */
+void test_torn_records_skipped(void) {
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(push_next());
+    }
+    push_with_power_cut(13);             // id 10 en el hueco 10
+    boot(true);
+    push_with_power_cut(sizeof(slot_t) - 1);  // id 11 en el hueco 11: solo falta el último byte del CRC
+    boot(true);
+    TEST_ASSERT_EQUAL_UINT32(10, store_forward_pending());
+    TEST_ASSERT_EQUAL_UINT32(12, head);
+
+    TEST_ASSERT_TRUE(push_next());
+    TEST_ASSERT_TRUE(push_next());
+    boot(false);
+    drain();
+
+    std::vector<uint32_t> expected = ids(0, 9);
+    expected.push_back(12);
+    expected.push_back(13);
+    assert_delivered(expected);
+}
+
+/**
+ * @brief Corte con 0 bytes escritos: el hueco sigue borrado y se reutiliza
+ */
+void test_power_cut_before_write_reuses_slot(void) {
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(push_next());
+    }
+    push_with_power_cut(0);
+    boot(true);
+    TEST_ASSERT_EQUAL_UINT32(3, head);
+    TEST_ASSERT_TRUE(push_next());
+    drain();
+
+    std::vector<uint32_t> expected = ids(0, 2);
+    expected.push_back(4);
+    assert_delivered(expected);
+}
+
+/**
+ * @brief Registro cortado en el último hueco de un sector: la cabeza pasa al sector siguiente
+ */
+void test_torn_record_at_sector_end(void) {
+    for (uint32_t i = 0; i < SLOTS_PER_SECTOR - 1; i++) {
+        TEST_ASSERT_TRUE(push_next());
+    }
+    push_with_power_cut(20);
+    boot(true);
+    TEST_ASSERT_EQUAL_UINT32(SLOTS_PER_SECTOR, head);
+
+    TEST_ASSERT_TRUE(push_next());
+    store_forward_stats_t st;
+    store_forward_get_stats(&st);
+    TEST_ASSERT_EQUAL_UINT32(1, st.erases);
+    drain();
+
+    std::vector<uint32_t> expected = ids(0, SLOTS_PER_SECTOR - 2);
+    expected.push_back(SLOTS_PER_SECTOR);
+    assert_delivered(expected);
+}
+
+/**
+ * @brief Registro cortado en el primer hueco de un sector: se vuelve a borrar el sector
+ *
+ * El recorrido para en el límite del sector sin saltar el hueco escrito;
+ * el siguiente envío entra en el sector y lo borra antes de escribir.
+ */
+void test_torn_record_at_sector_start(void) {
+    for (uint32_t i = 0; i < SLOTS_PER_SECTOR; i++) {
+        TEST_ASSERT_TRUE(push_next());
+    }
+    push_with_power_cut(5);
+    boot(true);
+    TEST_ASSERT_EQUAL_UINT32(SLOTS_PER_SECTOR, head);
+    TEST_ASSERT_NOT_EQUAL(0xFF, slot_bytes(SLOTS_PER_SECTOR)[0]);
+
+    TEST_ASSERT_TRUE(push_next());
+    store_forward_stats_t st;
+    store_forward_get_stats(&st);
+    TEST_ASSERT_EQUAL_UINT32(1, st.erases);
+    drain();
+
+    std::vector<uint32_t> expected = ids(0, SLOTS_PER_SECTOR - 1);
+    expected.push_back(SLOTS_PER_SECTOR + 1);
+    assert_delivered(expected);
+}
+
+/**
+ * @brief Corte al confirmar un lote: sus registros se vuelven a enviar tras el arranque
+ */
+void test_power_cut_during_commit_resends_batch(void) {
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(push_next());
+    }
+    uint8_t buf[STORE_FORWARD_BATCH_BYTES];
+    uint8_t count;
+    TEST_ASSERT_GREATER_THAN(0, store_forward_build_batch(buf, sizeof(buf), &count));
+    TEST_ASSERT_EQUAL_UINT8(2, count);
+    host_flash_write_budget = 0;
+    store_forward_commit();
+    host_flash_write_budget = -1;
+
+    boot(true);
+    TEST_ASSERT_EQUAL_UINT32(4, store_forward_pending());
+    drain();
+    assert_delivered(ids(0, 3));
+}
+
+/**
+ * @brief Operaciones al azar con cortes y arranques en frío
+ */
+void test_random_power_loss(void) {
+    srand(1);
+    uint32_t torn = 0;
+    uint32_t dropped = 0;   // Suma de los contadores de cada arranque
+    uint32_t erases = 0;
+
+    auto restart = [&](bool cold) {
+        store_forward_stats_t st;
+        store_forward_get_stats(&st);
+        if (cold) {
+            dropped += st.dropped;
+            erases += st.erases;
+        }
+        boot(cold);
+    };
+
+    for (int op = 0; op < STRESS_OPERATIONS; op++) {
+        const int r = rand() % 20;
+        if (r < 12) {
+            if (rand() % 100 == 0) {
+                push_with_power_cut(rand() % sizeof(slot_t));
+                torn++;
+                restart(true);
+            } else {
+                TEST_ASSERT_TRUE(push_next());
+            }
+        } else if (r < 16) {  // Menos lotes que envíos: la cola llega a llenarse
+            uint8_t buf[STORE_FORWARD_BATCH_BYTES];
+            uint8_t count;
+            if (store_forward_build_batch(buf, sizeof(buf), &count)) {
+                uint8_t pos = 1;
+                for (uint8_t i = 0; i < count; i++) {
+                    uint32_t id;
+                    memcpy(&id, &buf[pos + 5], sizeof(id));
+                    for (int k = sizeof(id); k < buf[pos + 4]; k++) {
+                        corrupted += buf[pos + 5 + k] != payload_byte(id, k);
+                    }
+                    // Entregados en orden y una sola vez
+                    TEST_ASSERT_TRUE(delivered.empty() || id > delivered.back());
+                    delivered.push_back(id);
+                    pos += 5 + buf[pos + 4];
+                }
+                store_forward_commit();
+            }
+        } else {
+            restart(r == 19);
+        }
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(slotCount, store_forward_pending());
+    }
+    restart(true);
+    store_forward_stats_t st;
+    store_forward_get_stats(&st);
+    const uint32_t pendingAtEnd = st.pending;
+    std::vector<uint32_t> before = delivered;
+    drain();
+    TEST_ASSERT_EQUAL_UINT32(before.size() + pendingAtEnd, delivered.size());
+    for (size_t i = 1; i < delivered.size(); i++) {
+        TEST_ASSERT_TRUE(delivered[i] > delivered[i - 1]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, corrupted);
+
+    // Cada registro guardado se entregó o consta como perdido al borrar su sector
+    TEST_ASSERT_EQUAL_UINT32(nextId, delivered.size() + torn + dropped);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, dropped);
+
+    char msg[160];
+    snprintf(msg, sizeof(msg),
+             "%lu registros: %lu entregados, %lu cortados, %lu perdidos con la cola llena, "
+             "%lu sectores borrados",
+             (unsigned long)nextId, (unsigned long)delivered.size(), (unsigned long)torn,
+             (unsigned long)dropped, (unsigned long)erases);
+    TEST_MESSAGE(msg);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_torn_records_skipped);
+    RUN_TEST(test_power_cut_before_write_reuses_slot);
+    RUN_TEST(test_torn_record_at_sector_end);
+    RUN_TEST(test_torn_record_at_sector_start);
+    RUN_TEST(test_power_cut_during_commit_resends_batch);
+    RUN_TEST(test_random_power_loss);
+    return UNITY_END();
+}
@@ -0,0 +1,205 @@
+/**
+ * @file      test_windowed_stats.cpp
+ * @brief     Pruebas y benchmark de las estadísticas por ventana
+ *
+ * Compara el acumulador de Welford con el cálculo en dos pasadas en doble
+ * precisión, comprueba el formato del payload de resumen y mide el coste
+ * por muestra y la memoria RTC que ocupa la ventana.
+ *
+ * @author    Proyecto IoT de Bajo Consumo
+ * @version   1.0
+ * @date      2025
+ */
+
+#include <unity.h>
+#include <chrono>
+#include "../../src/windowed_stats.cpp"
+
+/**
+ * @brief Media y desviación poblacional en dos pasadas (referencia)
+ */
+static void reference(const float* values, int n, double* mean, double* stddev) {
+    double sum = 0;
+    for (int i = 0; i < n; i++) sum += values[i];
+    *mean = sum / n;
+    double sq = 0;
+    for (int i = 0; i < n; i++) sq += (values[i] - *mean) * (values[i] - *mean);
+    *stddev = sqrt(sq / n);
+}
+
+static sensor_data_t reading(float temperature, float humidity, float battery) {
+    sensor_data_t data = {};
+    data.temperature = temperature;
+    data.humidity = humidity;
+    data.pressure = SENSOR_ERROR_PRESSURE;
+    data.distance = SENSOR_ERROR_DISTANCE;
+    data.battery = battery;
+    data.valid = true;
+    return data;
+}
+
+static uint16_t get_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] << 8 | p[1]);
+}
+
+void setUp(void) {
+    stats_window_reset();
+}
+
+void tearDown(void) {}
+
+void test_accumulator_matches_two_pass(void) {
+    const float values[] = {21.5f, 22.0f, 19.75f, 25.25f, 23.0f, 18.5f, 20.0f};
+    const int n = sizeof(values) / sizeof(values[0]);
+    stats_accumulator_t acc;
+    stats_accumulator_reset(&acc);
+    for (int i = 0; i < n; i++) stats_accumulator_add(&acc, values[i]);
+
+    double mean, stddev;
+    reference(values, n, &mean, &stddev);
+    TEST_ASSERT_EQUAL_UINT16(n, acc.count);
+    TEST_ASSERT_EQUAL_FLOAT(18.5f, acc.min);
+    TEST_ASSERT_EQUAL_FLOAT(25.25f, acc.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, mean, acc.mean);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, stddev, stats_accumulator_stddev(&acc));
+}
+
+void test_accumulator_is_stable_with_large_offset(void) {
+    // Presión ~1013 hPa con variaciones de décimas: la suma de cuadrados en
+    // float perdería toda la varianza; Welford no
+    static float values[2880];
+    const int n = sizeof(values) / sizeof(values[0]);
+    stats_accumulator_t acc;
+    stats_accumulator_reset(&acc);
+    for (int i = 0; i < n; i++) {
+        values[i] = 1013.25f + 0.1f * (float)sin(i * 0.01);
+        stats_accumulator_add(&acc, values[i]);
+    }
+
+    double mean, stddev;
+    reference(values, n, &mean, &stddev);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, mean, acc.mean);
+    TEST_ASSERT_FLOAT_WITHIN(stddev * 0.01, stddev, stats_accumulator_stddev(&acc));
+}
+
+void test_accumulator_ignores_nan_and_saturates(void) {
+    stats_accumulator_t acc;
+    stats_accumulator_reset(&acc);
+    stats_accumulator_add(&acc, NAN);
+    TEST_ASSERT_EQUAL_UINT16(0, acc.count);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, stats_accumulator_stddev(&acc));
+
+    stats_accumulator_add(&acc, 5.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, stats_accumulator_stddev(&acc));
+
+    acc.count = UINT16_MAX;
+    stats_accumulator_add(&acc, 100.0f);
+    TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, acc.count);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, acc.max);
+}
+
+void test_window_skips_error_values(void) {
+    sensor_data_t ok = reading(20.0f, 50.0f, 3.9f);
+    sensor_data_t failed = reading(SENSOR_ERROR_TEMPERATURE, SENSOR_ERROR_HUMIDITY, SENSOR_ERROR_BATTERY);
+    stats_window_add_sample(&ok);
+    stats_window_add_sample(&failed);
+    stats_window_add_sample(&ok);
+
+    TEST_ASSERT_EQUAL_UINT16(3, stats_window_sample_count());
+    TEST_ASSERT_EQUAL_UINT16(2, stats_window_temperature()->count);
+    TEST_ASSERT_EQUAL_UINT16(2, stats_window_humidity()->count);
+    TEST_ASSERT_EQUAL_UINT16(2, stats_window_battery()->count);
+    TEST_ASSERT_EQUAL_UINT16(0, stats_window_pressure()->count);
+}
+
+void test_window_is_due_after_one_send_interval(void) {
+    const int per_window = SEND_INTERVAL_SECONDS / STATS_SAMPLE_INTERVAL_SECONDS;
+    sensor_data_t data = reading(20.0f, 50.0f, 3.9f);
+    for (int i = 0; i < per_window - 1; i++) {
+        stats_window_add_sample(&data);
+        TEST_ASSERT_FALSE(stats_window_is_due());
+    }
+    stats_window_add_sample(&data);
+    TEST_ASSERT_TRUE(stats_window_is_due());
+
+    stats_window_reset();
+    TEST_ASSERT_EQUAL_UINT16(0, stats_window_sample_count());
+    TEST_ASSERT_FALSE(stats_window_is_due());
+}
+
+void test_payload_layout(void) {
+    const float temps[] = {18.0f, 22.0f, 20.0f};
+    for (float t : temps) {
+        sensor_data_t data = reading(t, 40.0f + t, 4.0f - t / 100.0f);
+        stats_window_add_sample(&data);
+    }
+
+    uint8_t buffer[64];
+    payload_config_t config = {buffer, sizeof(buffer), 0};
+    TEST_ASSERT_EQUAL_UINT8(STATS_PAYLOAD_SIZE_BYTES, stats_window_get_payload(&config));
+    TEST_ASSERT_EQUAL_UINT8(STATS_PAYLOAD_SIZE_BYTES, config.written);
+
+    TEST_ASSERT_EQUAL_UINT8(3, buffer[0]);
+    // Temperatura: min, max, media, desviación (x100, con signo)
+    TEST_ASSERT_EQUAL_INT16(1800, (int16_t)get_u16(&buffer[1]));
+    TEST_ASSERT_EQUAL_INT16(2200, (int16_t)get_u16(&buffer[3]));
+    TEST_ASSERT_EQUAL_INT16(2000, (int16_t)get_u16(&buffer[5]));
+    TEST_ASSERT_EQUAL_INT16(163, (int16_t)get_u16(&buffer[7]));
+    // Humedad: min 58 %
+    TEST_ASSERT_EQUAL_INT16(5800, (int16_t)get_u16(&buffer[9]));
+    // Batería mínima de la ventana (x100)
+    TEST_ASSERT_EQUAL_UINT16(378, get_u16(&buffer[STATS_PAYLOAD_SIZE_BYTES - 2]));
+}
+
+void test_payload_reports_error_for_empty_field(void) {
+    sensor_data_t data = reading(21.0f, SENSOR_ERROR_HUMIDITY, 3.7f);
+    stats_window_add_sample(&data);
+
+    uint8_t buffer[64];
+    payload_config_t config = {buffer, sizeof(buffer), 0};
+    stats_window_get_payload(&config);
+    // Humedad tras los 4 valores de temperatura
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT16((int16_t)(SENSOR_ERROR_HUMIDITY * 100), (int16_t)get_u16(&buffer[9 + 2 * i]));
+    }
+}
+
+void test_payload_rejects_small_buffer(void) {
+    uint8_t buffer[STATS_PAYLOAD_SIZE_BYTES - 1];
+    payload_config_t config = {buffer, sizeof(buffer), 0};
+    TEST_ASSERT_EQUAL_UINT8(0, stats_window_get_payload(&config));
+}
+
+void test_benchmark(void) {
+    const int samples = 1000000;
+    sensor_data_t data = reading(20.0f, 50.0f, 3.9f);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < samples; i++) {
+        data.temperature = 20.0f + (i & 0xFF) * 0.01f;
+        stats_window_add_sample(&data);
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count() / samples;
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "stats_window_add_sample: %.1f ns/muestra en el host, ventana en RTC: %u bytes",
+             ns, (unsigned)sizeof(window));
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_THAN(2000.0, ns);
+    // Cinco acumuladores y el contador de muestras
+    TEST_ASSERT_LESS_OR_EQUAL(128, sizeof(window));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_accumulator_matches_two_pass);
+    RUN_TEST(test_accumulator_is_stable_with_large_offset);
+    RUN_TEST(test_accumulator_ignores_nan_and_saturates);
+    RUN_TEST(test_window_skips_error_values);
+    RUN_TEST(test_window_is_due_after_one_send_interval);
+    RUN_TEST(test_payload_layout);
+    RUN_TEST(test_payload_reports_error_for_empty_field);
+    RUN_TEST(test_payload_rejects_small_buffer);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}